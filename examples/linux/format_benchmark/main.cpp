@@ -0,0 +1,201 @@
+/*
+ * Benchmark of the number formatting of xpcc::format and xpcc::IOStream
+ * against snprintf() of the C library.
+ *
+ * Each conversion is run on the same set of pseudo random values and the
+ * average time per conversion is reported. The IOStream variants write to
+ * a device which discards everything, so the result includes the
+ * overhead of the stream, but not of any I/O.
+ *
+ * To compare the code size, build for an ARM target and look at the size
+ * of the conversion functions:
+ *   arm-none-eabi-nm -C -S --size-sort <elf> | grep format
+ */
+
+#include <xpcc/architecture.hpp>
+#include <xpcc/debug/logger.hpp>
+#include <xpcc/io/format.hpp>
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdio>
+
+#undef	XPCC_LOG_LEVEL
+#define	XPCC_LOG_LEVEL xpcc::log::INFO
+
+static constexpr std::size_t count = 200000;
+
+// ----------------------------------------------------------------------------
+class NullDevice : public xpcc::IODevice
+{
+public:
+	using IODevice::write;
+	using IODevice::read;
+
+	virtual void
+	write(char)
+	{
+	}
+
+	virtual void
+	write(const uint8_t *, std::size_t)
+	{
+	}
+
+	virtual void
+	flush()
+	{
+	}
+
+	virtual bool
+	read(char&)
+	{
+		return false;
+	}
+};
+
+static NullDevice nullDevice;
+static xpcc::IOStream nullStream(nullDevice);
+
+// Sum of all characters, keeps the compiler from removing the conversions
+static volatile uint32_t checksum;
+
+// ----------------------------------------------------------------------------
+template <typename T, typename Function>
+static double
+measure(const std::vector<T>& values, Function function)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	char buffer[64];
+	uint32_t sum = 0;
+
+	const Clock::time_point start = Clock::now();
+	for (const T& value : values)
+	{
+		function(buffer, value);
+		sum += buffer[0];
+	}
+	const double time = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+	checksum = checksum + sum;
+	return time / values.size();
+}
+
+static void
+printResult(const char *name, double time, double reference)
+{
+	XPCC_LOG_INFO.printf("  %s %7.1f ns", name, time);
+	if (reference > 0) {
+		XPCC_LOG_INFO.printf("  (x%.2f)", reference / time);
+	}
+	XPCC_LOG_INFO << xpcc::endl;
+}
+
+// ----------------------------------------------------------------------------
+static void
+benchmarkIntegers(std::mt19937& random)
+{
+	std::vector<int32_t> values32;
+	std::vector<uint64_t> values64;
+	for (std::size_t ii = 0; ii < count; ++ii)
+	{
+		// uniform number of digits instead of uniform values
+		const uint32_t digits = random() % 10;
+		values32.push_back(int32_t(random() % 200000000 - 100000000) >> (3 * (9 - digits)));
+		values64.push_back((uint64_t(random()) << 32 | random()) >> (3 * (random() % 20)));
+	}
+
+	XPCC_LOG_INFO << "int32_t" << xpcc::endl;
+	const double snprintf32 = measure(values32, [](char *buffer, int32_t value) {
+		snprintf(buffer, 64, "%d", int(value));
+	});
+	printResult("snprintf          ", snprintf32, 0);
+	printResult("format::writeDecimal", measure(values32, [](char *buffer, int32_t value) {
+		xpcc::format::writeDecimal(buffer, value);
+	}), snprintf32);
+	printResult("IOStream          ", measure(values32, [](char *buffer, int32_t value) {
+		nullStream << value;
+		buffer[0] = 0;
+	}), snprintf32);
+
+	XPCC_LOG_INFO << "uint64_t" << xpcc::endl;
+	const double snprintf64 = measure(values64, [](char *buffer, uint64_t value) {
+		snprintf(buffer, 64, "%llu", static_cast<unsigned long long>(value));
+	});
+	printResult("snprintf          ", snprintf64, 0);
+	printResult("format::writeDecimal", measure(values64, [](char *buffer, uint64_t value) {
+		xpcc::format::writeDecimal(buffer, value);
+	}), snprintf64);
+	printResult("IOStream          ", measure(values64, [](char *buffer, uint64_t value) {
+		nullStream << value;
+		buffer[0] = 0;
+	}), snprintf64);
+}
+
+template <typename T>
+static void
+benchmarkFloatingPoint(const char *name, const std::vector<T>& values)
+{
+	XPCC_LOG_INFO << name << xpcc::endl;
+
+	const double shortest = measure(values, [](char *buffer, T value) {
+		snprintf(buffer, 64, "%.17g", double(value));
+	});
+	printResult("snprintf %.17g    ", shortest, 0);
+	printResult("format::writeShortest", measure(values, [](char *buffer, T value) {
+		xpcc::format::writeShortest(buffer, value);
+	}), shortest);
+
+	const double scientific = measure(values, [](char *buffer, T value) {
+		snprintf(buffer, 64, "%.5e", double(value));
+	});
+	printResult("snprintf %.5e     ", scientific, 0);
+	printResult("format::writeScientific", measure(values, [](char *buffer, T value) {
+		xpcc::format::writeScientific(buffer, value, 5);
+	}), scientific);
+	printResult("IOStream          ", measure(values, [](char *buffer, T value) {
+		nullStream << value;
+		buffer[0] = 0;
+	}), scientific);
+
+	const double fixed = measure(values, [](char *buffer, T value) {
+		snprintf(buffer, 64, "%.3f", double(value));
+	});
+	printResult("snprintf %.3f     ", fixed, 0);
+	printResult("format::writeFixed", measure(values, [](char *buffer, T value) {
+		xpcc::format::writeFixed(buffer, value, 3);
+	}), fixed);
+	printResult("IOStream::printf  ", measure(values, [](char *buffer, T value) {
+		nullStream.printf("%.3f", double(value));
+		buffer[0] = 0;
+	}), fixed);
+}
+
+// ----------------------------------------------------------------------------
+int
+main()
+{
+	std::mt19937 random(42);
+
+	benchmarkIntegers(random);
+
+	// values of typical sensor readings instead of random bit patterns
+	std::uniform_real_distribution<double> mantissa(-1, 1);
+	std::uniform_int_distribution<int> exponent(-6, 6);
+
+	std::vector<float> floats;
+	std::vector<double> doubles;
+	for (std::size_t ii = 0; ii < count; ++ii)
+	{
+		const double value = mantissa(random) * std::pow(10.0, exponent(random));
+		floats.push_back(float(value));
+		doubles.push_back(value);
+	}
+
+	benchmarkFloatingPoint("float", floats);
+	benchmarkFloatingPoint("double", doubles);
+
+	return 0;
+}
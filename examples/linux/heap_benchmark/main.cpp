@@ -0,0 +1,505 @@
+/*
+ * Benchmark and stress test for the xpcc heap implementations.
+ *
+ * Replays allocation traces on xpcc::BlockAllocator, xpcc::TlsfHeap and the
+ * heap of the C library (newlib on the targets, glibc here) and reports
+ * the time per allocation/free, the worst case search length and the
+ * fragmentation over time.
+ *
+ * Usage:
+ *   heap_benchmark                  run the synthetic traces
+ *   heap_benchmark <trace file>     replay a recorded trace
+ *   heap_benchmark --fuzz <rounds>  random stress test with consistency checks
+ *
+ * A trace file contains one operation per line:
+ *   a <id> <size>    allocate <size> bytes and remember them as <id>
+ *   f <id>           free the memory allocated as <id>
+ * Lines starting with '#' are ignored.
+ */
+
+#include <xpcc/architecture.hpp>
+#include <xpcc/debug/logger.hpp>
+
+#include <xpcc/architecture/driver/heap/block_allocator.hpp>
+#include <xpcc/architecture/driver/heap/tlsf/tlsf_heap.hpp>
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+
+#undef	XPCC_LOG_LEVEL
+#define	XPCC_LOG_LEVEL xpcc::log::INFO
+
+// Size of the memory region available to each heap
+static constexpr std::size_t heapSize = 64 * 1024;
+
+// Number of operations between two fragmentation samples
+static constexpr std::size_t sampleInterval = 2000;
+
+// ----------------------------------------------------------------------------
+struct Operation
+{
+	bool allocate;
+	uint32_t id;
+	uint32_t size;
+};
+
+typedef std::vector<Operation> Trace;
+
+// ----------------------------------------------------------------------------
+class Heap
+{
+public:
+	virtual
+	~Heap()
+	{
+	}
+
+	virtual const char *
+	getName() const = 0;
+
+	virtual void *
+	allocate(std::size_t size) = 0;
+
+	virtual void
+	free(void * ptr) = 0;
+
+	/// Number of blocks inspected to satisfy the request
+	virtual std::size_t
+	getSearchLength(std::size_t /* size */) const
+	{
+		return 1;
+	}
+
+	/// External fragmentation in percent, 0 if not available
+	virtual uint8_t
+	getFragmentation() const
+	{
+		return 0;
+	}
+
+	virtual bool
+	check() const
+	{
+		return true;
+	}
+};
+
+class BlockHeap : public Heap
+{
+public:
+	BlockHeap() :
+		memory(new uint8_t[heapSize])
+	{
+		allocator.initialize(memory, memory + heapSize);
+	}
+
+	~BlockHeap()
+	{
+		delete[] memory;
+	}
+
+	const char *
+	getName() const override
+	{
+		return "BlockAllocator";
+	}
+
+	void *
+	allocate(std::size_t size) override
+	{
+		return allocator.allocate(size);
+	}
+
+	void
+	free(void * ptr) override
+	{
+		allocator.free(ptr);
+	}
+
+	std::size_t
+	getSearchLength(std::size_t size) const override
+	{
+		return allocator.getSearchLength(size);
+	}
+
+	uint8_t
+	getFragmentation() const override
+	{
+		std::size_t available = allocator.getAvailableSize();
+		if (available == 0) {
+			return 0;
+		}
+		return 100 - (allocator.getLargestFreeSize() * 100) / available;
+	}
+
+private:
+	uint8_t * memory;
+	xpcc::BlockAllocator<uint16_t, 8> allocator;
+};
+
+class TlsfBenchmarkHeap : public Heap
+{
+public:
+	const char *
+	getName() const override
+	{
+		return "TlsfHeap";
+	}
+
+	void *
+	allocate(std::size_t size) override
+	{
+		return heap.allocate(size);
+	}
+
+	void
+	free(void * ptr) override
+	{
+		heap.free(ptr);
+	}
+
+	uint8_t
+	getFragmentation() const override
+	{
+		return heap.getFragmentation();
+	}
+
+	bool
+	check() const override
+	{
+		return heap.check();
+	}
+
+private:
+	// the TLSF control structure is stored inside the region
+	xpcc::StaticTlsfHeap<heapSize + 8 * 1024> heap;
+};
+
+class SystemHeap : public Heap
+{
+public:
+	const char *
+	getName() const override
+	{
+		return "malloc";
+	}
+
+	void *
+	allocate(std::size_t size) override
+	{
+		return std::malloc(size);
+	}
+
+	void
+	free(void * ptr) override
+	{
+		std::free(ptr);
+	}
+};
+
+// ----------------------------------------------------------------------------
+/**
+ * Generates a random trace.
+ *
+ * Keeps up to `maxLive` allocations alive, each with a size between
+ * `minSize` and `maxSize`. A fraction of the allocations (at most a quarter
+ * of `maxLive`) is long lived and only released at the end of the trace,
+ * which pins memory in the middle of the heap and provokes fragmentation.
+ */
+static Trace
+generateTrace(uint32_t seed, std::size_t operations, std::size_t maxLive,
+		uint32_t minSize, uint32_t maxSize, uint8_t longLivedPercent)
+{
+	std::mt19937 random(seed);
+	std::uniform_int_distribution<uint32_t> sizeDistribution(minSize, maxSize);
+	std::uniform_int_distribution<uint32_t> percent(0, 99);
+
+	Trace trace;
+	std::vector<uint32_t> live;
+	std::vector<uint32_t> longLived;
+	uint32_t nextId = 0;
+
+	for (std::size_t i = 0; i < operations; ++i)
+	{
+		bool allocate = live.empty() or
+				(live.size() < maxLive and percent(random) < 55);
+		if (allocate)
+		{
+			uint32_t id = nextId++;
+			trace.push_back({ true, id, sizeDistribution(random) });
+			if (longLived.size() < maxLive / 4 and percent(random) < longLivedPercent) {
+				longLived.push_back(id);
+			} else {
+				live.push_back(id);
+			}
+		}
+		else
+		{
+			std::uniform_int_distribution<std::size_t> select(0, live.size() - 1);
+			std::size_t index = select(random);
+			trace.push_back({ false, live[index], 0 });
+			live[index] = live.back();
+			live.pop_back();
+		}
+	}
+
+	for (uint32_t id : live) {
+		trace.push_back({ false, id, 0 });
+	}
+	for (uint32_t id : longLived) {
+		trace.push_back({ false, id, 0 });
+	}
+	return trace;
+}
+
+static bool
+loadTrace(const char * filename, Trace& trace)
+{
+	std::ifstream file(filename);
+	if (not file) {
+		return false;
+	}
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (line.empty() or line[0] == '#') {
+			continue;
+		}
+
+		std::istringstream stream(line);
+		char type;
+		Operation operation = { false, 0, 0 };
+		stream >> type >> operation.id;
+		if (type == 'a') {
+			operation.allocate = true;
+			stream >> operation.size;
+		}
+		else if (type != 'f') {
+			return false;
+		}
+		trace.push_back(operation);
+	}
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+struct Result
+{
+	std::size_t allocations = 0;
+	std::size_t frees = 0;
+	std::size_t failed = 0;
+	std::size_t corrupted = 0;
+
+	double allocationTime = 0;
+	double maxAllocationTime = 0;
+	double freeTime = 0;
+	double maxFreeTime = 0;
+
+	std::size_t searchLength = 0;
+	std::size_t maxSearchLength = 0;
+
+	std::vector<uint8_t> fragmentation;
+};
+
+static inline uint8_t
+getPattern(uint32_t id)
+{
+	return static_cast<uint8_t>(id * 0x9e + 0x37);
+}
+
+/// Every allocated block is filled with a pattern which is verified before
+/// it is freed. This detects overlapping allocations.
+static bool
+verifyPattern(const uint8_t * ptr, uint32_t size, uint32_t id)
+{
+	const uint8_t pattern = getPattern(id);
+	for (uint32_t i = 0; i < size; ++i) {
+		if (ptr[i] != pattern) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static Result
+replay(Heap& heap, const Trace& trace)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	Result result;
+	std::vector<uint8_t *> pointers;
+	std::vector<uint32_t> sizes;
+
+	for (std::size_t i = 0; i < trace.size(); ++i)
+	{
+		if ((i % sampleInterval) == 0) {
+			result.fragmentation.push_back(heap.getFragmentation());
+		}
+
+		const Operation& operation = trace[i];
+		if (operation.id >= pointers.size()) {
+			pointers.resize(operation.id + 1, nullptr);
+			sizes.resize(operation.id + 1, 0);
+		}
+
+		if (operation.allocate)
+		{
+			std::size_t length = heap.getSearchLength(operation.size);
+
+			Clock::time_point start = Clock::now();
+			void * ptr = heap.allocate(operation.size);
+			double time = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+			if (ptr == nullptr) {
+				result.failed++;
+				continue;
+			}
+
+			result.allocations++;
+			result.allocationTime += time;
+			result.maxAllocationTime = std::max(result.maxAllocationTime, time);
+			result.searchLength += length;
+			result.maxSearchLength = std::max(result.maxSearchLength, length);
+
+			pointers[operation.id] = static_cast<uint8_t *>(ptr);
+			sizes[operation.id] = operation.size;
+			std::memset(ptr, getPattern(operation.id), operation.size);
+		}
+		else
+		{
+			uint8_t * ptr = pointers[operation.id];
+			if (ptr == nullptr) {
+				// allocation has failed before
+				continue;
+			}
+
+			if (not verifyPattern(ptr, sizes[operation.id], operation.id)) {
+				result.corrupted++;
+			}
+
+			Clock::time_point start = Clock::now();
+			heap.free(ptr);
+			double time = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+			result.frees++;
+			result.freeTime += time;
+			result.maxFreeTime = std::max(result.maxFreeTime, time);
+			pointers[operation.id] = nullptr;
+		}
+	}
+
+	return result;
+}
+
+static void
+printResult(const Heap& heap, const Result& result)
+{
+	XPCC_LOG_INFO << "  " << heap.getName() << xpcc::endl;
+	XPCC_LOG_INFO.printf("    alloc %7.1f ns (max %8.1f)  free %7.1f ns (max %8.1f)",
+			result.allocations ? result.allocationTime / result.allocations : 0.0,
+			result.maxAllocationTime,
+			result.frees ? result.freeTime / result.frees : 0.0,
+			result.maxFreeTime);
+	XPCC_LOG_INFO.printf("  search %5.1f (max %4u)  failed %4u",
+			result.allocations ? double(result.searchLength) / result.allocations : 0.0,
+			unsigned(result.maxSearchLength),
+			unsigned(result.failed));
+	if (result.corrupted) {
+		XPCC_LOG_INFO.printf("  CORRUPTED %u", unsigned(result.corrupted));
+	}
+	XPCC_LOG_INFO << xpcc::endl;
+
+	XPCC_LOG_INFO << "    fragmentation [%]:";
+	for (uint8_t value : result.fragmentation) {
+		XPCC_LOG_INFO << " " << value;
+	}
+	XPCC_LOG_INFO << xpcc::endl;
+}
+
+static void
+benchmark(const char * name, const Trace& trace)
+{
+	XPCC_LOG_INFO << name << " (" << trace.size() << " operations)" << xpcc::endl;
+
+	BlockHeap block;
+	printResult(block, replay(block, trace));
+
+	TlsfBenchmarkHeap * tlsf = new TlsfBenchmarkHeap;
+	printResult(*tlsf, replay(*tlsf, trace));
+	delete tlsf;
+
+	SystemHeap system;
+	printResult(system, replay(system, trace));
+
+	XPCC_LOG_INFO << xpcc::endl;
+}
+
+static int
+fuzz(uint32_t rounds)
+{
+	std::mt19937 random(42);
+	uint32_t errors = 0;
+
+	for (uint32_t round = 0; round < rounds; ++round)
+	{
+		uint32_t maxSize = 1 + (random() % 2048);
+		Trace trace = generateTrace(random(), 5000, 1 + (random() % 200),
+				1, maxSize, random() % 30);
+
+		BlockHeap block;
+		TlsfBenchmarkHeap * tlsf = new TlsfBenchmarkHeap;
+		Heap * heaps[] = { &block, tlsf };
+
+		for (Heap * heap : heaps)
+		{
+			Result result = replay(*heap, trace);
+			if (result.corrupted or not heap->check()) {
+				XPCC_LOG_ERROR << heap->getName() << ": round " << round
+						<< " failed" << xpcc::endl;
+				errors++;
+			}
+		}
+		delete tlsf;
+	}
+
+	XPCC_LOG_INFO << rounds << " rounds, " << errors << " errors" << xpcc::endl;
+	return (errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// ----------------------------------------------------------------------------
+int
+main(int argc, char * argv[])
+{
+	if (argc == 3 and std::strcmp(argv[1], "--fuzz") == 0) {
+		return fuzz(std::atoi(argv[2]));
+	}
+
+	if (argc == 2)
+	{
+		Trace trace;
+		if (not loadTrace(argv[1], trace)) {
+			XPCC_LOG_ERROR << "Could not read trace file '" << argv[1] << "'" << xpcc::endl;
+			return EXIT_FAILURE;
+		}
+		benchmark(argv[1], trace);
+		return EXIT_SUCCESS;
+	}
+
+	// Event payloads of a few bytes with short lifetime (SmartPointer)
+	benchmark("small objects", generateTrace(1, 100000, 64, 1, 32, 0));
+
+	// Medium sized buffers, some of them stay allocated (containers)
+	benchmark("mixed sizes", generateTrace(2, 100000, 128, 16, 512, 10));
+
+	// Large buffers filling most of the heap
+	benchmark("large blocks", generateTrace(3, 20000, 16, 256, 2048, 20));
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,309 @@
+/*
+ * Throughput of every IOStream::operator<< overload and of
+ * IOStream::printf() on different devices.
+ *
+ * Each case writes a batch of pseudo random values to the stream and only
+ * the time of the batch is measured, work of the device afterwards (e.g.
+ * draining a buffer) is not. The values have a uniform number of digits
+ * instead of uniform values, like in format_benchmark. For every device
+ * the average time per call and the number of written bytes per second
+ * is reported, on the Cortex-M3/M4/M7 also the CPU cycles per call.
+ *
+ * The time is taken by xpcc::profiler::Counter, so the suite runs on
+ * hosted targets as well as on microcontrollers, see
+ * examples/stm32f4_discovery/iostream_benchmark. The 64 bit types are not
+ * available on the AVR.
+ */
+
+#ifndef IOSTREAM_BENCHMARK_HPP
+#define IOSTREAM_BENCHMARK_HPP
+
+#include <xpcc/io/iostream.hpp>
+#include <xpcc/debug/profiler/counter.hpp>
+
+#include <cmath>
+#include <cstring>
+
+#if defined(XPCC__CPU_CORTEX_M3) || defined(XPCC__CPU_CORTEX_M4) || defined(XPCC__CPU_CORTEX_M7)
+	// the counter of the profiler counts CPU cycles
+#	define BENCHMARK_CYCLES	1
+#else
+#	define BENCHMARK_CYCLES	0
+#endif
+
+namespace benchmark
+{
+
+typedef xpcc::profiler::Counter Counter;
+
+/// Number of values written by one measured batch
+static constexpr std::size_t ValueCount = 64;
+
+// ----------------------------------------------------------------------------
+/// Discards everything, but counts the written bytes
+class NullDevice : public xpcc::IODevice
+{
+public:
+	using IODevice::write;
+	using IODevice::read;
+
+	NullDevice() :
+		length(0)
+	{
+	}
+
+	virtual void
+	write(char)
+	{
+		length++;
+	}
+
+	virtual void
+	write(const uint8_t *, std::size_t count)
+	{
+		length += count;
+	}
+
+	virtual void
+	flush()
+	{
+	}
+
+	virtual bool
+	read(char&)
+	{
+		return false;
+	}
+
+	std::size_t length;
+};
+
+/// Device under test
+struct Device
+{
+	const char *name;
+	xpcc::IODevice *device;
+
+	/// Called after each batch outside of the measurement, may be `nullptr`
+	void (*afterBatch)();
+};
+
+/// Pseudo random input of the cases
+struct Values
+{
+	uint8_t u8[ValueCount];
+	int16_t i16[ValueCount];
+	uint16_t u16[ValueCount];
+	int32_t i32[ValueCount];
+	uint32_t u32[ValueCount];
+#if !defined(XPCC__CPU_AVR)
+	int64_t i64[ValueCount];
+	uint64_t u64[ValueCount];
+#endif
+	float f32[ValueCount];
+	double f64[ValueCount];
+
+	void
+	generate()
+	{
+		// xorshift, the same values on every target
+		uint32_t state = 2463534242UL;
+		auto random = [&state]() -> uint32_t {
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			return state;
+		};
+
+		for (std::size_t ii = 0; ii < ValueCount; ++ii)
+		{
+			u8[ii] = random() >> (random() % 8);
+			i16[ii] = int16_t(random()) >> (random() % 16);
+			u16[ii] = uint16_t(random()) >> (random() % 16);
+			i32[ii] = int32_t(random()) >> (random() % 32);
+			u32[ii] = random() >> (random() % 32);
+#if !defined(XPCC__CPU_AVR)
+			const uint64_t value = uint64_t(random()) << 32 | random();
+			i64[ii] = int64_t(value) >> (random() % 64);
+			u64[ii] = value >> (random() % 64);
+#endif
+			// typical sensor readings from 1e-6 to 1e6
+			const double mantissa = double(int32_t(random())) / 2147483648.0;
+			const double number = mantissa * std::pow(10.0, int(random() % 13) - 6);
+			f32[ii] = float(number);
+			f64[ii] = number;
+		}
+	}
+};
+
+// ----------------------------------------------------------------------------
+class Suite
+{
+public:
+	/**
+	 * @param	report		Stream for the results, must not be one of the devices
+	 * @param	batches		Number of batches per case and device
+	 */
+	Suite(xpcc::IOStream& report, const Device *devices, std::size_t deviceCount,
+			std::size_t batches) :
+		report(report), devices(devices), deviceCount(deviceCount), batches(batches)
+	{
+		values.generate();
+	}
+
+	void
+	run()
+	{
+		report << "case                device        ns/call    MB/s";
+#if BENCHMARK_CYCLES
+		report << "  cycles/call";
+#endif
+		report << xpcc::endl;
+
+		const Values& v = values;
+		measure("uint8_t", [&v](xpcc::IOStream& stream) {
+			for (std::size_t ii = 0; ii < ValueCount; ++ii) {
+				stream << v.u8[ii];
+			}
+		});
+		measure("int16_t", [&v](xpcc::IOStream& stream) {
+			for (std::size_t ii = 0; ii < ValueCount; ++ii) {
+				stream << v.i16[ii];
+			}
+		});
+		measure("uint16_t", [&v](xpcc::IOStream& stream) {
+			for (std::size_t ii = 0; ii < ValueCount; ++ii) {
+				stream << v.u16[ii];
+			}
+		});
+		measure("int32_t", [&v](xpcc::IOStream& stream) {
+			for (std::size_t ii = 0; ii < ValueCount; ++ii) {
+				stream << v.i32[ii];
+			}
+		});
+		measure("uint32_t", [&v](xpcc::IOStream& stream) {
+			for (std::size_t ii = 0; ii < ValueCount; ++ii) {
+				stream << v.u32[ii];
+			}
+		});
+#if !defined(XPCC__CPU_AVR)
+		measure("int64_t", [&v](xpcc::IOStream& stream) {
+			for (std::size_t ii = 0; ii < ValueCount; ++ii) {
+				stream << v.i64[ii];
+			}
+		});
+		measure("uint64_t", [&v](xpcc::IOStream& stream) {
+			for (std::size_t ii = 0; ii < ValueCount; ++ii) {
+				stream << v.u64[ii];
+			}
+		});
+#endif
+		measure("hex uint32_t", [&v](xpcc::IOStream& stream) {
+			stream << xpcc::hex;
+			for (std::size_t ii = 0; ii < ValueCount; ++ii) {
+				stream << v.u32[ii];
+			}
+			stream << xpcc::ascii;
+		});
+		measure("bin uint16_t", [&v](xpcc::IOStream& stream) {
+			stream << xpcc::bin;
+			for (std::size_t ii = 0; ii < ValueCount; ++ii) {
+				stream << v.u16[ii];
+			}
+			stream << xpcc::ascii;
+		});
+		measure("float", [&v](xpcc::IOStream& stream) {
+			for (std::size_t ii = 0; ii < ValueCount; ++ii) {
+				stream << v.f32[ii];
+			}
+		});
+		measure("double", [&v](xpcc::IOStream& stream) {
+			for (std::size_t ii = 0; ii < ValueCount; ++ii) {
+				stream << v.f64[ii];
+			}
+		});
+		measure("printf %d", [&v](xpcc::IOStream& stream) {
+			for (std::size_t ii = 0; ii < ValueCount; ++ii) {
+				stream.printf("%d", int(v.i16[ii]));
+			}
+		});
+		measure("printf %.3f", [&v](xpcc::IOStream& stream) {
+			for (std::size_t ii = 0; ii < ValueCount; ++ii) {
+				stream.printf("%.3f", double(v.f32[ii]));
+			}
+		});
+		measure("const char*", [](xpcc::IOStream& stream) {
+			for (std::size_t ii = 0; ii < ValueCount; ++ii) {
+				stream << "sensor";
+			}
+		});
+	}
+
+private:
+	template< typename Function >
+	void
+	measure(const char *name, Function function)
+	{
+		// the output is the same for every batch and device
+		NullDevice counter;
+		{
+			xpcc::IOStream stream(counter);
+			function(stream);
+		}
+		const double bytes = double(counter.length) * batches;
+		const double calls = double(ValueCount) * batches;
+
+		for (std::size_t dd = 0; dd < deviceCount; ++dd)
+		{
+			const Device& device = devices[dd];
+			xpcc::IOStream stream(*device.device);
+
+			// warm up the caches
+			function(stream);
+			if (device.afterBatch) {
+				device.afterBatch();
+			}
+
+			uint64_t ticks = 0;
+			for (std::size_t bb = 0; bb < batches; ++bb)
+			{
+				const Counter::Type start = Counter::now();
+				function(stream);
+				ticks += Counter::elapsed(start);
+
+				if (device.afterBatch) {
+					device.afterBatch();
+				}
+			}
+
+			const double seconds = double(ticks) / Counter::getFrequency();
+			writeColumn(name, 20);
+			writeColumn(device.name, 12);
+			report.printf("%8.1f %8.1f", 1e9 * seconds / calls, bytes / seconds / 1e6);
+#if BENCHMARK_CYCLES
+			report.printf("  %8lu", static_cast<unsigned long>(ticks / uint64_t(calls)));
+#endif
+			report << xpcc::endl;
+		}
+	}
+
+	/// Left aligned text
+	void
+	writeColumn(const char *text, std::size_t width)
+	{
+		report << text;
+		for (std::size_t length = std::strlen(text); length < width; ++length) {
+			report << ' ';
+		}
+	}
+
+	xpcc::IOStream& report;
+	const Device *devices;
+	const std::size_t deviceCount;
+	const std::size_t batches;
+	Values values;
+};
+
+}	// namespace benchmark
+
+#endif	// IOSTREAM_BENCHMARK_HPP
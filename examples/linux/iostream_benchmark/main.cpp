@@ -0,0 +1,96 @@
+/*
+ * Benchmark of xpcc::IOStream on a hosted target, see benchmark.hpp.
+ *
+ * The results are written to stderr, the output of the Terminal case to
+ * stdout. Redirect stdout to measure the terminal without the console:
+ *   ./iostream_benchmark > /dev/null
+ *
+ * Compare the results before and after a change of the formatting code
+ * or of a device, differences below 5% are usually noise.
+ */
+
+#include <xpcc/architecture.hpp>
+#include <xpcc/debug/logger.hpp>
+#include <xpcc/architecture/platform/driver/uart/hosted/terminal.hpp>
+#include <xpcc/io/hosted/mapped_file_device.hpp>
+
+#include <cstdio>
+#include <iostream>
+
+#include "benchmark.hpp"
+
+// ----------------------------------------------------------------------------
+class StandardError : public xpcc::IODevice
+{
+public:
+	using IODevice::write;
+	using IODevice::read;
+
+	virtual void
+	write(char c)
+	{
+		std::cerr << c;
+	}
+
+	virtual void
+	write(const uint8_t *data, std::size_t length)
+	{
+		std::cerr.write(reinterpret_cast<const char *>(data), length);
+	}
+
+	virtual void
+	flush()
+	{
+		std::cerr << std::flush;
+	}
+
+	virtual bool
+	read(char&)
+	{
+		return false;
+	}
+};
+
+static benchmark::NullDevice nullDevice;
+
+static uint8_t logMemory[64 * 1024];
+static xpcc::log::BufferedDevice bufferedDevice(logMemory, sizeof(logMemory));
+
+static xpcc::pc::Terminal terminal;
+
+static xpcc::hosted::MappedFileDevice mappedFile;
+
+static void
+drainBufferedDevice()
+{
+	benchmark::NullDevice discard;
+	bufferedDevice.drain(discard);
+}
+
+// ----------------------------------------------------------------------------
+int
+main()
+{
+	const char *path = "iostream_benchmark.log";
+	mappedFile.setSync(xpcc::hosted::MappedFileDevice::Sync::Never);
+	mappedFile.open(path);
+
+	const benchmark::Device devices[] = {
+		{ "null",        &nullDevice,     nullptr },
+		{ "buffered",    &bufferedDevice, drainBufferedDevice },
+		{ "terminal",    &terminal,       nullptr },
+		{ "mapped file", &mappedFile,     nullptr },
+	};
+
+	StandardError error;
+	xpcc::IOStream report(error);
+
+	benchmark::Suite suite(report, devices, sizeof(devices) / sizeof(devices[0]), 10000);
+	suite.run();
+
+	terminal.flush();
+	mappedFile.close();
+	std::remove(path);
+
+	return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ * Benchmark of the resumable function macros against the C++20 coroutine
+ * implementation xpcc::co::Resumable.
+ *
+ * Both variants run the same nested call: `update()` calls `readValue()`
+ * twice, which yields once before returning a value. The benchmark reports
+ * the time per call (including the frame allocation of the coroutines),
+ * the time per resume and the RAM used for the state of the functions.
+ *
+ * Build with coroutine support, otherwise only the macros are measured:
+ *   CXXFLAGS="-std=c++20" scons
+ *
+ * To compare the code size, build for an ARM target with the same flags
+ * and look at the size of the benchmark functions:
+ *   arm-none-eabi-nm -C -S --size-sort <elf> | grep Sensor
+ */
+
+#include <xpcc/architecture.hpp>
+#include <xpcc/debug/logger.hpp>
+#include <xpcc/processing/resumable.hpp>
+
+#include <chrono>
+
+#undef	XPCC_LOG_LEVEL
+#define	XPCC_LOG_LEVEL xpcc::log::INFO
+
+static constexpr uint32_t calls = 1000000;
+
+// ----------------------------------------------------------------------------
+class MacroSensor : public xpcc::NestedResumable<2>
+{
+public:
+	MacroSensor() :
+		value(0), sum(0)
+	{
+	}
+
+	xpcc::ResumableResult<uint32_t>
+	update()
+	{
+		RF_BEGIN();
+
+		sum = RF_CALL(readValue());
+		sum += RF_CALL(readValue());
+
+		RF_END_RETURN(sum);
+	}
+
+private:
+	xpcc::ResumableResult<uint32_t>
+	readValue()
+	{
+		RF_BEGIN();
+
+		RF_YIELD();
+
+		RF_END_RETURN(value++);
+	}
+
+	uint32_t value;
+	uint32_t sum;
+};
+
+#if XPCC_RESUMABLE_COROUTINES
+class CoroutineSensor
+{
+public:
+	CoroutineSensor() :
+		value(0)
+	{
+	}
+
+	xpcc::co::Resumable<uint32_t>
+	update()
+	{
+		uint32_t sum = CO_CALL(readValue());
+		sum += CO_CALL(readValue());
+		co_return sum;
+	}
+
+private:
+	xpcc::co::Resumable<uint32_t>
+	readValue()
+	{
+		CO_YIELD();
+		co_return value++;
+	}
+
+	uint32_t value;
+};
+#endif
+
+// ----------------------------------------------------------------------------
+static void
+report(const char *name, std::chrono::nanoseconds time, uint32_t resumes,
+		uint32_t result, std::size_t ram)
+{
+	XPCC_LOG_INFO.printf("%s\n", name);
+	XPCC_LOG_INFO.printf("  call   %7.1f ns\n", float(time.count()) / calls);
+	XPCC_LOG_INFO.printf("  resume %7.1f ns  (%u resumes)\n",
+			float(time.count()) / resumes, unsigned(resumes));
+	XPCC_LOG_INFO.printf("  state  %7u bytes\n", unsigned(ram));
+	// print the result, so that the compiler can't remove the calls
+	XPCC_LOG_INFO << "  result " << result << xpcc::endl;
+}
+
+static void
+benchmarkMacros()
+{
+	MacroSensor sensor;
+	uint32_t resumes = 0;
+	uint32_t result = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (uint32_t ii = 0; ii < calls; ++ii)
+	{
+		xpcc::ResumableResult<uint32_t> rf(xpcc::rf::Running);
+		do {
+			rf = sensor.update();
+			resumes++;
+		}
+		while (rf.getState() > xpcc::rf::NestingError);
+		result += rf.getResult();
+	}
+	const auto time = std::chrono::steady_clock::now() - start;
+
+	// the state of all resumable functions is part of the object
+	report("macros", time, resumes, result, sizeof(MacroSensor));
+}
+
+#if XPCC_RESUMABLE_COROUTINES
+static void
+benchmarkCoroutines()
+{
+	CoroutineSensor sensor;
+	uint32_t resumes = 0;
+	uint32_t result = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (uint32_t ii = 0; ii < calls; ++ii)
+	{
+		xpcc::co::Resumable<uint32_t> coroutine = sensor.update();
+		do {
+			resumes++;
+		}
+		while (coroutine.run());
+		result += coroutine.getResult();
+	}
+	const auto time = std::chrono::steady_clock::now() - start;
+
+	// one frame for update() and one for the running readValue()
+	typedef xpcc::co::DefaultFramePool Pool;
+	report("coroutines", time, resumes, result,
+			sizeof(CoroutineSensor) + Pool::getHighWaterMark() * Pool::getLargestRequest());
+
+	XPCC_LOG_INFO.printf("  frames %7u of %u bytes in use at most, largest frame %u bytes\n",
+			unsigned(Pool::getHighWaterMark()), unsigned(Pool::FrameSize),
+			unsigned(Pool::getLargestRequest()));
+}
+#endif
+
+int
+main()
+{
+	benchmarkMacros();
+
+#if XPCC_RESUMABLE_COROUTINES
+	benchmarkCoroutines();
+#else
+	XPCC_LOG_INFO << "Compiled without C++20 coroutine support, "
+			"build with CXXFLAGS=\"-std=c++20\"" << xpcc::endl;
+#endif
+
+	return 0;
+}
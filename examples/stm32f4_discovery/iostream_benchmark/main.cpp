@@ -0,0 +1,56 @@
+/*
+ * Benchmark of xpcc::IOStream on the STM32F4 at 168 MHz, see
+ * examples/linux/iostream_benchmark/benchmark.hpp.
+ *
+ * The results including the CPU cycles per call are written with 115200
+ * baud, 8N1 to pin PA2. The UART itself is not measured, its output would
+ * be mixed with the results.
+ */
+
+#include <xpcc/architecture/platform.hpp>
+#include <xpcc/debug/logger.hpp>
+
+#include "../../linux/iostream_benchmark/benchmark.hpp"
+
+xpcc::IODeviceWrapper< Usart2, xpcc::IOBuffer::BlockIfFull > uart;
+
+static benchmark::NullDevice nullDevice;
+
+static uint8_t logMemory[4096];
+static xpcc::log::BufferedDevice bufferedDevice(logMemory, sizeof(logMemory));
+
+static void
+drainBufferedDevice()
+{
+	benchmark::NullDevice discard;
+	bufferedDevice.drain(discard);
+}
+
+// ----------------------------------------------------------------------------
+int
+main()
+{
+	Board::initialize();
+
+	GpioOutputA2::connect(Usart2::Tx);
+	Usart2::initialize<Board::systemClock, 115200>(12);
+
+	const benchmark::Device devices[] = {
+		{ "null",     &nullDevice,     nullptr },
+		{ "buffered", &bufferedDevice, drainBufferedDevice },
+	};
+
+	xpcc::IOStream report(uart);
+	report << "IOStream benchmark" << xpcc::endl;
+
+	benchmark::Suite suite(report, devices, sizeof(devices) / sizeof(devices[0]), 100);
+	suite.run();
+
+	while (1)
+	{
+		Board::LedGreen::toggle();
+		xpcc::delayMilliseconds(500);
+	}
+
+	return 0;
+}
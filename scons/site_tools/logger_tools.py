@@ -33,7 +33,7 @@ from SCons.Script import *
 # this is apparently not pythonic, but I see no other way to do this
 # without polluting the site_tools directory or haveing duplicate code
 sys.path.append(os.path.join(os.path.dirname(__file__), '..', '..', 'tools', 'logger'))
-from logger import Logger
+from logger import Logger, LogDictionary
 
 # -----------------------------------------------------------------------------
 def logger_debug(env, s, alias='logger_debug'):
@@ -63,6 +63,16 @@ def logger_is_log_level(env, log_level, alias='logger_is_log_level'):
 def logger_get_logger(env, alias='logger_is_log_level'):
 	return env['XPCC_LOGGER']
 
+# -----------------------------------------------------------------------------
+def log_dictionary_action(target, source, env):
+	dictionary = LogDictionary()
+	for file in source:
+		dictionary.scan(str(file))
+	dictionary.save(str(target[0]))
+
+def log_dictionary_string(target, source, env):
+	return "Log Dictionary: '%s'" % (str(target[0]))
+
 # -----------------------------------------------------------------------------
 def generate(env, **kw):
 	env['XPCC_LOGGER'] = Logger()
@@ -74,5 +84,13 @@ def generate(env, **kw):
 	env.AddMethod(logger_is_log_level, 'IsLogLevel')
 	env.AddMethod(logger_get_logger, 'GetLogger')
 
+	# Format strings of the deferred logger, see xpcc/debug/logger/deferred.hpp
+	env.Append(
+		BUILDERS = {
+			'LogDictionary': env.Builder(
+				action = env.Action(log_dictionary_action, log_dictionary_string),
+				suffix = '.logdict'),
+	})
+
 def exists(env):
 	return True
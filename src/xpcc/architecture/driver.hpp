@@ -36,4 +36,6 @@
 #include "driver/atomic.hpp"
 #include "driver/accessor.hpp"
 #include "driver/delay.hpp"
+#include "driver/idle.hpp"
 #include "driver/clock.hpp"
+#include "driver/precise_clock.hpp"
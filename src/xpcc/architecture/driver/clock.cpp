@@ -25,11 +25,16 @@
 
 #elif ( defined(XPCC__OS_UNIX) || defined(XPCC__OS_OSX) )
 #	include <sys/time.h>
+#	include "virtual_clock/virtual_clock.hpp"
 
 	template< typename TimestampType >
 	TimestampType
 	xpcc::Clock::now()
 	{
+		if (VirtualClock::isEnabled()) {
+			return VirtualClock::now<TimestampType>();
+		}
+
 		struct timeval now;
 		gettimeofday(&now, 0);
 
@@ -38,11 +43,16 @@
 
 #elif defined(XPCC__OS_WIN32) || defined(XPCC__OS_WIN64)
 #	include <windows.h>
+#	include "virtual_clock/virtual_clock.hpp"
 
 	template< typename TimestampType >
 	TimestampType
 	xpcc::Clock::now()
 	{
+		if (VirtualClock::isEnabled()) {
+			return VirtualClock::now<TimestampType>();
+		}
+
 		SYSTEMTIME now;
 		GetSystemTime(&now);
 
@@ -95,6 +95,24 @@ namespace xpcc
 		std::size_t
 		getAvailableSize() const;
 		
+		/**
+		 * Size of the largest contiguous free area in bytes.
+		 * 
+		 * Walks over all blocks, only intended for diagnostics.
+		 */
+		std::size_t
+		getLargestFreeSize() const;
+		
+		/**
+		 * Number of block headers allocate() would have to inspect to
+		 * satisfy a request of the given size.
+		 * 
+		 * If no area is large enough all blocks following the free hint
+		 * are inspected. Only intended for diagnostics and benchmarks.
+		 */
+		std::size_t
+		getSearchLength(std::size_t requestedSize) const;
+		
 	private:
 		// Align the pointer to a multiple of XPCC__ALIGNMENT
 		xpcc_always_inline T *
@@ -171,7 +171,9 @@ xpcc::BlockAllocator<T, BLOCK_SIZE>::free(void *ptr)
 	if (p - 1 >= start) {
 		slots = *(p - 1);
 		if (slots < 0) {
-			p += slots * BLOCK_SIZE;
+			// slots * BLOCK_SIZE would be unsigned, which breaks the
+			// pointer arithmetic on 64-bit hosts
+			p -= (-slots) * BLOCK_SIZE;
 			freeSlots += -slots;
 		}
 	}
@@ -222,6 +224,65 @@ xpcc::BlockAllocator<T, BLOCK_SIZE>::getAvailableSize() const
 	return size;
 }
 
+// ----------------------------------------------------------------------------
+template <typename T, unsigned int BLOCK_SIZE >
+std::size_t
+xpcc::BlockAllocator<T, BLOCK_SIZE>::getLargestFreeSize() const
+{
+	T *p = start;
+	std::size_t largest = 0;
+	
+	do {
+		SignedType slots = *p;
+		
+		if (slots < 0)
+		{
+			slots = -slots;
+			std::size_t size = slots * BLOCK_SIZE * sizeof(T);
+			if (size > largest) {
+				largest = size;
+			}
+		}
+		
+		p += slots * BLOCK_SIZE;
+	}
+	while (p < end);
+	
+	return largest;
+}
+
+// ----------------------------------------------------------------------------
+template <typename T, unsigned int BLOCK_SIZE >
+std::size_t
+xpcc::BlockAllocator<T, BLOCK_SIZE>::getSearchLength(std::size_t requestedSize) const
+{
+	// must match the calculation in allocate()
+	requestedSize += 4;
+	std::size_t neededSlots = (requestedSize + (BLOCK_SIZE * sizeof(T) - 1)) / 
+			(BLOCK_SIZE * sizeof(T));
+	
+	T *p = freeHint;
+	std::size_t length = 0;
+	do
+	{
+		length++;
+		
+		SignedType slots = *p;
+		if (slots < 0)
+		{
+			slots = -slots;
+			if (static_cast<std::size_t>(slots) >= neededSlots) {
+				break;
+			}
+		}
+		
+		p += slots * BLOCK_SIZE;
+	}
+	while (p < end);
+	
+	return length;
+}
+
 // ----------------------------------------------------------------------------
 template<typename T, unsigned int BLOCK_SIZE >
 xpcc_always_inline T *
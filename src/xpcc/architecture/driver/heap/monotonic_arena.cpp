@@ -0,0 +1,53 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include "monotonic_arena.hpp"
+
+// ----------------------------------------------------------------------------
+xpcc::MonotonicArena::MonotonicArena(void * memory, std::size_t size) :
+	start(static_cast<uint8_t *>(memory)), end(start + size), current(start),
+	highWaterMark(0), failedAllocations(0)
+{
+}
+
+// ----------------------------------------------------------------------------
+void *
+xpcc::MonotonicArena::allocate(std::size_t requestedSize)
+{
+	// (XPCC__ALIGNMENT - 1) is used as a bitmask
+	std::size_t padding = (XPCC__ALIGNMENT - ((uintptr_t) current &
+			(XPCC__ALIGNMENT - 1))) & (XPCC__ALIGNMENT - 1);
+
+	if (padding > getFreeSize() or requestedSize > getFreeSize() - padding)
+	{
+		failedAllocations++;
+		return nullptr;
+	}
+
+	uint8_t * ptr = current + padding;
+	current = ptr + requestedSize;
+
+	if (getUsedSize() > highWaterMark) {
+		highWaterMark = getUsedSize();
+	}
+	return ptr;
+}
+
+void
+xpcc::MonotonicArena::reset()
+{
+	current = start;
+}
+
+bool
+xpcc::MonotonicArena::contains(const void * ptr) const
+{
+	const uint8_t * p = static_cast<const uint8_t *>(ptr);
+	return (start <= p) and (p < end);
+}
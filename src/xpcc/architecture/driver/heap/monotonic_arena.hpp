@@ -0,0 +1,156 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC__MONOTONIC_ARENA_HPP
+#define XPCC__MONOTONIC_ARENA_HPP
+
+#include <stdint.h>
+#include <cstddef>
+
+#include <xpcc/architecture/detect.hpp>
+#include <xpcc/architecture/utils.hpp>
+
+namespace xpcc
+{
+
+/**
+ * Monotonic memory arena for short-lived allocations.
+ *
+ * Allocating memory only moves a pointer forward, freeing a single
+ * allocation does nothing. All memory is released at once by calling
+ * reset(), typically at the end of one iteration of the main loop:
+ *
+ * @code
+ * xpcc::StaticMonotonicArena<2048> frameArena;
+ *
+ * while (true)
+ * {
+ *     dispatcher.update();
+ *     view.update();   // temporaries are allocated from frameArena
+ *
+ *     frameArena.reset();
+ * }
+ * @endcode
+ *
+ * Because nothing is ever freed individually, the arena can't fragment and
+ * both allocation and release are O(1). Objects allocated from the arena
+ * must not be used after the next reset(), their destructors are not
+ * called by the arena.
+ *
+ * Use the xpcc::allocator::Monotonic policy to make a container allocate
+ * its elements from an arena.
+ *
+ * @warning	The arena is not interrupt- or thread-safe.
+ *
+ * @see		xpcc::allocator::Monotonic
+ * @ingroup	allocator
+ */
+class MonotonicArena
+{
+public:
+	/**
+	 * @param	memory	Start of the memory region used by the arena
+	 * @param	size	Size of the region in bytes
+	 */
+	MonotonicArena(void * memory, std::size_t size);
+
+	/**
+	 * Allocate memory aligned to XPCC__ALIGNMENT.
+	 *
+	 * @return	Pointer to the memory or `nullptr` if the arena has not
+	 * 			enough space left.
+	 */
+	void *
+	allocate(std::size_t requestedSize);
+
+	/// Does nothing, the memory is only released by reset().
+	inline void
+	free(void *)
+	{
+	}
+
+	/// Release all allocations at once
+	void
+	reset();
+
+	/// Returns `true` if `ptr` lies within the memory region of this arena
+	bool
+	contains(const void * ptr) const;
+
+public:
+	/// Bytes allocated since the last reset, including alignment padding
+	inline std::size_t
+	getUsedSize() const
+	{
+		return current - start;
+	}
+
+	inline std::size_t
+	getFreeSize() const
+	{
+		return end - current;
+	}
+
+	inline std::size_t
+	getTotalSize() const
+	{
+		return end - start;
+	}
+
+	/// Maximum number of bytes used within one cycle
+	inline std::size_t
+	getHighWaterMark() const
+	{
+		return highWaterMark;
+	}
+
+	/// Number of allocations which could not be satisfied
+	inline uint32_t
+	getFailedAllocations() const
+	{
+		return failedAllocations;
+	}
+
+private:
+	MonotonicArena(const MonotonicArena&);
+
+	MonotonicArena&
+	operator = (const MonotonicArena&);
+
+	uint8_t * start;
+	uint8_t * end;
+	uint8_t * current;
+
+	std::size_t highWaterMark;
+	uint32_t failedAllocations;
+};
+
+/**
+ * MonotonicArena with a statically allocated memory region.
+ *
+ * @tparam	Size	Size of the memory region in bytes
+ *
+ * @ingroup	allocator
+ */
+template< std::size_t Size >
+class StaticMonotonicArena : public MonotonicArena
+{
+public:
+	StaticMonotonicArena() :
+		MonotonicArena(memory, Size)
+	{
+	}
+
+private:
+	uint8_t memory[Size] xpcc_aligned(XPCC__ALIGNMENT);
+};
+
+}	// namespace xpcc
+
+#endif	// XPCC__MONOTONIC_ARENA_HPP
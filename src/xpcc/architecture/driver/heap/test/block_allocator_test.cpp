@@ -116,3 +116,37 @@ BlockAllocatorTest::testAlignment()
 
 	delete[] heap;
 }
+
+void
+BlockAllocatorTest::testDiagnostics()
+{
+	uint8_t *heap = new uint8_t[512];
+	
+	xpcc::BlockAllocator<uint16_t, 8> allocator;
+	allocator.initialize(heap, heap + 512);
+	
+	TEST_ASSERT_EQUALS(allocator.getLargestFreeSize(), 496U);
+	TEST_ASSERT_EQUALS(allocator.getSearchLength(12), 1U);
+	
+	void* first = allocator.allocate(12);
+	allocator.allocate(12);
+	void* third = allocator.allocate(12);
+	allocator.allocate(12);
+	
+	TEST_ASSERT_EQUALS(allocator.getLargestFreeSize(), 432U);
+	TEST_ASSERT_EQUALS(allocator.getSearchLength(12), 5U);
+	
+	allocator.free(first);
+	allocator.free(third);
+	
+	// both holes are too small for 20 bytes
+	TEST_ASSERT_EQUALS(allocator.getSearchLength(12), 1U);
+	TEST_ASSERT_EQUALS(allocator.getSearchLength(20), 5U);
+	TEST_ASSERT_EQUALS(allocator.getLargestFreeSize(), 432U);
+	TEST_ASSERT_EQUALS(allocator.getAvailableSize(), 464U);
+	
+	// no area is large enough
+	TEST_ASSERT_EQUALS(allocator.getSearchLength(1000), 5U);
+	
+	delete[] heap;
+}
@@ -47,6 +47,9 @@ public:
 
 	void
 	testAlignment();
+
+	void
+	testDiagnostics();
 };
 
 #endif	// BLOCK_ALLOCATOR_TEST_HPP
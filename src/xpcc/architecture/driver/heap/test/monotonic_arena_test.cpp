@@ -0,0 +1,103 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/container/dynamic_array.hpp>
+#include <xpcc/container/linked_list.hpp>
+#include <xpcc/utils/allocator/monotonic.hpp>
+
+#include "monotonic_arena_test.hpp"
+
+#include "../monotonic_arena.hpp"
+
+void
+MonotonicArenaTest::testAllocate()
+{
+	xpcc::StaticMonotonicArena<64> arena;
+
+	TEST_ASSERT_EQUALS(arena.getTotalSize(), 64U);
+	TEST_ASSERT_EQUALS(arena.getUsedSize(), 0U);
+	TEST_ASSERT_EQUALS(arena.getFreeSize(), 64U);
+
+	void * first = arena.allocate(16);
+	void * second = arena.allocate(16);
+
+	TEST_ASSERT_TRUE(first != nullptr);
+	TEST_ASSERT_TRUE(second != nullptr);
+	TEST_ASSERT_EQUALS(static_cast<uint8_t *>(second) - static_cast<uint8_t *>(first), 16);
+	TEST_ASSERT_TRUE(arena.contains(first));
+	TEST_ASSERT_TRUE(arena.contains(second));
+	TEST_ASSERT_FALSE(arena.contains(&arena));
+
+	TEST_ASSERT_EQUALS(arena.getUsedSize(), 32U);
+
+	// freeing does not release memory
+	arena.free(second);
+	TEST_ASSERT_EQUALS(arena.getUsedSize(), 32U);
+
+	TEST_ASSERT_TRUE(arena.allocate(32) != nullptr);
+	TEST_ASSERT_EQUALS(arena.getFreeSize(), 0U);
+
+	TEST_ASSERT_TRUE(arena.allocate(1) == nullptr);
+	TEST_ASSERT_EQUALS(arena.getFailedAllocations(), 1U);
+}
+
+void
+MonotonicArenaTest::testAlignment()
+{
+	xpcc::StaticMonotonicArena<128> arena;
+
+	for (uint8_t size = 1; size < 10; ++size)
+	{
+		void * ptr = arena.allocate(size);
+		TEST_ASSERT_TRUE(ptr != nullptr);
+		TEST_ASSERT_EQUALS(((uintptr_t) ptr) % XPCC__ALIGNMENT, 0U);
+	}
+}
+
+void
+MonotonicArenaTest::testReset()
+{
+	xpcc::StaticMonotonicArena<64> arena;
+
+	void * first = arena.allocate(40);
+	arena.allocate(8);
+	TEST_ASSERT_EQUALS(arena.getHighWaterMark(), 48U);
+
+	arena.reset();
+	TEST_ASSERT_EQUALS(arena.getUsedSize(), 0U);
+	TEST_ASSERT_EQUALS(arena.getHighWaterMark(), 48U);
+
+	// memory is reused after the reset
+	TEST_ASSERT_TRUE(arena.allocate(8) == first);
+	TEST_ASSERT_EQUALS(arena.getHighWaterMark(), 48U);
+}
+
+void
+MonotonicArenaTest::testAllocatorPolicy()
+{
+	xpcc::StaticMonotonicArena<512> arena;
+	{
+		xpcc::DynamicArray<int16_t, xpcc::allocator::Monotonic<int16_t> > array(8, arena);
+		for (int16_t i = 0; i < 8; ++i) {
+			array.append(i);
+		}
+		TEST_ASSERT_EQUALS(array[7], 7);
+		TEST_ASSERT_TRUE(arena.contains(&array[0]));
+
+		xpcc::LinkedList<int32_t, xpcc::allocator::Monotonic<int32_t> > list(arena);
+		list.append(1);
+		list.append(2);
+		TEST_ASSERT_EQUALS(list.getBack(), 2);
+		TEST_ASSERT_TRUE(arena.contains(&list.getFront()));
+	}
+	TEST_ASSERT_TRUE(arena.getUsedSize() > 0);
+
+	arena.reset();
+	TEST_ASSERT_EQUALS(arena.getUsedSize(), 0U);
+}
@@ -0,0 +1,31 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef MONOTONIC_ARENA_TEST_HPP
+#define MONOTONIC_ARENA_TEST_HPP
+
+#include <unittest/testsuite.hpp>
+
+class MonotonicArenaTest : public unittest::TestSuite
+{
+public:
+	void
+	testAllocate();
+
+	void
+	testAlignment();
+
+	void
+	testReset();
+
+	void
+	testAllocatorPolicy();
+};
+
+#endif	// MONOTONIC_ARENA_TEST_HPP
@@ -0,0 +1,131 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/container/linked_list.hpp>
+#include <xpcc/utils/allocator/tlsf.hpp>
+
+#include "tlsf_heap_test.hpp"
+
+#include "../tlsf_heap.hpp"
+
+void
+TlsfHeapTest::testAllocate()
+{
+	xpcc::StaticTlsfHeap<16384> heap;
+
+	TEST_ASSERT_TRUE(heap.check());
+	TEST_ASSERT_TRUE(heap.getTotalSize() > 4096);
+	TEST_ASSERT_EQUALS(heap.getFreeSize(), heap.getTotalSize());
+
+	void * first = heap.allocate(100);
+	void * second = heap.allocate(100);
+
+	TEST_ASSERT_TRUE(first != nullptr);
+	TEST_ASSERT_TRUE(second != nullptr);
+	TEST_ASSERT_TRUE(first != second);
+	TEST_ASSERT_TRUE(heap.contains(first));
+	TEST_ASSERT_TRUE(heap.contains(second));
+	TEST_ASSERT_FALSE(heap.contains(&heap));
+
+	TEST_ASSERT_TRUE(heap.getFreeSize() < heap.getTotalSize() - 200);
+
+	heap.free(first);
+	heap.free(second);
+	heap.free(nullptr);
+
+	TEST_ASSERT_EQUALS(heap.getFreeSize(), heap.getTotalSize());
+	TEST_ASSERT_TRUE(heap.check());
+
+	// too large for the heap
+	TEST_ASSERT_TRUE(heap.allocate(20000) == nullptr);
+}
+
+void
+TlsfHeapTest::testStatistics()
+{
+	xpcc::StaticTlsfHeap<16384> heap;
+
+	TEST_ASSERT_EQUALS(heap.getStatistics().used, 0U);
+	TEST_ASSERT_EQUALS(heap.getStatistics().highWaterMark, 0U);
+	TEST_ASSERT_EQUALS(heap.getStatistics().allocations, 0U);
+
+	void * a = heap.allocate(64);
+	void * b = heap.allocate(128);
+	std::size_t peak = heap.getStatistics().used;
+
+	TEST_ASSERT_TRUE(peak >= 192);
+	TEST_ASSERT_EQUALS(heap.getStatistics().highWaterMark, peak);
+	TEST_ASSERT_EQUALS(heap.getStatistics().allocations, 2U);
+
+	heap.free(b);
+	TEST_ASSERT_TRUE(heap.getStatistics().used < peak);
+	TEST_ASSERT_EQUALS(heap.getStatistics().highWaterMark, peak);
+	TEST_ASSERT_EQUALS(heap.getStatistics().deallocations, 1U);
+
+	heap.resetHighWaterMark();
+	TEST_ASSERT_EQUALS(heap.getStatistics().highWaterMark, heap.getStatistics().used);
+
+	TEST_ASSERT_TRUE(heap.allocate(100000) == nullptr);
+	TEST_ASSERT_EQUALS(heap.getStatistics().failedAllocations, 1U);
+	TEST_ASSERT_EQUALS(heap.getStatistics().allocations, 2U);
+
+	heap.free(a);
+	TEST_ASSERT_EQUALS(heap.getStatistics().used, 0U);
+}
+
+void
+TlsfHeapTest::testFragmentation()
+{
+	xpcc::StaticTlsfHeap<16384> heap;
+
+	TEST_ASSERT_EQUALS(heap.getFragmentation(), 0U);
+	TEST_ASSERT_EQUALS(heap.getLargestFreeBlock(), heap.getTotalSize());
+
+	void * blocks[16];
+	for (uint8_t i = 0; i < 16; ++i) {
+		blocks[i] = heap.allocate(256);
+	}
+
+	// free every second block to create holes
+	for (uint8_t i = 0; i < 16; i += 2) {
+		heap.free(blocks[i]);
+	}
+
+	TEST_ASSERT_TRUE(heap.getFragmentation() > 0);
+	TEST_ASSERT_TRUE(heap.getLargestFreeBlock() < heap.getFreeSize());
+
+	for (uint8_t i = 1; i < 16; i += 2) {
+		heap.free(blocks[i]);
+	}
+
+	TEST_ASSERT_EQUALS(heap.getFragmentation(), 0U);
+	TEST_ASSERT_TRUE(heap.check());
+}
+
+void
+TlsfHeapTest::testAllocatorPolicy()
+{
+	xpcc::StaticTlsfHeap<8192> heap;
+	{
+		xpcc::LinkedList<int32_t, xpcc::allocator::Tlsf<int32_t> > list(heap);
+
+		list.append(1);
+		list.append(2);
+		list.append(3);
+
+		TEST_ASSERT_EQUALS(heap.getStatistics().allocations, 3U);
+		TEST_ASSERT_EQUALS(list.getFront(), 1);
+		TEST_ASSERT_EQUALS(list.getBack(), 3);
+
+		list.removeFront();
+		TEST_ASSERT_EQUALS(heap.getStatistics().deallocations, 1U);
+	}
+	TEST_ASSERT_EQUALS(heap.getStatistics().deallocations, 3U);
+	TEST_ASSERT_EQUALS(heap.getStatistics().used, 0U);
+}
@@ -0,0 +1,31 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef TLSF_HEAP_TEST_HPP
+#define TLSF_HEAP_TEST_HPP
+
+#include <unittest/testsuite.hpp>
+
+class TlsfHeapTest : public unittest::TestSuite
+{
+public:
+	void
+	testAllocate();
+
+	void
+	testStatistics();
+
+	void
+	testFragmentation();
+
+	void
+	testAllocatorPolicy();
+};
+
+#endif	// TLSF_HEAP_TEST_HPP
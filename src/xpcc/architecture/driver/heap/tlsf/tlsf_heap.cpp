@@ -0,0 +1,137 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <tlsf.h>
+#include <xpcc/architecture/interface/assert.hpp>
+
+#include "tlsf_heap.hpp"
+
+namespace
+{
+	struct FreeBlockInfo
+	{
+		std::size_t free;
+		std::size_t largest;
+	};
+
+	void
+	collectFreeBlocks(void * /* ptr */, std::size_t size, int used, void * user)
+	{
+		if (not used)
+		{
+			FreeBlockInfo * info = static_cast<FreeBlockInfo *>(user);
+			info->free += size;
+			if (size > info->largest) {
+				info->largest = size;
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+xpcc::TlsfHeap::TlsfHeap(void * memory, std::size_t size) :
+	tlsf(0), start(static_cast<const uint8_t *>(memory)),
+	end(static_cast<const uint8_t *>(memory) + size), totalSize(0)
+{
+	statistics.used = 0;
+	statistics.highWaterMark = 0;
+	statistics.allocations = 0;
+	statistics.deallocations = 0;
+	statistics.failedAllocations = 0;
+
+	tlsf = tlsf_create_with_pool(memory, size);
+	xpcc_assert(tlsf != 0, "tlsf", "heap", "create", size);
+
+	if (tlsf != 0) {
+		totalSize = getLargestFreeBlock();
+	}
+}
+
+// ----------------------------------------------------------------------------
+void *
+xpcc::TlsfHeap::allocate(std::size_t requestedSize)
+{
+	void * ptr = tlsf_malloc(tlsf, requestedSize);
+	if (ptr == 0)
+	{
+		statistics.failedAllocations++;
+		return nullptr;
+	}
+
+	statistics.allocations++;
+	statistics.used += tlsf_block_size(ptr) + tlsf_alloc_overhead();
+	if (statistics.used > statistics.highWaterMark) {
+		statistics.highWaterMark = statistics.used;
+	}
+	return ptr;
+}
+
+void
+xpcc::TlsfHeap::free(void * ptr)
+{
+	if (ptr == 0) {
+		return;
+	}
+	xpcc_assert_debug(contains(ptr), "tlsf", "heap", "free", uintptr_t(ptr));
+
+	statistics.deallocations++;
+	statistics.used -= tlsf_block_size(ptr) + tlsf_alloc_overhead();
+	tlsf_free(tlsf, ptr);
+}
+
+bool
+xpcc::TlsfHeap::contains(const void * ptr) const
+{
+	const uint8_t * p = static_cast<const uint8_t *>(ptr);
+	return (start <= p) and (p < end);
+}
+
+// ----------------------------------------------------------------------------
+void
+xpcc::TlsfHeap::resetHighWaterMark()
+{
+	statistics.highWaterMark = statistics.used;
+}
+
+std::size_t
+xpcc::TlsfHeap::getTotalSize() const
+{
+	return totalSize;
+}
+
+std::size_t
+xpcc::TlsfHeap::getFreeSize() const
+{
+	return totalSize - statistics.used;
+}
+
+std::size_t
+xpcc::TlsfHeap::getLargestFreeBlock() const
+{
+	FreeBlockInfo info = { 0, 0 };
+	tlsf_walk_pool(tlsf_get_pool(tlsf), collectFreeBlocks, &info);
+	return info.largest;
+}
+
+uint8_t
+xpcc::TlsfHeap::getFragmentation() const
+{
+	FreeBlockInfo info = { 0, 0 };
+	tlsf_walk_pool(tlsf_get_pool(tlsf), collectFreeBlocks, &info);
+	if (info.free == 0) {
+		return 0;
+	}
+	return 100 - static_cast<uint8_t>((uint64_t(info.largest) * 100) / info.free);
+}
+
+bool
+xpcc::TlsfHeap::check() const
+{
+	return (tlsf_check(tlsf) == 0) and (tlsf_check_pool(tlsf_get_pool(tlsf)) == 0);
+}
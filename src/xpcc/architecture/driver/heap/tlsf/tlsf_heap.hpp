@@ -0,0 +1,193 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC__TLSF_HEAP_HPP
+#define XPCC__TLSF_HEAP_HPP
+
+#include <stdint.h>
+#include <cstddef>
+
+#include <xpcc/architecture/utils.hpp>
+
+namespace xpcc
+{
+
+/**
+ * Private heap managed by the TLSF (Two Level Segregated Fit) allocator.
+ *
+ * In contrast to the global heap selected with the `allocator` parameter of
+ * the Cortex-M core driver, a TlsfHeap manages a single user supplied memory
+ * region. This allows a subsystem to own its memory, so that it can
+ * neither exhaust nor fragment the memory of other subsystems.
+ *
+ * Allocation and deallocation are O(1) with a bounded worst case execution
+ * time. The TLSF control structure is placed at the beginning of the
+ * region and takes roughly 3kB on 32-bit targets (6kB on 64-bit hosts),
+ * see `tlsf_size()`.
+ *
+ * Every heap keeps statistics about its usage, which are useful to size the
+ * memory region based on measurements instead of guesses:
+ *
+ * @code
+ * xpcc::StaticTlsfHeap<8192> heap;
+ *
+ * void * p = heap.allocate(100);
+ * ...
+ * heap.free(p);
+ *
+ * XPCC_LOG_INFO << "high water mark: " << heap.getStatistics().highWaterMark << xpcc::endl;
+ * @endcode
+ *
+ * Use the xpcc::allocator::Tlsf policy to make a container allocate its
+ * elements from a TlsfHeap.
+ *
+ * @warning	The heap is not interrupt- or thread-safe.
+ *
+ * @see		xpcc::allocator::Tlsf
+ * @ingroup	allocator
+ */
+class TlsfHeap
+{
+public:
+	/// Usage statistics of a heap
+	struct Statistics
+	{
+		/// Bytes currently allocated including the block overhead
+		std::size_t used;
+		/// Maximum value `used` has reached since creation or last reset
+		std::size_t highWaterMark;
+		/// Number of successful allocations
+		uint32_t allocations;
+		/// Number of calls to free()
+		uint32_t deallocations;
+		/// Number of allocations which could not be satisfied
+		uint32_t failedAllocations;
+	};
+
+public:
+	/**
+	 * Create a heap in the given memory region.
+	 *
+	 * @param	memory
+	 * 		Start of the region, must be aligned to `tlsf_align_size()`.
+	 * @param	size
+	 * 		Size of the region in bytes. Must be larger than
+	 * 		`tlsf_size() + tlsf_pool_overhead()`.
+	 */
+	TlsfHeap(void * memory, std::size_t size);
+
+	/**
+	 * Allocate memory
+	 *
+	 * @return	Pointer to the memory or `nullptr` if no memory block large
+	 * 			enough is available.
+	 */
+	void *
+	allocate(std::size_t requestedSize);
+
+	/**
+	 * Free memory in O(1)
+	 *
+	 * @param	ptr
+	 * 		Must be a pointer previously acquired by allocate() on the
+	 * 		same heap or `nullptr`.
+	 */
+	void
+	free(void * ptr);
+
+	/// Returns `true` if `ptr` lies within the memory region of this heap
+	bool
+	contains(const void * ptr) const;
+
+public:
+	inline const Statistics&
+	getStatistics() const
+	{
+		return statistics;
+	}
+
+	/// Set the high water mark to the currently used memory
+	void
+	resetHighWaterMark();
+
+	/// Total number of bytes which can be allocated when the heap is empty
+	std::size_t
+	getTotalSize() const;
+
+	/// Number of free bytes, which might be split into several blocks
+	std::size_t
+	getFreeSize() const;
+
+	/**
+	 * Size of the largest block which can be allocated.
+	 *
+	 * @warning	This walks all blocks of the heap and is therefore
+	 * 			O(n). Don't call it in time critical code.
+	 */
+	std::size_t
+	getLargestFreeBlock() const;
+
+	/**
+	 * External fragmentation in percent.
+	 *
+	 * Calculated as `100 * (1 - largest free block / free bytes)`. A value
+	 * of 0 means all free memory is available as one contiguous block.
+	 *
+	 * @warning	This walks all blocks of the heap and is therefore
+	 * 			O(n). Don't call it in time critical code.
+	 */
+	uint8_t
+	getFragmentation() const;
+
+	/**
+	 * Check the consistency of the internal data structures.
+	 *
+	 * @return	`true` if no error was found.
+	 */
+	bool
+	check() const;
+
+private:
+	TlsfHeap(const TlsfHeap&);
+
+	TlsfHeap&
+	operator = (const TlsfHeap&);
+
+	void * tlsf;
+	const uint8_t * start;
+	const uint8_t * end;
+	std::size_t totalSize;
+
+	Statistics statistics;
+};
+
+/**
+ * TlsfHeap with a statically allocated memory region.
+ *
+ * @tparam	Size	Size of the memory region in bytes, including the
+ * 					TLSF control structure.
+ *
+ * @ingroup	allocator
+ */
+template< std::size_t Size >
+class StaticTlsfHeap : public TlsfHeap
+{
+public:
+	StaticTlsfHeap() :
+		TlsfHeap(memory, Size)
+	{
+	}
+
+private:
+	uint8_t memory[Size] xpcc_aligned(8);
+};
+
+}	// namespace xpcc
+
+#endif	// XPCC__TLSF_HEAP_HPP
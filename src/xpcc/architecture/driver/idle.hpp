@@ -0,0 +1,157 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef	XPCC__IDLE_HPP
+#define	XPCC__IDLE_HPP
+
+#include <stdint.h>
+
+#ifdef __DOXYGEN__
+
+namespace xpcc
+{
+	/**
+	 * \brief	Put the CPU to sleep for at most `ms` milliseconds.
+	 *
+	 * On microcontrollers the CPU is halted until the next interrupt
+	 * (`WFI` on Cortex-M, idle sleep mode on AVR). The interrupt which
+	 * increments xpcc::Clock wakes the CPU at least once per tick, so
+	 * `ms` is only an upper bound and the caller has to check its timers
+	 * again afterwards.
+	 *
+	 * On hosted targets the process is suspended for `ms` milliseconds. If
+	 * the xpcc::VirtualClock is enabled, its time is advanced instead.
+	 *
+	 * \see		xpcc::GenericTimerRegistry::sleep()
+	 * \ingroup	architecture
+	 */
+	void
+	idleFor(uint32_t ms);
+}
+
+#else // !__DOXYGEN__
+
+#include <xpcc/architecture/detect.hpp>
+#include <xpcc/architecture/utils.hpp>
+
+#if defined(XPCC__CPU_AVR)
+
+	#include <avr/sleep.h>
+
+	namespace xpcc
+	{
+		xpcc_always_inline void
+		idleFor(uint32_t /*ms*/)
+		{
+			set_sleep_mode(SLEEP_MODE_IDLE);
+			sleep_mode();
+		}
+	}
+
+#elif defined(XPCC__OS_LINUX)
+
+	#include <time.h>
+	#include <xpcc/architecture/driver/virtual_clock/virtual_clock.hpp>
+
+	namespace xpcc
+	{
+		inline void
+		idleFor(uint32_t ms)
+		{
+			if (VirtualClock::isEnabled())
+			{
+				// simulated time passes instantly
+				VirtualClock::advance(ms);
+				return;
+			}
+
+			struct timespec time;
+			time.tv_sec = ms / 1000;
+			time.tv_nsec = (ms % 1000) * 1000000L;
+
+			// CLOCK_MONOTONIC is not affected by changes of the system time
+			clock_nanosleep(CLOCK_MONOTONIC, 0, &time, 0);
+		}
+	}
+
+#elif defined(XPCC__OS_UNIX) || defined(XPCC__OS_OSX)
+
+	#include <time.h>
+	#include <xpcc/architecture/driver/virtual_clock/virtual_clock.hpp>
+
+	namespace xpcc
+	{
+		inline void
+		idleFor(uint32_t ms)
+		{
+			if (VirtualClock::isEnabled())
+			{
+				// simulated time passes instantly
+				VirtualClock::advance(ms);
+				return;
+			}
+
+			struct timespec time;
+			time.tv_sec = ms / 1000;
+			time.tv_nsec = (ms % 1000) * 1000000L;
+
+			nanosleep(&time, 0);
+		}
+	}
+
+#elif defined(XPCC__OS_WIN32)
+
+	#include <windows.h>
+	#include <xpcc/architecture/driver/virtual_clock/virtual_clock.hpp>
+
+	namespace xpcc
+	{
+		inline void
+		idleFor(uint32_t ms)
+		{
+			if (VirtualClock::isEnabled())
+			{
+				// simulated time passes instantly
+				VirtualClock::advance(ms);
+				return;
+			}
+
+			Sleep(ms);
+		}
+	}
+
+#elif defined(XPCC__CPU_CORTEX_M0) || defined(XPCC__CPU_CORTEX_M3) || defined(XPCC__CPU_CORTEX_M4) || defined(XPCC__CPU_CORTEX_M7)
+
+	namespace xpcc
+	{
+		xpcc_always_inline void
+		idleFor(uint32_t /*ms*/)
+		{
+			// woken up by the SysTick interrupt at the latest
+			asm volatile ("wfi");
+		}
+	}
+
+#elif defined(XPCC__CPU_ARM)
+
+	namespace xpcc
+	{
+		xpcc_always_inline void
+		idleFor(uint32_t /*ms*/)
+		{
+			// no sleep mode implemented, return immediately
+		}
+	}
+
+#else
+	#error "Unknown architecture, please add a specific idle function!"
+#endif
+
+#endif	// !__DOXYGEN__
+#endif	// XPCC__IDLE_HPP
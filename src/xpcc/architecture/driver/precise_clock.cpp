@@ -0,0 +1,87 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/architecture/detect.hpp>
+
+#include "precise_clock.hpp"
+#include "clock.hpp"
+#include "xpcc_config.hpp"
+
+#if (XPCC__CLOCK_TESTMODE == 1)
+
+	xpcc::PreciseClock::Type xpcc::PreciseClock::time = 0;
+
+	template< typename TimestampType >
+	TimestampType
+	xpcc::PreciseClock::now()
+	{
+		return TimestampType(time);
+	}
+
+#elif ( defined(XPCC__OS_UNIX) || defined(XPCC__OS_OSX) )
+#	include <time.h>
+#	include "virtual_clock/virtual_clock.hpp"
+
+	template< typename TimestampType >
+	TimestampType
+	xpcc::PreciseClock::now()
+	{
+		if (VirtualClock::isEnabled()) {
+			return TimestampType(VirtualClock::nowPrecise().getTime());
+		}
+
+		struct timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+
+		return TimestampType( now.tv_sec*1000000 + now.tv_nsec/1000 );
+	}
+
+#elif defined(XPCC__OS_WIN32) || defined(XPCC__OS_WIN64)
+#	include <windows.h>
+#	include "virtual_clock/virtual_clock.hpp"
+
+	template< typename TimestampType >
+	TimestampType
+	xpcc::PreciseClock::now()
+	{
+		if (VirtualClock::isEnabled()) {
+			return TimestampType(VirtualClock::nowPrecise().getTime());
+		}
+
+		LARGE_INTEGER frequency;
+		LARGE_INTEGER now;
+		QueryPerformanceFrequency(&frequency);
+		QueryPerformanceCounter(&now);
+
+		return TimestampType( (now.QuadPart * 1000000) / frequency.QuadPart );
+	}
+
+#elif defined(XPCC__CPU_CORTEX_M0) || defined(XPCC__CPU_CORTEX_M3) || defined(XPCC__CPU_CORTEX_M4) || defined(XPCC__CPU_CORTEX_M7)
+
+	// implemented together with the SysTick timer in
+	// `architecture/platform/driver/core/cortex/systick/systick_timer.cpp.in`
+
+#elif defined(XPCC__CPU_AVR) || defined(XPCC__CPU_ARM) || defined(XPCC__CPU_AVR32)
+
+	template< typename TimestampType >
+	TimestampType
+	xpcc::PreciseClock::now()
+	{
+		// no sub-millisecond time source available
+		return TimestampType(xpcc::Clock::now().getTime() * 1000);
+	}
+
+#else
+#	error	"Don't know how to create a PreciseTimestamp for this target!"
+#endif
+
+#if !(defined(XPCC__CPU_CORTEX_M0) || defined(XPCC__CPU_CORTEX_M3) || defined(XPCC__CPU_CORTEX_M4) || defined(XPCC__CPU_CORTEX_M7)) || (XPCC__CLOCK_TESTMODE == 1)
+// explicit declaration of what member function templates we need to generate
+template xpcc::PreciseTimestamp xpcc::PreciseClock::now();
+#endif
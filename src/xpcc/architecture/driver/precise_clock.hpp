@@ -0,0 +1,61 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef	XPCC_PRECISE_CLOCK_HPP
+#define	XPCC_PRECISE_CLOCK_HPP
+
+#include <xpcc/architecture/utils.hpp>
+#include <xpcc/processing/timer/timestamp.hpp>
+
+namespace xpcc
+{
+
+/**
+ * Monotonic system timer with microsecond resolution
+ *
+ * Used by xpcc::PreciseTimeout and xpcc::PrecisePeriodicTimer for control
+ * loops, where the millisecond resolution of xpcc::Clock causes too much
+ * jitter.
+ *
+ * On Linux and other Unix-OS this class uses `clock_gettime()` with
+ * `CLOCK_MONOTONIC`, which is not affected by changes of the system time.
+ *
+ * For Cortex-M targets the current value of the SysTick timer is combined
+ * with xpcc::Clock, so the `xpcc::SysTick` timer has to be enabled.
+ *
+ * All other targets only provide the time of xpcc::Clock converted to
+ * microseconds.
+ *
+ * The 32bit timestamp overflows after about 71 minutes, so timeouts are
+ * limited to about 35 minutes.
+ *
+ * @ingroup	architecture
+ */
+class PreciseClock
+{
+public:
+	typedef uint32_t Type;
+
+public:
+	/**
+	 * Get the current time in microseconds
+	 *
+	 * Provides an atomic access to the current time
+	 */
+	template< typename TimestampType = PreciseTimestamp >
+	static TimestampType
+	now();
+
+protected:
+	static Type time;
+};
+
+}	// namespace xpcc
+
+#endif	// XPCC_PRECISE_CLOCK_HPP
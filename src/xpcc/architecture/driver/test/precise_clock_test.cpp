@@ -0,0 +1,84 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/processing/timer.hpp>
+
+#include "precise_clock_test.hpp"
+
+/**
+ * Gain full access to xpcc::PreciseClock
+ *
+ * Only useful if the define XPCC__CLOCK_TESTMODE is set to 1.
+ */
+class TestingPreciseClock : public xpcc::PreciseClock
+{
+public:
+	// expose protected members
+	using xpcc::PreciseClock::time;
+};
+
+// ----------------------------------------------------------------------------
+void
+PreciseClockTest::testClock()
+{
+	TestingPreciseClock::time = 0;
+	TEST_ASSERT_EQUALS(xpcc::PreciseClock::now(), xpcc::PreciseTimestamp(0));
+
+	TestingPreciseClock::time = 1500;
+	TEST_ASSERT_EQUALS(xpcc::PreciseClock::now(), xpcc::PreciseTimestamp(1500));
+
+	TestingPreciseClock::time = 4294967295;
+	TEST_ASSERT_EQUALS(xpcc::PreciseClock::now(), xpcc::PreciseTimestamp(4294967295));
+}
+
+void
+PreciseClockTest::testPreciseTimeout()
+{
+	TestingPreciseClock::time = 1000;
+
+	xpcc::PreciseTimeout timeout(250);
+	TEST_ASSERT_EQUALS(timeout.remaining(), 250);
+
+	TestingPreciseClock::time = 1249;
+	TEST_ASSERT_FALSE(timeout.execute());
+	TEST_ASSERT_EQUALS(timeout.remaining(), 1);
+
+	TestingPreciseClock::time = 1250;
+	TEST_ASSERT_TRUE(timeout.execute());
+	TEST_ASSERT_FALSE(timeout.execute());
+
+	// overflow of the microsecond counter
+	TestingPreciseClock::time = 4294967000U;
+	timeout.restart(500);
+
+	TestingPreciseClock::time = 100;
+	TEST_ASSERT_FALSE(timeout.execute());
+
+	TestingPreciseClock::time = 204;
+	TEST_ASSERT_TRUE(timeout.execute());
+}
+
+void
+PreciseClockTest::testPrecisePeriodicTimer()
+{
+	TestingPreciseClock::time = 0;
+
+	// 4 kHz control loop
+	xpcc::PrecisePeriodicTimer timer(250);
+
+	uint8_t count = 0;
+	for (uint32_t time = 0; time < 10000; time += 10)
+	{
+		TestingPreciseClock::time = time;
+		if (timer.execute()) {
+			count++;
+		}
+	}
+	TEST_ASSERT_EQUALS(count, 39);
+}
@@ -0,0 +1,28 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef PRECISE_CLOCK_TEST_HPP
+#define PRECISE_CLOCK_TEST_HPP
+
+#include <unittest/testsuite.hpp>
+
+class PreciseClockTest : public unittest::TestSuite
+{
+public:
+	void
+	testClock();
+
+	void
+	testPreciseTimeout();
+
+	void
+	testPrecisePeriodicTimer();
+};
+
+#endif
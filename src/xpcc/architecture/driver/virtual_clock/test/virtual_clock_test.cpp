@@ -0,0 +1,112 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/architecture/driver/virtual_clock/virtual_clock.hpp>
+#include <xpcc/processing/timer.hpp>
+
+#include "virtual_clock_test.hpp"
+
+typedef xpcc::GenericTimeout<xpcc::VirtualClock, xpcc::Timestamp> Timeout;
+typedef xpcc::GenericPeriodicTimer<xpcc::VirtualClock, xpcc::Timestamp> PeriodicTimer;
+
+// ----------------------------------------------------------------------------
+void
+VirtualClockTest::tearDown()
+{
+	xpcc::VirtualClock::disable();
+}
+
+void
+VirtualClockTest::testTime()
+{
+	TEST_ASSERT_FALSE(xpcc::VirtualClock::isEnabled());
+
+	xpcc::VirtualClock::enable(100);
+	TEST_ASSERT_TRUE(xpcc::VirtualClock::isEnabled());
+	TEST_ASSERT_EQUALS(xpcc::VirtualClock::now(), xpcc::Timestamp(100));
+	TEST_ASSERT_EQUALS(xpcc::VirtualClock::nowPrecise(), xpcc::PreciseTimestamp(100000));
+
+	xpcc::VirtualClock::advance(50);
+	TEST_ASSERT_EQUALS(xpcc::VirtualClock::now(), xpcc::Timestamp(150));
+
+	xpcc::VirtualClock::advanceMicroseconds(999);
+	TEST_ASSERT_EQUALS(xpcc::VirtualClock::now(), xpcc::Timestamp(150));
+	TEST_ASSERT_EQUALS(xpcc::VirtualClock::nowPrecise(), xpcc::PreciseTimestamp(150999));
+
+	xpcc::VirtualClock::advanceMicroseconds(1);
+	TEST_ASSERT_EQUALS(xpcc::VirtualClock::now(), xpcc::Timestamp(151));
+
+	xpcc::VirtualClock::setTime(65536 + 10);
+	TEST_ASSERT_EQUALS(xpcc::VirtualClock::nowShort(), xpcc::ShortTimestamp(10));
+
+	xpcc::VirtualClock::disable();
+	TEST_ASSERT_FALSE(xpcc::VirtualClock::isEnabled());
+}
+
+void
+VirtualClockTest::testIdle()
+{
+	xpcc::VirtualClock::enable();
+
+	// one simulated hour must not take one hour
+	for (uint16_t i = 0; i < 3600; ++i) {
+		xpcc::idleFor(1000);
+	}
+	TEST_ASSERT_EQUALS(xpcc::VirtualClock::now(), xpcc::Timestamp(3600000));
+}
+
+void
+VirtualClockTest::testTimeout()
+{
+	xpcc::VirtualClock::enable();
+
+	Timeout timeout(500);
+	TEST_ASSERT_FALSE(timeout.execute());
+
+	xpcc::VirtualClock::advance(499);
+	TEST_ASSERT_FALSE(timeout.execute());
+	TEST_ASSERT_EQUALS(timeout.remaining(), 1);
+
+	xpcc::VirtualClock::advance(1);
+	TEST_ASSERT_TRUE(timeout.execute());
+}
+
+void
+VirtualClockTest::testJumpToDeadline()
+{
+	xpcc::VirtualClock::enable();
+
+	PeriodicTimer fast(30);
+	PeriodicTimer slow(700);
+
+	xpcc::GenericTimerRegistry<xpcc::VirtualClock, xpcc::Timestamp, 2> registry;
+	registry.join(fast);
+	registry.join(slow);
+
+	uint16_t iterations = 0;
+	uint16_t fastCount = 0;
+	uint16_t slowCount = 0;
+	while (xpcc::VirtualClock::now() < xpcc::Timestamp(2100))
+	{
+		if (fast.execute()) {
+			fastCount++;
+		}
+		if (slow.execute()) {
+			slowCount++;
+		}
+		registry.sleep(1000);
+		iterations++;
+	}
+
+	TEST_ASSERT_EQUALS(fastCount, 69);
+	TEST_ASSERT_EQUALS(slowCount, 2);
+	// every iteration ends at a deadline, no time is wasted in between:
+	// the first one and one per deadline before 2100ms (69 + 2)
+	TEST_ASSERT_EQUALS(iterations, 72);
+}
@@ -0,0 +1,45 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include "virtual_clock.hpp"
+
+std::atomic<bool> xpcc::VirtualClock::enabled(false);
+std::atomic<uint64_t> xpcc::VirtualClock::microseconds(0);
+
+// ----------------------------------------------------------------------------
+void
+xpcc::VirtualClock::enable(Type milliseconds)
+{
+	setTime(milliseconds);
+	enabled = true;
+}
+
+void
+xpcc::VirtualClock::disable()
+{
+	enabled = false;
+}
+
+void
+xpcc::VirtualClock::setTime(Type milliseconds)
+{
+	microseconds = uint64_t(milliseconds) * 1000;
+}
+
+void
+xpcc::VirtualClock::advance(Type milliseconds)
+{
+	microseconds += uint64_t(milliseconds) * 1000;
+}
+
+void
+xpcc::VirtualClock::advanceMicroseconds(Type time)
+{
+	microseconds += time;
+}
@@ -0,0 +1,117 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef	XPCC_VIRTUAL_CLOCK_HPP
+#define	XPCC_VIRTUAL_CLOCK_HPP
+
+#include <stdint.h>
+#include <atomic>
+
+#include <xpcc/processing/timer/timestamp.hpp>
+
+namespace xpcc
+{
+
+/**
+ * Simulated time for hosted tests
+ *
+ * While enabled, xpcc::Clock and xpcc::PreciseClock return the simulated
+ * time instead of the real time, and xpcc::idleFor() advances the
+ * simulated time instead of sleeping. Time only passes when the test
+ * harness advances it, so timeouts, retries of the xpcc::Dispatcher and
+ * resumable functions behave deterministically and run as fast as the
+ * CPU allows.
+ *
+ * A main loop which sleeps with a timer registry jumps directly to the
+ * next deadline:
+ *
+ * @code
+ * xpcc::VirtualClock::enable();
+ *
+ * xpcc::TimerRegistry<4> registry;
+ * registry.join(timeout);
+ *
+ * // simulate one hour
+ * while (xpcc::VirtualClock::now() < xpcc::Timestamp(3600000))
+ * {
+ *     dispatcher.update();
+ *     ...
+ *     // advances the time to the next deadline, but at most 10ms
+ *     registry.sleep(10);
+ * }
+ *
+ * xpcc::VirtualClock::disable();
+ * @endcode
+ *
+ * The class can also be used directly as clock parameter of the generic
+ * timer classes, e.g. `xpcc::GenericTimeout<xpcc::VirtualClock>`.
+ *
+ * Only available on hosted targets. If XPCC__CLOCK_TESTMODE is set,
+ * xpcc::Clock is controlled by the test mode instead.
+ *
+ * @ingroup	architecture
+ */
+class VirtualClock
+{
+public:
+	typedef uint32_t Type;
+
+public:
+	/// Switch to the simulated time, starting at `milliseconds`
+	static void
+	enable(Type milliseconds = 0);
+
+	/// Switch back to the real time
+	static void
+	disable();
+
+	static inline bool
+	isEnabled()
+	{
+		return enabled.load(std::memory_order_relaxed);
+	}
+
+	/// Current simulated time in milliseconds
+	template< typename TimestampType = Timestamp >
+	static inline TimestampType
+	now()
+	{
+		return TimestampType(microseconds.load() / 1000);
+	}
+
+	static inline ShortTimestamp
+	nowShort()
+	{
+		return now<ShortTimestamp>();
+	}
+
+	/// Current simulated time in microseconds
+	static inline PreciseTimestamp
+	nowPrecise()
+	{
+		return PreciseTimestamp(microseconds.load());
+	}
+
+	static void
+	setTime(Type milliseconds);
+
+	static void
+	advance(Type milliseconds);
+
+	static void
+	advanceMicroseconds(Type microseconds);
+
+private:
+	static std::atomic<bool> enabled;
+	static std::atomic<uint64_t> microseconds;
+};
+
+}	// namespace xpcc
+
+#endif	// XPCC_VIRTUAL_CLOCK_HPP
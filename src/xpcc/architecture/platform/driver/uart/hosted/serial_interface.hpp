@@ -130,6 +130,13 @@ namespace xpcc
 			virtual bool
 			read(char& c);
 
+			/**
+			 * Read the bytes which are available, without waiting.
+			 *
+			 * @return	Number of bytes read, maximal `length`
+			 */
+			virtual std::size_t
+			read(uint8_t* data, std::size_t length);
 
 			/**
 			 * Read length bytes from device.
@@ -149,6 +156,14 @@ namespace xpcc
 			virtual void
 			write(const char* str);
 
+			/// Write a block of bytes with as few system calls as possible
+			virtual void
+			write(const uint8_t* data, std::size_t length);
+
+			/// Write all segments with `writev()`
+			virtual void
+			writeSegments(const Segment* segments, std::size_t count);
+
 			/**
 			 * Write length bytes to device.
 			 */
@@ -8,11 +8,25 @@
 // ----------------------------------------------------------------------------
 
 #include "serial_port.hpp"
+
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
+#include <boost/array.hpp>
+#include <boost/bind.hpp>
+
 xpcc::hosted::SerialPort::SerialPort():
 	shutdown(true),
-	port(io_service)
+	baudRate(0),
+	writeBuffer(BufferSize),
+	writeHead(0), writeTail(0), writeSending(0),
+	writeActive(false), closeRequested(false),
+	readBuffer(BufferSize),
+	readHead(0), readTail(0), readActive(false),
+	port(io_service),
+	work(0),
+	thread(0)
 {
 }
 
@@ -21,42 +35,183 @@ xpcc::hosted::SerialPort::~SerialPort()
 	this->close();
 }
 
+// ----------------------------------------------------------------------------
 void
 xpcc::hosted::SerialPort::write(char c)
 {
-	this->io_service.post(boost::bind(&xpcc::hosted::SerialPort::doWrite, this, c));
+	this->write(reinterpret_cast<const uint8_t *>(&c), 1);
 }
 
+void
+xpcc::hosted::SerialPort::write(const uint8_t *data, std::size_t length)
+{
+	while (length > 0)
+	{
+		MutexGuard guard(this->writeMutex);
+		while (!this->shutdown && (this->writeHead - this->writeTail) == BufferSize) {
+			this->writeCondition.wait(guard);
+		}
+		if (this->shutdown) {
+			// port is closed, data is discarded
+			return;
+		}
+
+		// copy as much as fits, up to two parts if it wraps around
+		std::size_t count = std::min(length, BufferSize - (this->writeHead - this->writeTail));
+		const std::size_t index = this->writeHead % BufferSize;
+		const std::size_t first = std::min(count, BufferSize - index);
+		std::memcpy(&this->writeBuffer[index], data, first);
+		std::memcpy(&this->writeBuffer[0], data + first, count - first);
+		this->writeHead += count;
+		data += count;
+		length -= count;
+
+		if (!this->writeActive)
+		{
+			this->writeActive = true;
+			this->io_service.post(boost::bind(&xpcc::hosted::SerialPort::writeStart, this));
+		}
+	}
+}
 
 void
 xpcc::hosted::SerialPort::flush()
 {
+	MutexGuard guard(this->writeMutex);
+	while (!this->shutdown && this->writeActive) {
+		this->writeCondition.wait(guard);
+	}
+}
+
+void
+xpcc::hosted::SerialPort::writeStart()
+{
+	MutexGuard guard(this->writeMutex);
+
+	const std::size_t length = this->writeHead - this->writeTail;
+	if (length == 0 || this->shutdown)
+	{
+		this->writeActive = false;
+		this->writeCondition.notify_all();
+		if (this->closeRequested)
+		{
+			guard.unlock();
+			this->doAbort(boost::system::error_code());
+		}
+		return;
+	}
+
+	// all pending data with a single write, the second buffer is
+	// empty unless the data wraps around
+	const std::size_t index = this->writeTail % BufferSize;
+	const std::size_t first = std::min(length, BufferSize - index);
+	boost::array<boost::asio::const_buffer, 2> buffers = {{
+		boost::asio::buffer(&this->writeBuffer[index], first),
+		boost::asio::buffer(&this->writeBuffer[0], length - first) }};
+
+	this->writeSending = length;
+	boost::asio::async_write(this->port, buffers,
+			boost::bind(&xpcc::hosted::SerialPort::writeComplete, this,
+					boost::asio::placeholders::error,
+					boost::asio::placeholders::bytes_transferred));
+}
+
+void
+xpcc::hosted::SerialPort::writeComplete(const boost::system::error_code& error,
+		std::size_t bytes_transferred)
+{
+	if (error)
+	{
+		if (error != boost::asio::error::operation_aborted) {
+			std::cerr << "Error in write: " << error.message() << std::endl;
+			this->doAbort(error);
+		}
+		return;
+	}
+
+	{
+		MutexGuard guard(this->writeMutex);
+		this->writeTail += bytes_transferred;
+		this->writeSending = 0;
+		this->writeCondition.notify_all();
+	}
+	this->writeStart();
+}
+
+// ----------------------------------------------------------------------------
+bool
+xpcc::hosted::SerialPort::read(char& value)
+{
+	return (this->read(reinterpret_cast<uint8_t *>(&value), 1) == 1);
+}
+
+std::size_t
+xpcc::hosted::SerialPort::read(uint8_t *data, std::size_t length)
+{
+	MutexGuard guard(this->readMutex);
+
+	const std::size_t count = std::min(length, this->readHead - this->readTail);
+	const std::size_t index = this->readTail % BufferSize;
+	const std::size_t first = std::min(count, BufferSize - index);
+	std::memcpy(data, &this->readBuffer[index], first);
+	std::memcpy(data + first, &this->readBuffer[0], count - first);
+	this->readTail += count;
+
+	// continue reading if it was paused because the buffer was full
+	if (count > 0 && !this->readActive && !this->shutdown)
+	{
+		this->readActive = true;
+		this->io_service.post(boost::bind(&xpcc::hosted::SerialPort::readStart, this));
+	}
+	return count;
 }
 
 void
 xpcc::hosted::SerialPort::readStart()
 {
-	port.async_read_some(boost::asio::buffer(&this->tmpRead, sizeof(this->tmpRead)),
+	MutexGuard guard(this->readMutex);
+
+	const std::size_t free = BufferSize - (this->readHead - this->readTail);
+	if (free == 0 || this->shutdown)
+	{
+		// paused until read() makes room
+		this->readActive = false;
+		return;
+	}
+
+	// read directly into the contiguous free space
+	const std::size_t index = this->readHead % BufferSize;
+	const std::size_t length = std::min(free, BufferSize - index);
+
+	this->readActive = true;
+	this->port.async_read_some(boost::asio::buffer(&this->readBuffer[index], length),
 			boost::bind(&xpcc::hosted::SerialPort::readComplete,
 					this,
 					boost::asio::placeholders::error,
 					boost::asio::placeholders::bytes_transferred));
 }
 
-bool
-xpcc::hosted::SerialPort::read(char& value)
+void
+xpcc::hosted::SerialPort::readComplete(const boost::system::error_code& error,
+		std::size_t bytes_transferred)
 {
-	if(this->readBuffer.empty())
-		return false;
-	else
+	if (error)
+	{
+		if (error != boost::asio::error::operation_aborted) {
+			std::cerr << "Error in read: " << error.message() << std::endl;
+			this->doAbort(error);
+		}
+		return;
+	}
+
 	{
-		MutexGuard queueGuard( this->readMutex);
-		value=this->readBuffer.front();
-		this->readBuffer.pop();
-		return true;
+		MutexGuard guard(this->readMutex);
+		this->readHead += bytes_transferred;
 	}
+	this->readStart();
 }
 
+// ----------------------------------------------------------------------------
 bool
 xpcc::hosted::SerialPort::open(std::string deviceName, unsigned int baudRate)
 {
@@ -65,11 +220,9 @@ xpcc::hosted::SerialPort::open(std::string deviceName, unsigned int baudRate)
 		this->deviceName = deviceName;
 		this->baudRate = baudRate;
 
-		//std::cout << "open port" << std::endl;
-
-		this->shutdown = false;
-		this->port.open(this->deviceName);
-		if (!this->port.is_open()) {
+		boost::system::error_code error;
+		this->port.open(this->deviceName, error);
+		if (error || !this->port.is_open()) {
 			std::cerr << "Failed to open serial port " << deviceName << "\n";
 			return false;
 		}
@@ -80,8 +233,24 @@ xpcc::hosted::SerialPort::open(std::string deviceName, unsigned int baudRate)
 		this->port.set_option(boost::asio::serial_port_base::character_size(8));
 		this->port.set_option(boost::asio::serial_port_base::stop_bits(boost::asio::serial_port_base::stop_bits::one));
 
+		{
+			MutexGuard guard(this->writeMutex);
+			this->writeHead = this->writeTail = 0;
+			this->writeSending = 0;
+			this->writeActive = false;
+			this->closeRequested = false;
+		}
+		{
+			MutexGuard guard(this->readMutex);
+			this->readHead = this->readTail = 0;
+			this->readActive = true;
+		}
+		this->shutdown = false;
+
 		this->io_service.post(boost::bind(&SerialPort::readStart, this));
 
+		// keeps the thread running while reading is paused
+		this->work = new boost::asio::io_service::work(this->io_service);
 		this->thread = new boost::thread(boost::bind(&boost::asio::io_service::run, &this->io_service));
 	}
 	else {
@@ -91,7 +260,6 @@ xpcc::hosted::SerialPort::open(std::string deviceName, unsigned int baudRate)
 	return true;
 }
 
-
 bool
 xpcc::hosted::SerialPort::isOpen()
 {
@@ -101,136 +269,93 @@ xpcc::hosted::SerialPort::isOpen()
 void
 xpcc::hosted::SerialPort::close()
 {
-	if (!this->isOpen())
+	if (this->thread == 0)
 		return;
 
-	this->io_service.post(boost::bind(
-			&xpcc::hosted::SerialPort::doClose,
-			this,
-			boost::system::error_code()));
-
-	this->thread->join();
-	delete this->thread;
-	this->io_service.reset();
+	{
+		MutexGuard guard(this->writeMutex);
+		this->closeRequested = true;
+	}
+	this->io_service.post(boost::bind(&xpcc::hosted::SerialPort::doClose, this));
+	this->stopThread();
 }
 
 void
 xpcc::hosted::SerialPort::kill()
 {
-	if (!this->isOpen())
+	if (this->thread == 0)
 		return;
 
 	this->io_service.post(boost::bind(
 				&xpcc::hosted::SerialPort::doAbort,
 				this,
 				boost::system::error_code()));
-	this->shutdown = true;
-	this->thread->join();
-	delete this->thread;
-	this->io_service.reset();
+	this->stopThread();
 }
 
 void
-xpcc::hosted::SerialPort::doAbort(const boost::system::error_code& error)
+xpcc::hosted::SerialPort::stopThread()
 {
+	this->thread->join();
+	delete this->thread;
+	this->thread = 0;
 
-	if (error)
-		std::cerr << "Error: " << error.message() << std::endl;
-	this->port.close();
-	if (error)
-		std::cerr << "Error: " << error.message() << std::endl;
+	delete this->work;
+	this->work = 0;
+	this->io_service.reset();
 }
 
 void
-xpcc::hosted::SerialPort::doClose(const boost::system::error_code& error)
+xpcc::hosted::SerialPort::doClose()
 {
-	if( this->writeBuffer.empty() ) {
-		this->doAbort(error);
-	}
-	this->shutdown = true;
-}
-
-void
-xpcc::hosted::SerialPort::doWrite(const char c) {
-	if (!this->shutdown)
+	bool idle;
 	{
-		std::cout<<"get 0x"<< std::hex << (int) c << std::dec
-		<< "(" << c << ")" << std::endl;
-
-		MutexGuard mutex(this->writeMutex);
-		bool idle = this->writeBuffer.empty();
-		this->writeBuffer.push(c);
+		MutexGuard guard(this->writeMutex);
+		idle = !this->writeActive;
+	}
 
-		if (idle) {
-			this->writeStart();
-		}
+	// otherwise closed by writeStart() after all data is sent
+	if (idle) {
+		this->doAbort(boost::system::error_code());
 	}
 }
 
 void
-xpcc::hosted::SerialPort::writeStart(void)
+xpcc::hosted::SerialPort::doAbort(const boost::system::error_code& error)
 {
-	boost::asio::async_write(this->port,
-			boost::asio::buffer(&this->writeBuffer.front(), 1),
-			boost::bind(&xpcc::hosted::SerialPort::writeComplete, this,
-					boost::asio::placeholders::error));
-}
+	if (error)
+		std::cerr << "Error: " << error.message() << std::endl;
 
-void
-xpcc::hosted::SerialPort::writeComplete(const boost::system::error_code& error)
-{
-	if (!error) {
-		MutexGuard mutex(this->writeMutex);
-		this->writeBuffer.pop();
-		if (!this->writeBuffer.empty()) {
-			std::cout << "restart " << this->writeBuffer.size() << std::endl;
-			this->writeStart();
-		}
-		else if (this->shutdown) {
-			this->doAbort(error);
-		}
-	}
-	else {
-		std::cerr << "Error in write: " << error.message() << std::endl;
-		this->doAbort(error);
+	{
+		MutexGuard guard(this->writeMutex);
+		this->shutdown = true;
+		this->writeCondition.notify_all();
 	}
-}
 
-void
-xpcc::hosted::SerialPort::readComplete(const boost::system::error_code& error, size_t bytes_transferred)
-{
-    if (!error)
-    {
-    	{
-			MutexGuard queueGuard( this->readMutex);
-			for(unsigned int i=0; i<bytes_transferred; ++i)
-			{
-				std::cout<<"get 0x"<< std::hex << (int) this->tmpRead[i] << std::dec
-				<< "(" << this->tmpRead[i] << ")" << std::endl;
-				this->readBuffer.push(this->tmpRead[i]);
-			}
-    	}
-        this->readStart();
-    }
-    else
-    {
-		doClose(error);
-    }
+	boost::system::error_code ignored;
+	this->port.close(ignored);
+	this->io_service.stop();
 }
 
+// ----------------------------------------------------------------------------
 void
 xpcc::hosted::SerialPort::clearReadBuffer()
 {
-	MutexGuard queueGuard( this->readMutex);
-	while(!this->readBuffer.empty()) {
-		this->readBuffer.pop();
+	MutexGuard guard(this->readMutex);
+	this->readTail = this->readHead;
+
+	if (!this->readActive && !this->shutdown)
+	{
+		this->readActive = true;
+		this->io_service.post(boost::bind(&xpcc::hosted::SerialPort::readStart, this));
 	}
 }
 
 void
 xpcc::hosted::SerialPort::clearWriteBuffer()
 {
-	while(!this->writeBuffer.empty()) {
-		this->writeBuffer.pop();
-	}
+	// the data of the active write can't be removed anymore
+	MutexGuard guard(this->writeMutex);
+	this->writeHead = this->writeTail + this->writeSending;
+	this->writeCondition.notify_all();
 }
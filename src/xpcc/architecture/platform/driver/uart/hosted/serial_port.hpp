@@ -31,11 +31,12 @@
 #ifndef XPCC_HOSTED_SERIAL_PORT_HPP
 #define XPCC_HOSTED_SERIAL_PORT_HPP
 
+#include <atomic>
 #include <string>
-#include <queue>
+#include <vector>
 #include <boost/asio.hpp>
-#include <boost/bind.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <boost/thread.hpp>
 
 #include <xpcc/io/iodevice.hpp>
@@ -49,36 +50,60 @@ namespace xpcc
 		 *
 		 * Port is closed right after construction.
 		 *
+		 * Written data is collected in a ring buffer and sent by a
+		 * background thread, all data pending at the start of a transfer
+		 * is handed to the operating system at once. Received data is
+		 * read directly into a second ring buffer. Both buffers are
+		 * large enough to keep USB-serial adapters running at several
+		 * MBaud busy.
+		 *
+		 * write() only blocks if the transmit buffer is full, flush()
+		 * waits until all data is sent. read() never blocks. If the
+		 * receive buffer is full, reading from the port pauses until
+		 * read() makes room again, so no data is lost.
+		 *
 		 * \ingroup	linux
 		 */
-		class SerialPort : IODevice
+		class SerialPort : public IODevice
 		{
 		public :
+			/// Size of the transmit and receive buffer in bytes
+			static constexpr std::size_t BufferSize = 1 << 16;
 
 			SerialPort();
 
 			~SerialPort();
 
 			using IODevice::write;
+			using IODevice::read;
 
 			virtual void
 			write(char c);
 
+			virtual void
+			write(const uint8_t *data, std::size_t length);
+
+			/// Wait until all data is sent
 			virtual void
 			flush();
 
 			virtual bool
 			read(char& value);
 
+			virtual std::size_t
+			read(uint8_t *data, std::size_t length);
+
 			virtual bool
 			open( std::string deviceName, unsigned int baudRate );
 
 			virtual bool
 			isOpen();
 
+			/// Close the port after all data is sent
 			virtual void
 			close();
 
+			/// Close the port immediately
 			void
 			kill();
 
@@ -92,40 +117,52 @@ namespace xpcc
 			typedef boost::mutex				Mutex;
 			typedef boost::mutex::scoped_lock	MutexGuard;
 
-			bool shutdown;
-			std::string deviceName;
-			unsigned int baudRate;
-			Mutex readMutex;
-			Mutex writeMutex;
+			void
+			readStart();
 
-			char tmpRead[512];
-			std::queue<char> writeBuffer;
-			std::queue<char> readBuffer;
+			void
+			readComplete(const boost::system::error_code& error, std::size_t bytes_transferred);
 
-			boost::asio::io_service  io_service;
-			boost::asio::serial_port port;
-			boost::thread* 			 thread;
+			void
+			writeStart();
 
 			void
-			readStart();
+			writeComplete(const boost::system::error_code& error, std::size_t bytes_transferred);
 
-	        void
-	        doClose(const boost::system::error_code& error);
+			void
+			doClose();
 
-	        void
-	        doAbort(const boost::system::error_code& error);
+			void
+			doAbort(const boost::system::error_code& error);
 
-	        void
-	        doWrite(const char c);
+			void
+			stopThread();
+
+			std::atomic<bool> shutdown;
+			std::string deviceName;
+			unsigned int baudRate;
 
-	        void
-	        writeStart(void);
+			// ring buffers with free-running positions, the index is
+			// (position % BufferSize)
+			Mutex writeMutex;
+			boost::condition_variable writeCondition;
+			std::vector<uint8_t> writeBuffer;
+			std::size_t writeHead;
+			std::size_t writeTail;
+			std::size_t writeSending;	///< length of the active async_write
+			bool writeActive;		///< an async_write is in progress or posted
+			bool closeRequested;	///< close after all data is sent
 
-	        void
-	        writeComplete(const boost::system::error_code& error);
+			Mutex readMutex;
+			std::vector<uint8_t> readBuffer;
+			std::size_t readHead;
+			std::size_t readTail;
+			bool readActive;		///< an async_read_some is in progress or posted
 
-			void
-			readComplete(const boost::system::error_code& error, size_t bytes_transferred);
+			boost::asio::io_service  io_service;
+			boost::asio::serial_port port;
+			boost::asio::io_service::work* work;
+			boost::thread* 			 thread;
 		};
 	}
 }
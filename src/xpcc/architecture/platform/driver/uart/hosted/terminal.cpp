@@ -45,6 +45,12 @@ xpcc::pc::Terminal::write(const char* s)
 	std::cout << s;
 }
 
+void
+xpcc::pc::Terminal::write(const uint8_t* data, std::size_t length)
+{
+	std::cout.write(reinterpret_cast<const char*>(data), length);
+}
+
 void
 xpcc::pc::Terminal::flush()
 {
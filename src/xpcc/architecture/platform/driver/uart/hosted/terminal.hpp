@@ -53,11 +53,16 @@ namespace xpcc
 			virtual void
 			write(const char* s);
 			
+			virtual void
+			write(const uint8_t* data, std::size_t length);
+			
 			virtual void
 			flush();
 			
 			virtual bool
 			read(char& value);
+			
+			using IODevice::read;
 		};
 	}
 }
@@ -13,12 +13,14 @@
 #include <ios>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #include <fcntl.h>		// file control
 #include <sys/ioctl.h>	// I/O control routines
 #include <termios.h>	// POSIX terminal control
 #include <unistd.h>
 #include <sys/socket.h>
+#include <sys/uio.h>	// writev
 
 #include <errno.h>
 
@@ -242,6 +244,16 @@ xpcc::hosted::SerialInterface::read(char& c)
 	return false;
 }
 
+std::size_t
+xpcc::hosted::SerialInterface::read(uint8_t* data, std::size_t length)
+{
+	ssize_t result = ::read(this->fileDescriptor, data, length);
+	if (result > 0) {
+		return result;
+	}
+	return 0;
+}
+
 // ----------------------------------------------------------------------------
 void
 xpcc::hosted::SerialInterface::readBytes(uint8_t* data, std::size_t length)
@@ -283,9 +295,67 @@ xpcc::hosted::SerialInterface::write(char c)
 void
 xpcc::hosted::SerialInterface::write(const char* str)
 {
-	char c;
-	while ((c = *str++)) {
-		this->write(c);
+	this->write(reinterpret_cast<const uint8_t*>(str), strlen(str));
+}
+
+void
+xpcc::hosted::SerialInterface::write(const uint8_t* data, std::size_t length)
+{
+	while (length > 0)
+	{
+		ssize_t reply = ::write(this->fileDescriptor, data, length);
+		if (reply <= 0) {
+			this->dumpErrorMessage();
+			return;
+		}
+		data += reply;
+		length -= reply;
+	}
+}
+
+void
+xpcc::hosted::SerialInterface::writeSegments(const Segment* segments, std::size_t count)
+{
+	// passed to the kernel in groups, IOV_MAX is at least 16
+	static constexpr std::size_t maxSegments = 16;
+	struct iovec vector[maxSegments];
+
+	while (count > 0)
+	{
+		std::size_t used = 0;
+		std::size_t length = 0;
+		for (; used < count and used < maxSegments; ++used)
+		{
+			vector[used].iov_base = const_cast<void*>(segments[used].data);
+			vector[used].iov_len = segments[used].length;
+			length += segments[used].length;
+		}
+
+		ssize_t reply = ::writev(this->fileDescriptor, vector, used);
+		if (reply < 0) {
+			this->dumpErrorMessage();
+			return;
+		}
+
+		if (static_cast<std::size_t>(reply) < length)
+		{
+			// partial write, continue with the remaining bytes of the
+			// segment where it stopped
+			std::size_t written = reply;
+			while (written >= segments->length) {
+				written -= segments->length;
+				segments++;
+				count--;
+			}
+			this->write(static_cast<const uint8_t*>(segments->data) + written,
+					segments->length - written);
+			segments++;
+			count--;
+		}
+		else {
+			segments += used;
+			count -= used;
+		}
 	}
 }
 
@@ -293,9 +363,7 @@ xpcc::hosted::SerialInterface::write(const char* str)
 void
 xpcc::hosted::SerialInterface::writeBytes(const uint8_t* data, std::size_t length)
 {
-	for (std::size_t i = 0; i < length; ++i) {
-		this->write(static_cast<char>(*data++));
-	}
+	this->write(data, length);
 }
 
 // ----------------------------------------------------------------------------
@@ -71,9 +71,9 @@ ZeroMQConnector::sendPacket(const Header &header, SmartPointer payload)
 	constexpr uint16_t maxPayloadSize = 65529;
 
 	if(payload.getSize() > maxPayloadSize) {
-		XPCC_LOG_ERROR << XPCC_FILE_INFO;
-		XPCC_LOG_ERROR << "Trying to send message with invalid size: ";
-		XPCC_LOG_ERROR << payload.getSize() << xpcc::endl;
+		XPCC_LOG_CHANNEL_ERROR(ZeroMQLog) << XPCC_FILE_INFO;
+		XPCC_LOG_CHANNEL_ERROR(ZeroMQLog) << "Trying to send message with invalid size: ";
+		XPCC_LOG_CHANNEL_ERROR(ZeroMQLog) << payload.getSize() << xpcc::endl;
 
 		return;
 	}
@@ -16,8 +16,6 @@
 #include <zmqpp/zmqpp.hpp>
 
 #include <xpcc/debug/logger.hpp>
-#undef XPCC_LOG_LEVEL
-#define	XPCC_LOG_LEVEL xpcc::log::ERROR
 
 #include "../backend_interface.hpp"
 #include "reader.hpp"
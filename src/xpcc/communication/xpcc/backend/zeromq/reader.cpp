@@ -128,8 +128,8 @@ ZeroMQReader::readPacket(const zmqpp::message& message)
 			if (this->queue.size() >= this->maxQueueSize) {
 				this->queue.pop_front();
 
-				XPCC_LOG_ERROR << XPCC_FILE_INFO;
-				XPCC_LOG_ERROR << "Receive queue is full, dropping packets" << xpcc::endl;
+				XPCC_LOG_CHANNEL_ERROR(ZeroMQLog) << XPCC_FILE_INFO;
+				XPCC_LOG_CHANNEL_ERROR(ZeroMQLog) << "Receive queue is full, dropping packets" << xpcc::endl;
 			}
 
 			this->queue.emplace_back(payloadSize, header);
@@ -139,8 +139,8 @@ ZeroMQReader::readPacket(const zmqpp::message& message)
 			std::copy_n(data + headerSize, payloadSize, payloadBuffer);
 		}
 	} else {
-		XPCC_LOG_ERROR << XPCC_FILE_INFO;
-		XPCC_LOG_ERROR << "Invalid message length: " << size << xpcc::endl;
+		XPCC_LOG_CHANNEL_ERROR(ZeroMQLog) << XPCC_FILE_INFO;
+		XPCC_LOG_CHANNEL_ERROR(ZeroMQLog) << "Invalid message length: " << size << xpcc::endl;
 	}
 }
 
@@ -21,12 +21,13 @@
 #include "../header.hpp"
 
 #include <xpcc/debug/logger.hpp>
-#undef XPCC_LOG_LEVEL
-#define	XPCC_LOG_LEVEL xpcc::log::ERROR
 
 namespace xpcc
 {
 
+/// Log channel of the ZeroMQ backend
+XPCC_LOG_CHANNEL(ZeroMQLog, xpcc::log::ERROR);
+
 /**
  * @brief	Reads packets from a zmqpp socket in a background thread
  *
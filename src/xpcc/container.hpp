@@ -56,6 +56,10 @@ Sequence containers:
  - xpcc::DoublyLinkedList
  - xpcc::BoundedDeque
 
+Associative containers:
+ - xpcc::BoundedHashMap
+ - xpcc::FlatMap
+
 Container adaptors:
  - xpcc::Queue
  - xpcc::Stack
@@ -119,6 +123,9 @@ every one of it, only a subset which is sufficient for the container.
 
 #include "container/dynamic_array.hpp"
 
+#include "container/bounded_hash_map.hpp"
+#include "container/flat_map.hpp"
+
 #include "container/pair.hpp"
 #include "container/smart_pointer.hpp"
 
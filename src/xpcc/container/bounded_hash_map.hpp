@@ -0,0 +1,251 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef	XPCC__BOUNDED_HASH_MAP_HPP
+#define	XPCC__BOUNDED_HASH_MAP_HPP
+
+#include <cstddef>
+#include <stdint.h>
+
+#include <xpcc/utils/template_metaprogramming.hpp>
+
+#include "pair.hpp"
+
+namespace xpcc
+{
+	/**
+	 * \brief	Default hash function object
+	 *
+	 * Works for all integral and enum types. Mixes the bits of the key so
+	 * that the lower bits of the result can be used directly as table index.
+	 * Specialize this template for your own key types or pass a custom
+	 * hash function to the container.
+	 *
+	 * \ingroup	container
+	 */
+	template<typename T>
+	struct Hash
+	{
+		std::size_t
+		operator () (const T& key) const
+		{
+			uint32_t h = static_cast<uint32_t>(key);
+			h ^= h >> 16;
+			h *= 0x45d9f3bUL;
+			h ^= h >> 16;
+			return h;
+		}
+	};
+
+	template<>
+	struct Hash<uint64_t>
+	{
+		std::size_t
+		operator () (const uint64_t& key) const
+		{
+			return Hash<uint32_t>()(static_cast<uint32_t>(key ^ (key >> 32)));
+		}
+	};
+
+	template<>
+	struct Hash<int64_t>
+	{
+		std::size_t
+		operator () (const int64_t& key) const
+		{
+			return Hash<uint64_t>()(static_cast<uint64_t>(key));
+		}
+	};
+
+	template<typename T>
+	struct Hash<T*>
+	{
+		std::size_t
+		operator () (T* key) const
+		{
+			return Hash<std::size_t>()(reinterpret_cast<std::size_t>(key));
+		}
+	};
+
+	/**
+	 * \brief	Hash map with fixed capacity
+	 *
+	 * Open addressing hash table with linear probing. All entries are
+	 * stored inside the object itself, no heap memory is used. Removing an
+	 * entry shifts the following entries of the same probe sequence back,
+	 * therefore no tombstones are needed and lookup time does not degrade
+	 * after many insert/remove cycles.
+	 *
+	 * Lookup, insertion and removal are O(1) on average. Keep the load
+	 * factor below ~75% (choose `N` accordingly) to keep the probe
+	 * sequences short.
+	 *
+	 * \code
+	 * xpcc::BoundedHashMap<uint16_t, Component*, 32> components;
+	 *
+	 * components.insert(0x12, &driver);
+	 *
+	 * Component** c = components.find(0x12);
+	 * if (c != nullptr) {
+	 *     (*c)->update();
+	 * }
+	 * \endcode
+	 *
+	 * \tparam	Key		Type of the keys, needs `operator ==`
+	 * \tparam	Value	Type of the values
+	 * \tparam	N		Capacity of the map, must be a power of two
+	 * \tparam	HashFunction	Function object returning a hash for a key
+	 *
+	 * Up to a size of 254 small index variables with 8-bits are used, after
+	 * this they are switched to 16-bit.
+	 *
+	 * \see		FlatMap
+	 *
+	 * \ingroup	container
+	 */
+	template<typename Key,
+			 typename Value,
+			 std::size_t N,
+			 typename HashFunction = Hash<Key> >
+	class BoundedHashMap
+	{
+	public:
+		typedef typename xpcc::tmp::Select< (N >= 255),
+											uint_fast16_t,
+											uint_fast8_t >::Result Index;
+
+		typedef Index Size;
+		typedef Pair<Key, Value> Entry;
+
+	public:
+		BoundedHashMap(const HashFunction& hash = HashFunction());
+
+		inline bool
+		isEmpty() const;
+
+		inline bool
+		isNotEmpty() const { return not isEmpty(); };
+
+		inline bool
+		isFull() const;
+
+		inline bool
+		isNotFull() const { return not isFull(); };
+
+		inline Size
+		getSize() const;
+
+		inline Size
+		getMaxSize() const;
+
+		/**
+		 * \brief	Clear the container
+		 *
+		 * \warning	This will discard all the items in the container
+		 */
+		void
+		clear();
+
+		/**
+		 * \brief	Insert or update an entry
+		 *
+		 * If the key is already stored its value is replaced.
+		 *
+		 * \return	`false` if the key is not yet stored and the map is full,
+		 * 			`true` otherwise.
+		 */
+		bool
+		insert(const Key& key, const Value& value);
+
+		/**
+		 * \brief	Remove the entry with the given key
+		 *
+		 * \return	`true` if an entry was removed, `false` if the key
+		 * 			was not found.
+		 */
+		bool
+		remove(const Key& key);
+
+		/**
+		 * \brief	Find the value associated with a key
+		 *
+		 * \return	Pointer to the stored value or `nullptr` if the key was
+		 * 			not found. The pointer is invalidated by the next call
+		 * 			to insert() or remove().
+		 */
+		Value*
+		find(const Key& key);
+
+		const Value*
+		find(const Key& key) const;
+
+		inline bool
+		contains(const Key& key) const;
+
+	public:
+		/**
+		 * \brief	Forward const iterator over all stored entries
+		 *
+		 * The entries are visited in table order, not in insertion order.
+		 */
+		class const_iterator
+		{
+			friend class BoundedHashMap;
+
+		public:
+			const_iterator();
+
+			const_iterator& operator ++ ();
+			bool operator == (const const_iterator& other) const;
+			bool operator != (const const_iterator& other) const;
+			const Entry& operator * () const;
+			const Entry* operator -> () const;
+
+		private:
+			const_iterator(std::size_t index, const BoundedHashMap * parent);
+
+			std::size_t index;
+			const BoundedHashMap * parent;
+		};
+
+		const_iterator
+		begin() const;
+
+		const_iterator
+		end() const;
+
+	private:
+		static_assert(N > 0 and (N & (N - 1)) == 0, "N must be a power of two");
+
+		static const std::size_t mask = N - 1;
+
+		inline std::size_t
+		getHome(const Key& key) const;
+
+		/// Index of the slot containing `key` or N if not found
+		std::size_t
+		lookup(const Key& key) const;
+
+		inline bool
+		isUsed(std::size_t index) const;
+
+		inline void
+		setUsed(std::size_t index, bool used);
+
+		HashFunction hash;
+		Size size;
+
+		uint8_t used[(N + 7) / 8];
+		Entry entries[N];
+	};
+}
+
+#include "bounded_hash_map_impl.hpp"
+
+#endif	// XPCC__BOUNDED_HASH_MAP_HPP
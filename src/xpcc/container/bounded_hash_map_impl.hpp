@@ -0,0 +1,287 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef	XPCC__BOUNDED_HASH_MAP_HPP
+	#error	"Don't include this file directly use 'container/bounded_hash_map.hpp' instead!"
+#endif
+
+// ----------------------------------------------------------------------------
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::BoundedHashMap(const HashFunction& hash) :
+	hash(hash), size(0)
+{
+	for (std::size_t i = 0; i < sizeof(used); ++i) {
+		used[i] = 0;
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+bool
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::isEmpty() const
+{
+	return (this->size == 0);
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+bool
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::isFull() const
+{
+	return (this->size == N);
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+typename xpcc::BoundedHashMap<Key, Value, N, HashFunction>::Size
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::getSize() const
+{
+	return this->size;
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+typename xpcc::BoundedHashMap<Key, Value, N, HashFunction>::Size
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::getMaxSize() const
+{
+	return N;
+}
+
+// ----------------------------------------------------------------------------
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+void
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::clear()
+{
+	for (std::size_t i = 0; i < sizeof(used); ++i) {
+		used[i] = 0;
+	}
+	this->size = 0;
+}
+
+// ----------------------------------------------------------------------------
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+bool
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::insert(const Key& key, const Value& value)
+{
+	std::size_t index = this->getHome(key);
+	for (std::size_t probe = 0; probe < N; ++probe)
+	{
+		if (not this->isUsed(index))
+		{
+			this->entries[index].first = key;
+			this->entries[index].second = value;
+			this->setUsed(index, true);
+			this->size++;
+			return true;
+		}
+		if (this->entries[index].first == key)
+		{
+			this->entries[index].second = value;
+			return true;
+		}
+		index = (index + 1) & mask;
+	}
+
+	// map is full and the key is not contained
+	return false;
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+bool
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::remove(const Key& key)
+{
+	std::size_t hole = this->lookup(key);
+	if (hole == N) {
+		return false;
+	}
+
+	this->setUsed(hole, false);
+	this->size--;
+
+	// Backward shift deletion: move all following entries of the probe
+	// sequence, which would not be found anymore with the hole, into the hole.
+	std::size_t index = hole;
+	while (true)
+	{
+		index = (index + 1) & mask;
+		if (not this->isUsed(index)) {
+			break;
+		}
+
+		std::size_t home = this->getHome(this->entries[index].first);
+
+		// check if `home` lies cyclically within (hole, index]
+		bool reachable = (hole <= index) ?
+				(hole < home and home <= index) :
+				(hole < home or home <= index);
+		if (not reachable)
+		{
+			this->entries[hole] = this->entries[index];
+			this->setUsed(hole, true);
+			this->setUsed(index, false);
+			hole = index;
+		}
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+Value*
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::find(const Key& key)
+{
+	std::size_t index = this->lookup(key);
+	if (index == N) {
+		return nullptr;
+	}
+	return &this->entries[index].second;
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+const Value*
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::find(const Key& key) const
+{
+	std::size_t index = this->lookup(key);
+	if (index == N) {
+		return nullptr;
+	}
+	return &this->entries[index].second;
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+bool
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::contains(const Key& key) const
+{
+	return (this->lookup(key) != N);
+}
+
+// ----------------------------------------------------------------------------
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+std::size_t
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::getHome(const Key& key) const
+{
+	return (this->hash(key) & mask);
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+std::size_t
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::lookup(const Key& key) const
+{
+	std::size_t index = this->getHome(key);
+	for (std::size_t probe = 0; probe < N; ++probe)
+	{
+		if (not this->isUsed(index)) {
+			break;
+		}
+		if (this->entries[index].first == key) {
+			return index;
+		}
+		index = (index + 1) & mask;
+	}
+	return N;
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+bool
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::isUsed(std::size_t index) const
+{
+	return (this->used[index / 8] & (1 << (index % 8)));
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+void
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::setUsed(std::size_t index, bool used)
+{
+	if (used) {
+		this->used[index / 8] |= (1 << (index % 8));
+	}
+	else {
+		this->used[index / 8] &= ~(1 << (index % 8));
+	}
+}
+
+// ----------------------------------------------------------------------------
+// Iterators
+// ----------------------------------------------------------------------------
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::const_iterator::const_iterator() :
+	index(N), parent(0)
+{
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::const_iterator::const_iterator(
+		std::size_t index, const BoundedHashMap * parent) :
+	index(index), parent(parent)
+{
+	// advance to the first used slot
+	while (this->index < N and not this->parent->isUsed(this->index)) {
+		this->index++;
+	}
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+typename xpcc::BoundedHashMap<Key, Value, N, HashFunction>::const_iterator&
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::const_iterator::operator ++ ()
+{
+	do {
+		this->index++;
+	}
+	while (this->index < N and not this->parent->isUsed(this->index));
+	return *this;
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+bool
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::const_iterator::operator == (
+		const const_iterator& other) const
+{
+	return (this->index == other.index);
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+bool
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::const_iterator::operator != (
+		const const_iterator& other) const
+{
+	return (this->index != other.index);
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+const typename xpcc::BoundedHashMap<Key, Value, N, HashFunction>::Entry&
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::const_iterator::operator * () const
+{
+	return this->parent->entries[this->index];
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+const typename xpcc::BoundedHashMap<Key, Value, N, HashFunction>::Entry*
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::const_iterator::operator -> () const
+{
+	return &this->parent->entries[this->index];
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+typename xpcc::BoundedHashMap<Key, Value, N, HashFunction>::const_iterator
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::begin() const
+{
+	return const_iterator(0, this);
+}
+
+template<typename Key, typename Value, std::size_t N, typename HashFunction>
+typename xpcc::BoundedHashMap<Key, Value, N, HashFunction>::const_iterator
+xpcc::BoundedHashMap<Key, Value, N, HashFunction>::end() const
+{
+	return const_iterator(N, this);
+}
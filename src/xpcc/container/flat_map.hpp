@@ -0,0 +1,153 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef	XPCC__FLAT_MAP_HPP
+#define	XPCC__FLAT_MAP_HPP
+
+#include <cstddef>
+#include <stdint.h>
+
+#include <xpcc/utils/template_metaprogramming.hpp>
+
+#include "pair.hpp"
+
+namespace xpcc
+{
+	/**
+	 * \brief	Sorted associative array with fixed capacity
+	 *
+	 * The entries are kept in a contiguous array sorted by their key.
+	 * Lookup is a binary search in O(log n), insertion and removal have to
+	 * move the following entries and are O(n). No heap memory is used.
+	 *
+	 * Compared to BoundedHashMap this container needs less memory (no
+	 * spare slots are required), iterates in key order and does not need
+	 * a hash function. It is a good choice for tables which are filled once
+	 * during initialization and afterwards mostly read.
+	 *
+	 * \tparam	Key		Type of the keys, needs `operator <` and `operator ==`
+	 * \tparam	Value	Type of the values
+	 * \tparam	N		Capacity of the map
+	 *
+	 * Up to a size of 254 small index variables with 8-bits are used, after
+	 * this they are switched to 16-bit.
+	 *
+	 * \see		BoundedHashMap
+	 *
+	 * \ingroup	container
+	 */
+	template<typename Key,
+			 typename Value,
+			 std::size_t N>
+	class FlatMap
+	{
+	public:
+		typedef typename xpcc::tmp::Select< (N >= 255),
+											uint_fast16_t,
+											uint_fast8_t >::Result Index;
+
+		typedef Index Size;
+		typedef Pair<Key, Value> Entry;
+
+		/// Entries are iterated in ascending key order
+		typedef const Entry* const_iterator;
+
+	public:
+		FlatMap();
+
+		inline bool
+		isEmpty() const;
+
+		inline bool
+		isNotEmpty() const { return not isEmpty(); };
+
+		inline bool
+		isFull() const;
+
+		inline bool
+		isNotFull() const { return not isFull(); };
+
+		inline Size
+		getSize() const;
+
+		inline Size
+		getMaxSize() const;
+
+		/**
+		 * \brief	Clear the container
+		 *
+		 * \warning	This will discard all the items in the container
+		 */
+		void
+		clear();
+
+		/**
+		 * \brief	Insert or update an entry
+		 *
+		 * If the key is already stored its value is replaced.
+		 *
+		 * \return	`false` if the key is not yet stored and the map is full,
+		 * 			`true` otherwise.
+		 */
+		bool
+		insert(const Key& key, const Value& value);
+
+		/**
+		 * \brief	Remove the entry with the given key
+		 *
+		 * \return	`true` if an entry was removed, `false` if the key
+		 * 			was not found.
+		 */
+		bool
+		remove(const Key& key);
+
+		/**
+		 * \brief	Find the value associated with a key
+		 *
+		 * \return	Pointer to the stored value or `nullptr` if the key was
+		 * 			not found. The pointer is invalidated by the next call
+		 * 			to insert() or remove().
+		 */
+		Value*
+		find(const Key& key);
+
+		const Value*
+		find(const Key& key) const;
+
+		inline bool
+		contains(const Key& key) const;
+
+		/**
+		 * \brief	Get entry at specified index
+		 *
+		 * \warning Please make sure `n` is a valid index: 0 <= *n* < *size*.
+		 * 			Other indexes will cause undefined behaviour.
+		 */
+		inline const Entry&
+		operator[](Index n) const;
+
+		inline const_iterator
+		begin() const;
+
+		inline const_iterator
+		end() const;
+
+	private:
+		/// Index of the first entry whose key is not less than `key`
+		Index
+		lowerBound(const Key& key) const;
+
+		Size size;
+		Entry entries[N];
+	};
+}
+
+#include "flat_map_impl.hpp"
+
+#endif	// XPCC__FLAT_MAP_HPP
@@ -0,0 +1,176 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef	XPCC__FLAT_MAP_HPP
+	#error	"Don't include this file directly use 'container/flat_map.hpp' instead!"
+#endif
+
+// ----------------------------------------------------------------------------
+
+template<typename Key, typename Value, std::size_t N>
+xpcc::FlatMap<Key, Value, N>::FlatMap() :
+	size(0)
+{
+	static_assert(N > 0, "size = 0 is not allowed");
+}
+
+// ----------------------------------------------------------------------------
+
+template<typename Key, typename Value, std::size_t N>
+bool
+xpcc::FlatMap<Key, Value, N>::isEmpty() const
+{
+	return (this->size == 0);
+}
+
+template<typename Key, typename Value, std::size_t N>
+bool
+xpcc::FlatMap<Key, Value, N>::isFull() const
+{
+	return (this->size == N);
+}
+
+template<typename Key, typename Value, std::size_t N>
+typename xpcc::FlatMap<Key, Value, N>::Size
+xpcc::FlatMap<Key, Value, N>::getSize() const
+{
+	return this->size;
+}
+
+template<typename Key, typename Value, std::size_t N>
+typename xpcc::FlatMap<Key, Value, N>::Size
+xpcc::FlatMap<Key, Value, N>::getMaxSize() const
+{
+	return N;
+}
+
+template<typename Key, typename Value, std::size_t N>
+void
+xpcc::FlatMap<Key, Value, N>::clear()
+{
+	this->size = 0;
+}
+
+// ----------------------------------------------------------------------------
+
+template<typename Key, typename Value, std::size_t N>
+bool
+xpcc::FlatMap<Key, Value, N>::insert(const Key& key, const Value& value)
+{
+	Index index = this->lowerBound(key);
+	if (index < this->size and this->entries[index].first == key)
+	{
+		this->entries[index].second = value;
+		return true;
+	}
+
+	if (this->isFull()) {
+		return false;
+	}
+
+	// make room for the new entry
+	for (Index i = this->size; i > index; --i) {
+		this->entries[i] = this->entries[i - 1];
+	}
+
+	this->entries[index].first = key;
+	this->entries[index].second = value;
+	this->size++;
+	return true;
+}
+
+template<typename Key, typename Value, std::size_t N>
+bool
+xpcc::FlatMap<Key, Value, N>::remove(const Key& key)
+{
+	Index index = this->lowerBound(key);
+	if (index >= this->size or not (this->entries[index].first == key)) {
+		return false;
+	}
+
+	this->size--;
+	for (Index i = index; i < this->size; ++i) {
+		this->entries[i] = this->entries[i + 1];
+	}
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+
+template<typename Key, typename Value, std::size_t N>
+Value*
+xpcc::FlatMap<Key, Value, N>::find(const Key& key)
+{
+	return const_cast<Value*>(static_cast<const FlatMap*>(this)->find(key));
+}
+
+template<typename Key, typename Value, std::size_t N>
+const Value*
+xpcc::FlatMap<Key, Value, N>::find(const Key& key) const
+{
+	Index index = this->lowerBound(key);
+	if (index < this->size and this->entries[index].first == key) {
+		return &this->entries[index].second;
+	}
+	return nullptr;
+}
+
+template<typename Key, typename Value, std::size_t N>
+bool
+xpcc::FlatMap<Key, Value, N>::contains(const Key& key) const
+{
+	return (this->find(key) != nullptr);
+}
+
+// ----------------------------------------------------------------------------
+
+template<typename Key, typename Value, std::size_t N>
+const typename xpcc::FlatMap<Key, Value, N>::Entry&
+xpcc::FlatMap<Key, Value, N>::operator[](Index n) const
+{
+	return this->entries[n];
+}
+
+template<typename Key, typename Value, std::size_t N>
+typename xpcc::FlatMap<Key, Value, N>::const_iterator
+xpcc::FlatMap<Key, Value, N>::begin() const
+{
+	return this->entries;
+}
+
+template<typename Key, typename Value, std::size_t N>
+typename xpcc::FlatMap<Key, Value, N>::const_iterator
+xpcc::FlatMap<Key, Value, N>::end() const
+{
+	return this->entries + this->size;
+}
+
+// ----------------------------------------------------------------------------
+
+template<typename Key, typename Value, std::size_t N>
+typename xpcc::FlatMap<Key, Value, N>::Index
+xpcc::FlatMap<Key, Value, N>::lowerBound(const Key& key) const
+{
+	Index first = 0;
+	Index count = this->size;
+	while (count > 0)
+	{
+		Index step = count / 2;
+		Index middle = first + step;
+		if (this->entries[middle].first < key)
+		{
+			first = middle + 1;
+			count -= step + 1;
+		}
+		else {
+			count = step;
+		}
+	}
+	return first;
+}
@@ -31,35 +31,48 @@
 #include "smart_pointer.hpp"
 
 // ----------------------------------------------------------------------------
-// must allocate at least five bytes, so getPointer() does return
-// a valid address
 xpcc::SmartPointer::SmartPointer() :
-	ptr(new uint8_t[5])
+	size(0)
 {
-	ptr[0] = 1;
-	ptr[2] = 0;
-	ptr[3] = 0;
 }
 
 xpcc::SmartPointer::SmartPointer(const SmartPointer& other) :
-	ptr(other.ptr)
+	storage(other.storage), size(other.size)
 {
-	ptr[0]++;
+	if (not isInline()) {
+		storage.ptr[0]++;
+	}
 }
 
-// must allocate at least five bytes, so getPointer() does return
-// a valid address
 xpcc::SmartPointer::SmartPointer(uint16_t size) :
-	ptr(new uint8_t[size ? size + 4 : 5])
+	size(size)
 {
-	ptr[0] = 1;
-	*reinterpret_cast<uint16_t*>(ptr + 2) = size;
+	allocate();
 }
 
 xpcc::SmartPointer::~SmartPointer()
 {
-	if (--ptr[0] == 0) {
-		delete[] ptr;
+	release();
+}
+
+// ----------------------------------------------------------------------------
+uint8_t *
+xpcc::SmartPointer::allocate()
+{
+	if (isInline()) {
+		return storage.buffer;
+	}
+
+	storage.ptr = new uint8_t[size + 4];
+	storage.ptr[0] = 1;
+	return storage.ptr + 4;
+}
+
+void
+xpcc::SmartPointer::release()
+{
+	if (not isInline() and --storage.ptr[0] == 0) {
+		delete[] storage.ptr;
 	}
 }
 
@@ -67,18 +80,27 @@ xpcc::SmartPointer::~SmartPointer()
 bool
 xpcc::SmartPointer::operator == (const SmartPointer& other)
 {
-	return (this->ptr == other.ptr);
+	if (this->size != other.size) {
+		return false;
+	}
+
+	if (isInline()) {
+		return (std::memcmp(storage.buffer, other.storage.buffer, size) == 0);
+	}
+	return (this->storage.ptr == other.storage.ptr);
 }
 
 xpcc::SmartPointer&
 xpcc::SmartPointer::operator = (const SmartPointer& other)
 {
-	if (--ptr[0] == 0) {
-		delete[] ptr;
+	// increment first, other might share the memory with this object
+	if (not other.isInline()) {
+		other.storage.ptr[0]++;
 	}
+	release();
 
-	ptr = other.ptr;
-	ptr[0]++;
+	storage = other.storage;
+	size = other.size;
 
 	return *this;
 }
@@ -87,10 +109,12 @@ xpcc::SmartPointer::operator = (const SmartPointer& other)
 xpcc::IOStream&
 xpcc::operator << (xpcc::IOStream& s, const xpcc::SmartPointer& v)
 {
+	const uint8_t * data = v.getPointer();
+
 	s << "0x" << xpcc::hex;
-	for (uint8_t i = 4; i < v.getSize() + 4; i++)
+	for (uint16_t i = 0; i < v.getSize(); i++)
 	{
-		s << v.ptr[i];
+		s << data[i];
 	}
 	s << xpcc::ascii;
 	return s;
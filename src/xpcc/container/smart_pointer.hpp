@@ -37,6 +37,19 @@
 
 #include <xpcc/io/iostream.hpp>
 
+/**
+ * Payloads up to this number of bytes are stored inside the SmartPointer
+ * object instead of on the heap.
+ *
+ * Must be at least the size of a pointer. Can be overwritten by the
+ * project to trade RAM for fewer heap allocations.
+ *
+ * \ingroup container
+ */
+#ifndef XPCC_SMART_POINTER_INLINE_SIZE
+#	define XPCC_SMART_POINTER_INLINE_SIZE	12
+#endif
+
 namespace xpcc
 {
 	class SmartPointerVolatile;
@@ -45,16 +58,25 @@ namespace xpcc
 	 * \brief 	Container which destroys itself when the last
 	 * 			copy is destroyed.
 	 *
-	 * This container saves a copy of the given data on the heap. It
+	 * Small payloads (up to `XPCC_SMART_POINTER_INLINE_SIZE` bytes) are
+	 * stored inside the object itself. Copying such a pointer is a plain
+	 * copy of the object and no heap memory is involved at all.
+	 *
+	 * Larger payloads are saved on the heap. In this case the container
 	 * provides the functionality of a shared pointer => pointer object
 	 * records when it is copied - when the last copy is destroyed the
 	 * memory is released.
 	 *
+	 * \warning	Copies of an inline payload don't share their data. Write
+	 * 			to the payload before copying the pointer.
+	 *
 	 * \ingroup container
 	 */
 	class SmartPointer
 	{
 	public:
+		static constexpr uint16_t InlineSize = XPCC_SMART_POINTER_INLINE_SIZE;
+
 		/// default constructor with empty payload
 		SmartPointer();
 
@@ -69,12 +91,10 @@ namespace xpcc
 		// Must use a pointer to T here, otherwise the compiler can't distinguish
 		// between constructor and copy constructor!
 		template<typename T>
-		explicit SmartPointer(const T *data)
-		: ptr(new uint8_t[sizeof(T) + 4])
+		explicit SmartPointer(const T *data) :
+			size(sizeof(T))
 		{
-			ptr[0] = 1;
-			*reinterpret_cast<uint16_t*>(ptr + 2) = sizeof(T);
-			std::memcpy(ptr + 4, data, sizeof(T));
+			std::memcpy(allocate(), data, sizeof(T));
 		}
 
 		SmartPointer(const SmartPointer& other);
@@ -84,19 +104,26 @@ namespace xpcc
 		inline const uint8_t *
 		getPointer() const
 		{
-			return ptr + 4;
+			return isInline() ? storage.buffer : storage.ptr + 4;
 		}
 
 		inline uint8_t *
 		getPointer()
 		{
-			return ptr + 4;
+			return isInline() ? storage.buffer : storage.ptr + 4;
 		}
 
 		inline uint16_t
 		getSize() const
 		{
-			return *reinterpret_cast<uint16_t*>(ptr + 2);
+			return size;
+		}
+
+		/// `true` if the payload is stored inside the object
+		inline bool
+		isInline() const
+		{
+			return (size <= InlineSize);
 		}
 
 	public:
@@ -110,7 +137,7 @@ namespace xpcc
 		inline const T&
 		get() const
 		{
-			return *reinterpret_cast<T*>(ptr + 4);
+			return *reinterpret_cast<const T*>(getPointer());
 		}
 
 		/**
@@ -125,7 +152,7 @@ namespace xpcc
 		{
 			if (sizeof(T) == getSize())
 			{
-				value = *reinterpret_cast<T*>(ptr + 4);
+				value = *reinterpret_cast<const T*>(getPointer());
 				return true;
 			}
 			else {
@@ -133,19 +160,44 @@ namespace xpcc
 			}
 		}
 
+		/**
+		 * Heap payloads are equal if both pointers share the same memory,
+		 * inline payloads if they have the same size and content.
+		 */
 		bool
 		operator == (const SmartPointer& other);
 
 		SmartPointer&
 		operator = (const SmartPointer& other);
 
+	private:
+		/// Allocate heap memory if necessary, returns the payload address
+		uint8_t *
+		allocate();
+
+		/// Release the heap memory if this was the last copy
+		void
+		release();
+
 	protected:
-		uint8_t * ptr;
+		// Heap memory layout: [reference counter, 3 bytes padding, payload]
+		// The padding keeps the payload aligned.
+		union Storage
+		{
+			uint8_t * ptr;
+			uint8_t buffer[InlineSize];
+		};
+
+		Storage storage;
+		uint16_t size;
+
+		static_assert(XPCC_SMART_POINTER_INLINE_SIZE >= sizeof(uint8_t *),
+				"XPCC_SMART_POINTER_INLINE_SIZE must hold at least a pointer!");
 
 	protected:
 		friend IOStream&
 		operator <<( IOStream&, const SmartPointer&);
-	} xpcc_packed;
+	};
 
 	/**
 	 * \ingroup container
@@ -0,0 +1,158 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/container/bounded_hash_map.hpp>
+
+#include "bounded_hash_map_test.hpp"
+
+namespace
+{
+	// forces long probe sequences to test the collision handling
+	struct CollidingHash
+	{
+		std::size_t
+		operator () (const uint8_t& key) const
+		{
+			return key % 2;
+		}
+	};
+}
+
+void
+BoundedHashMapTest::testInsertFind()
+{
+	xpcc::BoundedHashMap<uint16_t, int16_t, 8> map;
+
+	TEST_ASSERT_TRUE(map.isEmpty());
+	TEST_ASSERT_EQUALS(map.getSize(), 0U);
+	TEST_ASSERT_EQUALS(map.getMaxSize(), 8U);
+	TEST_ASSERT_TRUE(map.find(1) == nullptr);
+
+	TEST_ASSERT_TRUE(map.insert(1, 10));
+	TEST_ASSERT_TRUE(map.insert(1000, -20));
+	TEST_ASSERT_TRUE(map.insert(42, 30));
+
+	TEST_ASSERT_FALSE(map.isEmpty());
+	TEST_ASSERT_EQUALS(map.getSize(), 3U);
+
+	TEST_ASSERT_TRUE(map.contains(1));
+	TEST_ASSERT_TRUE(map.contains(1000));
+	TEST_ASSERT_TRUE(map.contains(42));
+	TEST_ASSERT_FALSE(map.contains(2));
+
+	TEST_ASSERT_EQUALS(*map.find(1), 10);
+	TEST_ASSERT_EQUALS(*map.find(1000), -20);
+	TEST_ASSERT_EQUALS(*map.find(42), 30);
+
+	// update an existing entry
+	TEST_ASSERT_TRUE(map.insert(1000, 5));
+	TEST_ASSERT_EQUALS(map.getSize(), 3U);
+	TEST_ASSERT_EQUALS(*map.find(1000), 5);
+
+	*map.find(42) = 7;
+	TEST_ASSERT_EQUALS(*map.find(42), 7);
+
+	map.clear();
+	TEST_ASSERT_TRUE(map.isEmpty());
+	TEST_ASSERT_FALSE(map.contains(1));
+}
+
+void
+BoundedHashMapTest::testFull()
+{
+	xpcc::BoundedHashMap<uint8_t, uint8_t, 4, CollidingHash> map;
+
+	TEST_ASSERT_TRUE(map.insert(1, 1));
+	TEST_ASSERT_TRUE(map.insert(2, 2));
+	TEST_ASSERT_TRUE(map.insert(3, 3));
+	TEST_ASSERT_TRUE(map.insert(4, 4));
+	TEST_ASSERT_TRUE(map.isFull());
+
+	TEST_ASSERT_FALSE(map.insert(5, 5));
+	TEST_ASSERT_FALSE(map.contains(5));
+
+	// updating is still possible
+	TEST_ASSERT_TRUE(map.insert(3, 30));
+	TEST_ASSERT_EQUALS(*map.find(3), 30);
+
+	for (uint8_t i = 1; i <= 4; ++i) {
+		TEST_ASSERT_TRUE(map.contains(i));
+	}
+}
+
+void
+BoundedHashMapTest::testRemove()
+{
+	const uint8_t remaining[] = { 1, 2, 4, 5, 6 };
+	xpcc::BoundedHashMap<uint8_t, uint8_t, 8, CollidingHash> map;
+
+	// all even keys start probing at slot 0, all odd ones at slot 1
+	for (uint8_t i = 0; i < 7; ++i) {
+		TEST_ASSERT_TRUE(map.insert(i, i + 100));
+	}
+
+	TEST_ASSERT_FALSE(map.remove(20));
+	TEST_ASSERT_TRUE(map.remove(0));
+	TEST_ASSERT_FALSE(map.remove(0));
+	TEST_ASSERT_TRUE(map.remove(3));
+	TEST_ASSERT_EQUALS(map.getSize(), 5U);
+
+	TEST_ASSERT_FALSE(map.contains(0));
+	TEST_ASSERT_FALSE(map.contains(3));
+	for (uint8_t k = 0; k < 5; ++k) {
+		uint8_t i = remaining[k];
+		TEST_ASSERT_TRUE(map.contains(i));
+		TEST_ASSERT_EQUALS(*map.find(i), i + 100);
+	}
+
+	// reuse the freed slots many times
+	for (uint8_t round = 0; round < 20; ++round)
+	{
+		TEST_ASSERT_TRUE(map.insert(10, round));
+		TEST_ASSERT_TRUE(map.insert(11, round));
+		TEST_ASSERT_TRUE(map.insert(12, round));
+		TEST_ASSERT_TRUE(map.isFull());
+
+		TEST_ASSERT_TRUE(map.remove(2));
+		TEST_ASSERT_TRUE(map.remove(11));
+		TEST_ASSERT_TRUE(map.remove(10));
+		TEST_ASSERT_TRUE(map.remove(12));
+		TEST_ASSERT_TRUE(map.insert(2, 102));
+
+		for (uint8_t k = 0; k < 5; ++k) {
+			uint8_t i = remaining[k];
+			TEST_ASSERT_EQUALS(*map.find(i), i + 100);
+		}
+	}
+}
+
+void
+BoundedHashMapTest::testIterator()
+{
+	xpcc::BoundedHashMap<int32_t, int32_t, 16> map;
+
+	TEST_ASSERT_TRUE(map.begin() == map.end());
+
+	for (int32_t i = -5; i < 5; ++i) {
+		map.insert(i * 1000, i);
+	}
+
+	int32_t count = 0;
+	int32_t sum = 0;
+	for (xpcc::BoundedHashMap<int32_t, int32_t, 16>::const_iterator it = map.begin();
+			it != map.end(); ++it)
+	{
+		TEST_ASSERT_EQUALS(it->first, it->second * 1000);
+		sum += (*it).second;
+		count++;
+	}
+
+	TEST_ASSERT_EQUALS(count, 10);
+	TEST_ASSERT_EQUALS(sum, -5);
+}
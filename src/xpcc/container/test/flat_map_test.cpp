@@ -0,0 +1,114 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/container/flat_map.hpp>
+
+#include "flat_map_test.hpp"
+
+void
+FlatMapTest::testInsertFind()
+{
+	xpcc::FlatMap<uint16_t, int16_t, 8> map;
+
+	TEST_ASSERT_TRUE(map.isEmpty());
+	TEST_ASSERT_EQUALS(map.getSize(), 0U);
+	TEST_ASSERT_EQUALS(map.getMaxSize(), 8U);
+	TEST_ASSERT_TRUE(map.find(1) == nullptr);
+
+	TEST_ASSERT_TRUE(map.insert(1000, -20));
+	TEST_ASSERT_TRUE(map.insert(1, 10));
+	TEST_ASSERT_TRUE(map.insert(42, 30));
+
+	TEST_ASSERT_EQUALS(map.getSize(), 3U);
+
+	TEST_ASSERT_TRUE(map.contains(1));
+	TEST_ASSERT_TRUE(map.contains(42));
+	TEST_ASSERT_FALSE(map.contains(0));
+	TEST_ASSERT_FALSE(map.contains(2000));
+
+	TEST_ASSERT_EQUALS(*map.find(1), 10);
+	TEST_ASSERT_EQUALS(*map.find(1000), -20);
+	TEST_ASSERT_EQUALS(*map.find(42), 30);
+
+	// update an existing entry
+	TEST_ASSERT_TRUE(map.insert(42, 5));
+	TEST_ASSERT_EQUALS(map.getSize(), 3U);
+	TEST_ASSERT_EQUALS(*map.find(42), 5);
+
+	map.clear();
+	TEST_ASSERT_TRUE(map.isEmpty());
+	TEST_ASSERT_FALSE(map.contains(1));
+}
+
+void
+FlatMapTest::testFull()
+{
+	xpcc::FlatMap<uint8_t, uint8_t, 3> map;
+
+	TEST_ASSERT_TRUE(map.insert(3, 3));
+	TEST_ASSERT_TRUE(map.insert(1, 1));
+	TEST_ASSERT_TRUE(map.insert(2, 2));
+	TEST_ASSERT_TRUE(map.isFull());
+
+	TEST_ASSERT_FALSE(map.insert(0, 0));
+	TEST_ASSERT_FALSE(map.insert(4, 4));
+
+	TEST_ASSERT_TRUE(map.insert(2, 20));
+	TEST_ASSERT_EQUALS(*map.find(2), 20);
+}
+
+void
+FlatMapTest::testRemove()
+{
+	const uint8_t remaining[] = { 1, 2, 4, 5, 6 };
+	xpcc::FlatMap<uint8_t, uint8_t, 8> map;
+
+	for (uint8_t i = 0; i < 8; ++i) {
+		TEST_ASSERT_TRUE(map.insert(i, i + 100));
+	}
+
+	TEST_ASSERT_FALSE(map.remove(20));
+	TEST_ASSERT_TRUE(map.remove(0));
+	TEST_ASSERT_TRUE(map.remove(7));
+	TEST_ASSERT_TRUE(map.remove(3));
+	TEST_ASSERT_FALSE(map.remove(3));
+	TEST_ASSERT_EQUALS(map.getSize(), 5U);
+
+	for (uint8_t k = 0; k < 5; ++k) {
+		uint8_t i = remaining[k];
+		TEST_ASSERT_EQUALS(*map.find(i), i + 100);
+	}
+	TEST_ASSERT_FALSE(map.contains(0));
+	TEST_ASSERT_FALSE(map.contains(3));
+	TEST_ASSERT_FALSE(map.contains(7));
+}
+
+void
+FlatMapTest::testOrder()
+{
+	xpcc::FlatMap<int16_t, uint8_t, 16> map;
+
+	TEST_ASSERT_TRUE(map.begin() == map.end());
+
+	const int16_t keys[] = { 5, -3, 100, 0, -200, 7 };
+	for (uint8_t i = 0; i < 6; ++i) {
+		map.insert(keys[i], i);
+	}
+
+	const int16_t sorted[] = { -200, -3, 0, 5, 7, 100 };
+	uint8_t index = 0;
+	for (xpcc::FlatMap<int16_t, uint8_t, 16>::const_iterator it = map.begin();
+			it != map.end(); ++it)
+	{
+		TEST_ASSERT_EQUALS(it->first, sorted[index]);
+		TEST_ASSERT_EQUALS(map[index].first, sorted[index]);
+		index++;
+	}
+	TEST_ASSERT_EQUALS(index, 6U);
+}
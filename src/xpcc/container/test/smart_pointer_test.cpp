@@ -0,0 +1,137 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/container/smart_pointer.hpp>
+
+#include "smart_pointer_test.hpp"
+
+namespace
+{
+	struct Large
+	{
+		uint32_t values[8];
+	};
+}
+
+void
+SmartPointerTest::testEmpty()
+{
+	xpcc::SmartPointer ptr;
+
+	TEST_ASSERT_EQUALS(ptr.getSize(), 0U);
+	TEST_ASSERT_TRUE(ptr.isInline());
+	TEST_ASSERT_TRUE(ptr.getPointer() != nullptr);
+}
+
+void
+SmartPointerTest::testInline()
+{
+	uint32_t value = 0x12345678;
+	xpcc::SmartPointer ptr(&value);
+
+	TEST_ASSERT_EQUALS(ptr.getSize(), 4U);
+	TEST_ASSERT_TRUE(ptr.isInline());
+	TEST_ASSERT_EQUALS(ptr.get<uint32_t>(), 0x12345678U);
+
+	xpcc::SmartPointer copy(ptr);
+	TEST_ASSERT_TRUE(copy.isInline());
+	TEST_ASSERT_EQUALS(copy.get<uint32_t>(), 0x12345678U);
+
+	// inline copies don't share their data
+	TEST_ASSERT_TRUE(copy.getPointer() != ptr.getPointer());
+
+	uint16_t wrongSize;
+	TEST_ASSERT_FALSE(copy.get(wrongSize));
+
+	uint32_t result = 0;
+	TEST_ASSERT_TRUE(copy.get(result));
+	TEST_ASSERT_EQUALS(result, 0x12345678U);
+
+	xpcc::SmartPointer maximum(xpcc::SmartPointer::InlineSize);
+	TEST_ASSERT_TRUE(maximum.isInline());
+}
+
+void
+SmartPointerTest::testHeap()
+{
+	Large large;
+	for (uint8_t i = 0; i < 8; ++i) {
+		large.values[i] = i * 1000;
+	}
+
+	xpcc::SmartPointer ptr(&large);
+	TEST_ASSERT_EQUALS(ptr.getSize(), sizeof(Large));
+	TEST_ASSERT_FALSE(ptr.isInline());
+	TEST_ASSERT_EQUALS(ptr.get<Large>().values[7], 7000U);
+
+	{
+		xpcc::SmartPointer copy(ptr);
+		TEST_ASSERT_FALSE(copy.isInline());
+
+		// heap copies share the same memory
+		TEST_ASSERT_TRUE(copy.getPointer() == ptr.getPointer());
+	}
+
+	// memory must still be valid after the copy is destroyed
+	TEST_ASSERT_EQUALS(ptr.get<Large>().values[3], 3000U);
+
+	xpcc::SmartPointer minimum(xpcc::SmartPointer::InlineSize + 1);
+	TEST_ASSERT_FALSE(minimum.isInline());
+}
+
+void
+SmartPointerTest::testAssignment()
+{
+	uint8_t small = 42;
+	Large large;
+	large.values[0] = 0xdeadbeef;
+
+	xpcc::SmartPointer a(&small);
+	xpcc::SmartPointer b(&large);
+
+	a = b;
+	TEST_ASSERT_FALSE(a.isInline());
+	TEST_ASSERT_EQUALS(a.get<Large>().values[0], 0xdeadbeefU);
+
+	// self assignment must not release the memory
+	a = a;
+	TEST_ASSERT_EQUALS(a.get<Large>().values[0], 0xdeadbeefU);
+
+	b = xpcc::SmartPointer(&small);
+	TEST_ASSERT_TRUE(b.isInline());
+	TEST_ASSERT_EQUALS(b.get<uint8_t>(), 42);
+	TEST_ASSERT_EQUALS(a.get<Large>().values[0], 0xdeadbeefU);
+
+	a = b;
+	TEST_ASSERT_TRUE(a.isInline());
+	TEST_ASSERT_EQUALS(a.get<uint8_t>(), 42);
+}
+
+void
+SmartPointerTest::testEquality()
+{
+	uint16_t value = 1234;
+	uint16_t other = 4321;
+
+	xpcc::SmartPointer a(&value);
+	xpcc::SmartPointer b(a);
+	xpcc::SmartPointer c(&other);
+
+	TEST_ASSERT_TRUE(a == b);
+	TEST_ASSERT_FALSE(a == c);
+
+	Large large;
+	xpcc::SmartPointer d(&large);
+	xpcc::SmartPointer e(d);
+	xpcc::SmartPointer f(&large);
+
+	TEST_ASSERT_TRUE(d == e);
+	TEST_ASSERT_FALSE(d == f);
+	TEST_ASSERT_FALSE(a == d);
+}
@@ -29,7 +29,10 @@
 // ----------------------------------------------------------------------------
 
 #include "logger/logger.hpp"
+#include "logger/channel.hpp"
 #include "logger/style.hpp"
+#include "logger/deferred.hpp"
+#include "logger/buffered_device.hpp"
 
 /**
 \ingroup	debug
@@ -63,6 +66,35 @@ XPCC_LOG_DEBUG << xpcc::flush;
 \endcode
 TODO check: But remember that without a xpcc::flush your message will not be forwarded.
 
+Where formatting the messages on the target is too slow, the
+\ref xpcc::log::DeferredLogger "DeferredLogger" only stores an id of the
+format string and the raw arguments, which are decoded on the host:
+
+\code
+XPCC_LOG_DEFERRED_DEBUG("i=%d, y=%d", i, y);
+\endcode
+
+The deferred messages can be written from interrupts and threads. This does
+not hold for the text macros: each level is a single global
+\ref xpcc::IOStream "IOStream" which keeps the state of the current message,
+so two contexts writing to it at the same time mix up their output. Use them
+only from the main loop, or use the deferred macros elsewhere. To keep
+the text loggers from waiting for a slow output device, give them a
+\ref xpcc::log::BufferedDevice "BufferedDevice" and drain it to the real
+device in the main loop.
+
+Instead of changing \c XPCC_LOG_LEVEL for a whole file, a module can
+declare its own \ref xpcc::log::Channel "Channel". Messages below the level
+of the channel are removed by the compiler together with their arguments,
+on hosted targets the level can also be changed at runtime:
+
+\code
+XPCC_LOG_CHANNEL(CanLog, xpcc::log::INFO);
+
+XPCC_LOG_CHANNEL_DEBUG(CanLog) << "not even compiled" << expensive();
+XPCC_LOG_CHANNEL_INFO(CanLog) << "rx " << id << xpcc::endl;
+\endcode
+
 \section call_flow Flow of a call
 
 This is to give an estimation how many resources a call of the logger use.
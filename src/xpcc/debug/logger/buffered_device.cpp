@@ -0,0 +1,91 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/io/format.hpp>
+
+#include "buffered_device.hpp"
+
+// ----------------------------------------------------------------------------
+xpcc::log::BufferedDevice::BufferedDevice(void *memory, std::size_t size) :
+	ring(memory, size), reportedDropped(0)
+{
+}
+
+// ----------------------------------------------------------------------------
+void
+xpcc::log::BufferedDevice::write(char c)
+{
+	ring.write(&c, 1);
+}
+
+void
+xpcc::log::BufferedDevice::write(const uint8_t *data, std::size_t length)
+{
+	ring.write(data, length);
+}
+
+void
+xpcc::log::BufferedDevice::writeSegments(const Segment *segments, std::size_t count)
+{
+	std::size_t length = 0;
+	for (std::size_t i = 0; i < count; ++i) {
+		length += segments[i].length;
+	}
+
+	RingBuffer::Writer writer;
+	if (ring.reserve(length, writer))
+	{
+		for (std::size_t i = 0; i < count; ++i) {
+			writer.write(segments[i].data, segments[i].length);
+		}
+		ring.commit(writer);
+	}
+}
+
+void
+xpcc::log::BufferedDevice::flush()
+{
+}
+
+bool
+xpcc::log::BufferedDevice::read(char&)
+{
+	return false;
+}
+
+// ----------------------------------------------------------------------------
+std::size_t
+xpcc::log::BufferedDevice::drain(IODevice& device, std::size_t maxLength)
+{
+	std::size_t written = ring.read(device, maxLength);
+
+	const uint32_t currentDropped = ring.getDroppedChunks();
+	if (currentDropped != reportedDropped and ring.isEmpty())
+	{
+		static const char prefix[] = "\n*** ";
+		static const char suffix[] = " log writes dropped ***\n";
+
+		char buffer[sizeof(prefix) - 1 + 10 + sizeof(suffix)];
+		std::memcpy(buffer, prefix, sizeof(prefix) - 1);
+		char *end = xpcc::format::writeDecimal(buffer + sizeof(prefix) - 1,
+				uint32_t(currentDropped - reportedDropped));
+		std::memcpy(end, suffix, sizeof(suffix) - 1);
+		end += sizeof(suffix) - 1;
+
+		const std::size_t length = end - buffer;
+		if (written + length <= maxLength)
+		{
+			device.write(reinterpret_cast<const uint8_t *>(buffer), length);
+			written += length;
+			reportedDropped = currentDropped;
+		}
+	}
+
+	return written;
+}
@@ -0,0 +1,120 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_LOG__BUFFERED_DEVICE_HPP
+#define XPCC_LOG__BUFFERED_DEVICE_HPP
+
+#include <xpcc/io/iodevice.hpp>
+
+#include "ring_buffer.hpp"
+
+namespace xpcc
+{
+
+namespace log
+{
+
+/**
+ * Non-blocking sink for the text loggers.
+ *
+ * Instead of waiting for the UART or terminal, the output of the loggers
+ * is collected in a lock-free RingBuffer and written to the real device
+ * by drain(), e.g. in the main loop or in a dedicated thread:
+ *
+ * @code
+ * static uint8_t logBuffer[512];
+ * xpcc::log::BufferedDevice logDevice(logBuffer, sizeof(logBuffer));
+ *
+ * xpcc::log::Logger xpcc::log::info(logDevice);
+ *
+ * while (true)
+ * {
+ *     ...
+ *     logDevice.drain(uart);
+ * }
+ * @endcode
+ *
+ * Every block written by the IOStream, i.e. every formatted value, is
+ * stored as one chunk, so output from different contexts is never mixed
+ * within a value. If the buffer is full, the output is dropped and a
+ * line with the number of dropped writes is inserted by the next drain().
+ *
+ * The IOStream of a Logger is not reentrant, use one Logger per context
+ * (e.g. per interrupt priority) on the same BufferedDevice, or the
+ * XPCC_LOG_DEFERRED_* macros, which can be used everywhere.
+ *
+ * @ingroup	logger
+ */
+class BufferedDevice : public IODevice
+{
+public:
+	using IODevice::write;
+	using IODevice::read;
+
+	/**
+	 * @param	memory	Memory used for the ring buffer
+	 * @param	size	Size of the buffer in bytes, must be a power of two
+	 */
+	BufferedDevice(void *memory, std::size_t size);
+
+	virtual void
+	write(char c);
+
+	virtual void
+	write(const uint8_t *data, std::size_t length);
+
+	/// Stores all segments as one chunk
+	virtual void
+	writeSegments(const Segment *segments, std::size_t count);
+
+	/// Does nothing, the data is written by drain()
+	virtual void
+	flush();
+
+	/// Always `false`, the device is write-only
+	virtual bool
+	read(char& c);
+
+	/**
+	 * Write the buffered output to the device.
+	 *
+	 * Must not be called from several contexts at the same time.
+	 *
+	 * @param	maxLength	Write at most this number of bytes
+	 * @return	Number of bytes written
+	 */
+	std::size_t
+	drain(IODevice& device, std::size_t maxLength = std::size_t(-1));
+
+	/// `true` if all output was written to the device
+	inline bool
+	isEmpty() const
+	{
+		return ring.isEmpty();
+	}
+
+	/// Number of writes dropped since the start
+	inline uint32_t
+	getDroppedWrites() const
+	{
+		return ring.getDroppedChunks();
+	}
+
+private:
+	RingBuffer ring;
+
+	// written only by drain()
+	uint32_t reportedDropped;
+};
+
+}	// namespace log
+
+}	// namespace xpcc
+
+#endif	// XPCC_LOG__BUFFERED_DEVICE_HPP
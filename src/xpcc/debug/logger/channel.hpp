@@ -0,0 +1,196 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_LOG__CHANNEL_HPP
+#define XPCC_LOG__CHANNEL_HPP
+
+#include <stdint.h>
+
+#include <xpcc/architecture/detect.hpp>
+
+#include "level.hpp"
+
+#ifndef XPCC_LOG_RUNTIME_LEVEL
+	/**
+	 * Enables the runtime level of the log channels.
+	 *
+	 * Enabled by default on hosted targets, define as `1` in the
+	 * `project.cfg` to enable it on a microcontroller too.
+	 *
+	 * @ingroup	logger
+	 */
+#	ifdef XPCC__OS_HOSTED
+#		define XPCC_LOG_RUNTIME_LEVEL	1
+#	else
+#		define XPCC_LOG_RUNTIME_LEVEL	0
+#	endif
+#endif
+
+#pragma push_macro("ERROR") // avoid collision with ERROR defined macro in winsock.h
+#undef ERROR
+
+namespace xpcc
+{
+
+namespace log
+{
+
+/**
+ * Log channel of a module.
+ *
+ * Every module can declare its own channel with a log level, independent
+ * of the `XPCC_LOG_LEVEL` of the translation unit which includes its
+ * headers:
+ *
+ * @code
+ * // can_driver.hpp
+ * XPCC_LOG_CHANNEL(CanLog, xpcc::log::WARNING);
+ *
+ * // can_driver.cpp
+ * XPCC_LOG_CHANNEL_DEBUG(CanLog) << "rx " << id << xpcc::endl;
+ * XPCC_LOG_CHANNEL_ERROR(CanLog) << "bus off" << xpcc::endl;
+ * XPCC_LOG_DEFERRED_CHANNEL(CanLog, xpcc::log::INFO, "rx id=%x", id);
+ * @endcode
+ *
+ * A message is compiled only if its level is at least the level of the
+ * channel and `XPCC_LOG_LEVEL`. Both are constants, so the compiler
+ * removes all other statements including the evaluation of their
+ * arguments, even without optimization. Verbose messages can therefore
+ * stay in the code of the hot paths.
+ *
+ * With `XPCC_LOG_RUNTIME_LEVEL` (the default on hosted targets) the level
+ * of each channel can be raised and lowered again while the program is
+ * running. Messages below the level of the declaration don't exist in the
+ * program and stay disabled:
+ *
+ * @code
+ * CanLog::setLevel(xpcc::log::ERROR);
+ * @endcode
+ *
+ * @tparam	Name	The channel itself
+ * @tparam	L		Minimum level of the compiled messages
+ *
+ * @ingroup	logger
+ */
+template< typename Name, Level L >
+class Channel
+{
+public:
+	static constexpr Level compiledLevel = L;
+
+	/// Level below which messages are ignored at runtime
+	static inline Level
+	getLevel()
+	{
+#if XPCC_LOG_RUNTIME_LEVEL
+		return static_cast<Level>(__atomic_load_n(&level, __ATOMIC_RELAXED));
+#else
+		return L;
+#endif
+	}
+
+#if XPCC_LOG_RUNTIME_LEVEL
+	/// Levels below the level of the declaration have no effect
+	static inline void
+	setLevel(Level newLevel)
+	{
+		__atomic_store_n(&level, static_cast<uint8_t>(newLevel), __ATOMIC_RELAXED);
+	}
+#endif
+
+	static inline bool
+	isEnabled(Level messageLevel)
+	{
+		return (messageLevel >= getLevel());
+	}
+
+#if XPCC_LOG_RUNTIME_LEVEL
+private:
+	static uint8_t level;
+#endif
+};
+
+#if XPCC_LOG_RUNTIME_LEVEL
+template< typename Name, Level L >
+uint8_t Channel<Name, L>::level = L;
+#endif
+
+}	// namespace log
+
+}	// namespace xpcc
+
+/**
+ * Declare a log channel.
+ *
+ * @param	name	Name of the channel, a struct in the current namespace
+ * @param	level	Minimum level of the compiled messages
+ *
+ * @see		xpcc::log::Channel
+ * @ingroup	logger
+ */
+#define XPCC_LOG_CHANNEL(name, level) \
+	struct name : public ::xpcc::log::Channel< name, (level) > {}
+
+/**
+ * `true` if messages of `level` on the `channel` are written.
+ *
+ * Evaluates to a constant `false` for levels which are not compiled, can
+ * also be used to guard the code which prepares a message:
+ *
+ * @code
+ * if (XPCC_LOG_CHANNEL_ENABLED(CanLog, xpcc::log::DEBUG)) {
+ *     dumpFilters();
+ * }
+ * @endcode
+ *
+ * @ingroup	logger
+ */
+#define XPCC_LOG_CHANNEL_ENABLED(channel, level) \
+	((level) >= XPCC_LOG_LEVEL and (level) >= channel::compiledLevel and \
+	 channel::isEnabled(level))
+
+/**
+ * Output stream for debug messages of a channel
+ * @ingroup	logger
+ */
+#define XPCC_LOG_CHANNEL_DEBUG(channel) \
+	if (not XPCC_LOG_CHANNEL_ENABLED(channel, xpcc::log::DEBUG)){} \
+	else xpcc::log::debug
+
+/// Output stream for info messages of a channel
+/// @ingroup	logger
+#define XPCC_LOG_CHANNEL_INFO(channel) \
+	if (not XPCC_LOG_CHANNEL_ENABLED(channel, xpcc::log::INFO)){} \
+	else xpcc::log::info
+
+/// Output stream for warnings of a channel
+/// @ingroup	logger
+#define XPCC_LOG_CHANNEL_WARNING(channel) \
+	if (not XPCC_LOG_CHANNEL_ENABLED(channel, xpcc::log::WARNING)){} \
+	else xpcc::log::warning
+
+/// Output stream for error messages of a channel
+/// @ingroup	logger
+#define XPCC_LOG_CHANNEL_ERROR(channel) \
+	if (not XPCC_LOG_CHANNEL_ENABLED(channel, xpcc::log::ERROR)){} \
+	else xpcc::log::error
+
+/**
+ * Deferred message of a channel
+ *
+ * @see		xpcc::log::DeferredLogger
+ * @ingroup	logger
+ */
+#define XPCC_LOG_DEFERRED_CHANNEL(channel, level, format, ...) \
+	if (not XPCC_LOG_CHANNEL_ENABLED(channel, level)){} \
+	else XPCC_LOG_DEFERRED_MESSAGE(level, format, ##__VA_ARGS__)
+
+#pragma pop_macro("ERROR")
+
+#endif	// XPCC_LOG__CHANNEL_HPP
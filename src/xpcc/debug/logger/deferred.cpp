@@ -0,0 +1,62 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/architecture/driver/clock.hpp>
+
+#include "deferred.hpp"
+
+// ----------------------------------------------------------------------------
+xpcc::log::DeferredLogger::DeferredLogger(void *memory, std::size_t size) :
+	ring(memory, size), reportedDropped(0)
+{
+}
+
+uint32_t
+xpcc::log::DeferredLogger::getTime()
+{
+	return xpcc::Clock::now().getTime();
+}
+
+// ----------------------------------------------------------------------------
+std::size_t
+xpcc::log::DeferredLogger::flush(IODevice& device, std::size_t maxLength)
+{
+	std::size_t written = ring.read(device, maxLength);
+
+	// dropped messages are only reported between two records
+	const uint32_t currentDropped = ring.getDroppedChunks();
+	if (currentDropped != reportedDropped and ring.isEmpty() and
+		written + 5 <= maxLength)
+	{
+		const uint32_t count = currentDropped - reportedDropped;
+
+		uint8_t record[5];
+		record[0] = binary::DroppedMarker;
+		std::memcpy(record + 1, &count, sizeof(count));
+
+		device.write(record, sizeof(record));
+		written += sizeof(record);
+		reportedDropped = currentDropped;
+	}
+
+	return written;
+}
+
+// ----------------------------------------------------------------------------
+bool
+xpcc::log::DeferredLogger::isEmpty() const
+{
+	return ring.isEmpty();
+}
+
+std::size_t
+xpcc::log::DeferredLogger::getLength() const
+{
+	return ring.getLength();
+}
@@ -0,0 +1,354 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_LOG__DEFERRED_HPP
+#define XPCC_LOG__DEFERRED_HPP
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+
+#include <xpcc/architecture/utils.hpp>
+#include <xpcc/io/iodevice.hpp>
+
+#include "level.hpp"
+#include "ring_buffer.hpp"
+
+namespace xpcc
+{
+
+namespace log
+{
+
+/**
+ * Binary format of the deferred log.
+ *
+ * Every message is written as one record:
+ *
+ * | Bytes | Content                                               |
+ * |-------|-------------------------------------------------------|
+ * | 1     | `RecordMarker` + log level                            |
+ * | 4     | Message id, the FNV-1a hash of the format string      |
+ * | 4     | Timestamp in milliseconds from xpcc::Clock            |
+ * | 1     | Length of the arguments in bytes                      |
+ * | n     | Arguments, each a type code followed by the raw value |
+ *
+ * The type codes are the ones of the Python `struct` module (`b`, `B`,
+ * `h`, `H`, `i`, `I`, `q`, `Q`, `f`, `d`, `?` and `c`). Strings use the
+ * code `s` followed by one length byte and the characters without the
+ * terminating null. All values are little endian.
+ *
+ * If messages had to be dropped, because the buffer was full, a record
+ * consisting of `DroppedMarker` and the number of dropped messages (4
+ * bytes) is inserted into the stream.
+ *
+ * @ingroup	logger
+ */
+namespace binary
+{
+	static constexpr uint8_t RecordMarker = 0xA0;
+	static constexpr uint8_t DroppedMarker = 0xAF;
+
+	/// Marker, id, timestamp and length
+	static constexpr std::size_t HeaderSize = 1 + 4 + 4 + 1;
+
+	/// Maximum length of the arguments of one message
+	static constexpr std::size_t MaxLength = 255;
+
+	/// Longer string arguments are truncated
+	static constexpr std::size_t MaxStringLength = 64;
+
+	/// FNV-1a hash of a string, used as message id
+	constexpr uint32_t
+	hash(const char *str, uint32_t value = 2166136261UL)
+	{
+		return (*str == '\0') ? value :
+				hash(str + 1, (value ^ static_cast<uint8_t>(*str)) * 16777619UL);
+	}
+
+	/// Copies the record into the RingBuffer
+	typedef RingBuffer::Writer Writer;
+
+	/**
+	 * Encoding of one argument.
+	 *
+	 * Only specialized for the supported types, other types (e.g. enums
+	 * or pointers) have to be cast explicitly.
+	 */
+	template< typename T >
+	struct Argument;
+
+	template< std::size_t Size, bool Signed >
+	struct IntegerCode;
+
+	template<> struct IntegerCode<1, true>  { static constexpr char value = 'b'; };
+	template<> struct IntegerCode<1, false> { static constexpr char value = 'B'; };
+	template<> struct IntegerCode<2, true>  { static constexpr char value = 'h'; };
+	template<> struct IntegerCode<2, false> { static constexpr char value = 'H'; };
+	template<> struct IntegerCode<4, true>  { static constexpr char value = 'i'; };
+	template<> struct IntegerCode<4, false> { static constexpr char value = 'I'; };
+	template<> struct IntegerCode<8, true>  { static constexpr char value = 'q'; };
+	template<> struct IntegerCode<8, false> { static constexpr char value = 'Q'; };
+
+	template< typename T, char Code >
+	struct Value
+	{
+		static constexpr std::size_t
+		getSize(const T&)
+		{
+			return 1 + sizeof(T);
+		}
+
+		static xpcc_always_inline void
+		write(Writer& writer, const T& value)
+		{
+			writer.write(static_cast<uint8_t>(Code));
+			writer.write(&value, sizeof(T));
+		}
+	};
+
+	template< typename T >
+	struct Integer : public Value< T, IntegerCode<sizeof(T), (T(-1) < T(0))>::value >
+	{
+	};
+
+	struct String
+	{
+		static inline std::size_t
+		getLength(const char *str)
+		{
+			std::size_t length = 0;
+			while (length < MaxStringLength and str[length] != '\0') {
+				length++;
+			}
+			return length;
+		}
+
+		static inline std::size_t
+		getSize(const char *str)
+		{
+			return 2 + getLength(str);
+		}
+
+		static inline void
+		write(Writer& writer, const char *str)
+		{
+			const std::size_t length = getLength(str);
+			writer.write(static_cast<uint8_t>('s'));
+			writer.write(static_cast<uint8_t>(length));
+			writer.write(str, length);
+		}
+	};
+
+	template<> struct Argument<signed char> : public Integer<signed char> {};
+	template<> struct Argument<unsigned char> : public Integer<unsigned char> {};
+	template<> struct Argument<short> : public Integer<short> {};
+	template<> struct Argument<unsigned short> : public Integer<unsigned short> {};
+	template<> struct Argument<int> : public Integer<int> {};
+	template<> struct Argument<unsigned int> : public Integer<unsigned int> {};
+	template<> struct Argument<long> : public Integer<long> {};
+	template<> struct Argument<unsigned long> : public Integer<unsigned long> {};
+	template<> struct Argument<long long> : public Integer<long long> {};
+	template<> struct Argument<unsigned long long> : public Integer<unsigned long long> {};
+
+	template<> struct Argument<char> : public Value<char, 'c'> {};
+	template<> struct Argument<bool> : public Value<bool, '?'> {};
+	template<> struct Argument<float> : public Value<float, 'f'> {};
+	template<> struct Argument<double> : public Value<double, (sizeof(double) == 4) ? 'f' : 'd'> {};
+
+	template<> struct Argument<char *> : public String {};
+	template<> struct Argument<const char *> : public String {};
+	template< std::size_t N > struct Argument<char[N]> : public String {};
+
+	inline std::size_t
+	getSize()
+	{
+		return 0;
+	}
+
+	template< typename T, typename... Args >
+	xpcc_always_inline std::size_t
+	getSize(const T& value, const Args&... args)
+	{
+		return Argument<T>::getSize(value) + getSize(args...);
+	}
+
+	inline void
+	write(Writer&)
+	{
+	}
+
+	template< typename T, typename... Args >
+	xpcc_always_inline void
+	write(Writer& writer, const T& value, const Args&... args)
+	{
+		Argument<T>::write(writer, value);
+		write(writer, args...);
+	}
+}	// namespace binary
+
+/**
+ * Deferred binary logger.
+ *
+ * Instead of formatting the message on the target, only an id of the
+ * format string, a timestamp and the raw bytes of the arguments are copied
+ * into a ring buffer. The format strings are not even part of the program,
+ * the id is a hash of the string calculated by the compiler. Writing a
+ * message therefore takes only a few dozen cycles and typically a third
+ * to a tenth of the bytes of the formatted text.
+ *
+ * The buffer is drained to an IODevice by calling flush(), e.g. in the
+ * main loop or in a low priority thread, and decoded on the host with
+ * `tools/logger/logger.py`:
+ *
+ * @code
+ * static uint8_t logBuffer[1024];
+ * xpcc::log::DeferredLogger xpcc::log::deferred(logBuffer, sizeof(logBuffer));
+ *
+ * XPCC_LOG_DEFERRED_INFO("motor %d: current=%u mA", id, current);
+ * XPCC_LOG_DEFERRED_WARNING("calibration failed");
+ *
+ * while (true)
+ * {
+ *     ...
+ *     xpcc::log::deferred.flush(uart);
+ * }
+ * @endcode
+ *
+ * The formats follow `printf()`, but the type of each argument is
+ * transmitted, so `%d` works for every integer type and the length
+ * modifiers (`l`, `ll`) are optional. The format must be a string
+ * literal. The build collects all of them from the sources into a
+ * dictionary (`scons logdict`), which the decoder needs:
+ *
+ * @code
+ * $ python tools/logger/logger.py decode <buildpath>/project.logdict /dev/ttyUSB0
+ * @endcode
+ *
+ * Messages can be written from any context, including interrupts of
+ * different priority and several threads, the messages are stored in a
+ * lock-free RingBuffer. Writing never blocks: if a message doesn't fit, it
+ * is dropped and the number of dropped messages is written to the stream
+ * with the next flush(). Only flush() must not be called from several
+ * contexts at the same time.
+ *
+ * @see		binary
+ * @ingroup	logger
+ */
+class DeferredLogger
+{
+public:
+	/**
+	 * @param	memory	Memory used for the ring buffer
+	 * @param	size	Size of the buffer in bytes, must be a power of two
+	 */
+	DeferredLogger(void *memory, std::size_t size);
+
+	/**
+	 * Write a message.
+	 *
+	 * Use the XPCC_LOG_DEFERRED_* macros instead, which calculate the id.
+	 *
+	 * @return	`false` if the message was dropped
+	 */
+	template< uint32_t Id, typename... Args >
+	bool
+	log(Level level, const Args&... args);
+
+	/**
+	 * Write the buffered messages to the device.
+	 *
+	 * @param	maxLength	Write at most this number of bytes, the
+	 * 						rest is written by the next call.
+	 * @return	Number of bytes written
+	 */
+	std::size_t
+	flush(IODevice& device, std::size_t maxLength = std::size_t(-1));
+
+	bool
+	isEmpty() const;
+
+	/// Number of bytes used in the buffer, including the chunk headers
+	/// of the RingBuffer
+	std::size_t
+	getLength() const;
+
+	/// Number of messages dropped since the start
+	inline uint32_t
+	getDroppedMessages() const
+	{
+		return ring.getDroppedChunks();
+	}
+
+private:
+	DeferredLogger(const DeferredLogger&);
+
+	DeferredLogger&
+	operator = (const DeferredLogger&);
+
+	static uint32_t
+	getTime();
+
+	RingBuffer ring;
+
+	// written only by flush()
+	uint32_t reportedDropped;
+};
+
+/**
+ * Instance used by the XPCC_LOG_DEFERRED_* macros.
+ *
+ * Has to be defined by the application, see DeferredLogger.
+ *
+ * @ingroup	logger
+ */
+extern DeferredLogger deferred;
+
+}	// namespace log
+
+}	// namespace xpcc
+
+#define XPCC_LOG_DEFERRED_MESSAGE(level, format, ...) \
+	xpcc::log::deferred.log< xpcc::log::binary::hash(format) >(level, ##__VA_ARGS__)
+
+/**
+ * Deferred debug message
+ *
+ * @code
+ * XPCC_LOG_DEFERRED_DEBUG("value=%d", value);
+ * @endcode
+ *
+ * @see		xpcc::log::DeferredLogger
+ * @ingroup	logger
+ */
+#define XPCC_LOG_DEFERRED_DEBUG(format, ...) \
+	if (XPCC_LOG_LEVEL > xpcc::log::DEBUG){} \
+	else XPCC_LOG_DEFERRED_MESSAGE(xpcc::log::DEBUG, format, ##__VA_ARGS__)
+
+/// Deferred info message
+/// @ingroup	logger
+#define XPCC_LOG_DEFERRED_INFO(format, ...) \
+	if (XPCC_LOG_LEVEL > xpcc::log::INFO){} \
+	else XPCC_LOG_DEFERRED_MESSAGE(xpcc::log::INFO, format, ##__VA_ARGS__)
+
+/// Deferred warning
+/// @ingroup	logger
+#define XPCC_LOG_DEFERRED_WARNING(format, ...) \
+	if (XPCC_LOG_LEVEL > xpcc::log::WARNING){} \
+	else XPCC_LOG_DEFERRED_MESSAGE(xpcc::log::WARNING, format, ##__VA_ARGS__)
+
+/// Deferred error message
+/// @ingroup	logger
+#define XPCC_LOG_DEFERRED_ERROR(format, ...) \
+	if (XPCC_LOG_LEVEL > xpcc::log::ERROR){} \
+	else XPCC_LOG_DEFERRED_MESSAGE(xpcc::log::ERROR, format, ##__VA_ARGS__)
+
+#include "deferred_impl.hpp"
+
+#endif	// XPCC_LOG__DEFERRED_HPP
@@ -0,0 +1,43 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_LOG__DEFERRED_HPP
+#	error	"Don't include this file directly, use 'deferred.hpp' instead!"
+#endif
+
+template< uint32_t Id, typename... Args >
+bool
+xpcc::log::DeferredLogger::log(Level level, const Args&... args)
+{
+	const std::size_t length = binary::getSize(args...);
+	if (length > binary::MaxLength)
+	{
+		ring.drop();
+		return false;
+	}
+
+	binary::Writer writer;
+	if (not ring.reserve(binary::HeaderSize + length, writer)) {
+		return false;
+	}
+
+	writer.write(static_cast<uint8_t>(binary::RecordMarker + level));
+
+	const uint32_t id = Id;
+	writer.write(&id, sizeof(id));
+
+	const uint32_t time = getTime();
+	writer.write(&time, sizeof(time));
+
+	writer.write(static_cast<uint8_t>(length));
+	binary::write(writer, args...);
+
+	ring.commit(writer);
+	return true;
+}
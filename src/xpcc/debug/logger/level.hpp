@@ -67,6 +67,9 @@ namespace xpcc
 	 * 
 	 * DEBUG < INFO < WARNING < ERROR < DISABLED
 	 * 
+	 * Don't change the level in a header, it would affect every file
+	 * including it. Declare a xpcc::log::Channel for the module instead.
+	 * 
 	 * \ingroup logger
 	 */
 	#define XPCC_LOG_LEVEL xpcc::log::DEBUG
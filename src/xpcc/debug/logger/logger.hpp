@@ -54,6 +54,10 @@ namespace xpcc
 		 * the shift-operator so that it is possible to write different
 		 * message types to the logger.
 		 * 
+		 * The stream keeps the state of the current message, so a Logger
+		 * must only be used from one context at a time. In interrupts and
+		 * threads use the XPCC_LOG_DEFERRED_* macros instead.
+		 * 
 		 * \ingroup logger
 		 * \author	Martin Rosekeit <martin.rosekeit@rwth-aachen.de>
 		 */
@@ -0,0 +1,216 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/architecture/detect.hpp>
+#include <xpcc/architecture/interface/assert.hpp>
+
+#include "ring_buffer.hpp"
+
+#if defined(XPCC__CPU_AVR) || defined(XPCC__CPU_CORTEX_M0)
+#	include <xpcc/architecture/driver/atomic/lock.hpp>
+	// no compare-and-swap instruction available
+#	define XPCC_LOG_RING_BUFFER_LOCK	1
+#endif
+
+namespace
+{
+	// first byte of the header of a committed chunk, the reader clears the
+	// header after reading the chunk
+	constexpr uint8_t Committed = 0xC5;
+
+	inline std::size_t
+	getChunkSize(std::size_t length)
+	{
+		return (xpcc::log::RingBuffer::HeaderSize + length + 3) & ~std::size_t(3);
+	}
+}
+
+// ----------------------------------------------------------------------------
+xpcc::log::RingBuffer::RingBuffer(void *memory, std::size_t size) :
+	buffer(static_cast<uint8_t *>(memory)), mask(size - 1),
+	head(0), tail(0), readOffset(0), dropped(0)
+{
+	xpcc_assert(size >= 8 and (size & (size - 1)) == 0,
+			"log", "ring", "size", size);
+	std::memset(buffer, 0, size);
+}
+
+// ----------------------------------------------------------------------------
+bool
+xpcc::log::RingBuffer::reserve(std::size_t length, Writer& writer)
+{
+	const std::size_t size = getChunkSize(length);
+	if (length > MaxLength or size > mask + 1)
+	{
+		drop();
+		return false;
+	}
+
+	std::size_t start;
+#ifdef XPCC_LOG_RING_BUFFER_LOCK
+	{
+		atomic::Lock lock;
+
+		start = head;
+		if (size > mask + 1 - (start - tail))
+		{
+			dropped++;
+			return false;
+		}
+		head = start + size;
+	}
+#else
+	start = __atomic_load_n(&head, __ATOMIC_RELAXED);
+	do {
+		// the reader has cleared everything up to the tail
+		const std::size_t currentTail = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+		if (size > mask + 1 - (start - currentTail))
+		{
+			drop();
+			return false;
+		}
+	} while (not __atomic_compare_exchange_n(&head, &start, start + size,
+			true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+#endif
+
+	writer.buffer = buffer;
+	writer.mask = mask;
+	writer.start = start;
+	writer.position = start + HeaderSize;
+	writer.length = length;
+	return true;
+}
+
+void
+xpcc::log::RingBuffer::commit(const Writer& writer)
+{
+	// the header never wraps around, chunks are aligned to four bytes
+	uint8_t *header = buffer + (writer.start & mask);
+	header[2] = writer.length;
+	header[3] = writer.length >> 8;
+
+	__atomic_store_n(&header[0], Committed, __ATOMIC_RELEASE);
+}
+
+bool
+xpcc::log::RingBuffer::write(const void *data, std::size_t length)
+{
+	Writer writer;
+	if (not reserve(length, writer)) {
+		return false;
+	}
+	writer.write(data, length);
+	commit(writer);
+	return true;
+}
+
+void
+xpcc::log::RingBuffer::drop()
+{
+#ifdef XPCC_LOG_RING_BUFFER_LOCK
+	atomic::Lock lock;
+	dropped++;
+#else
+	__atomic_fetch_add(&dropped, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+std::size_t
+xpcc::log::RingBuffer::read(IODevice& device, std::size_t maxLength)
+{
+	std::size_t written = 0;
+	while (written < maxLength)
+	{
+		uint8_t *header = buffer + (tail & mask);
+		if (__atomic_load_n(&header[0], __ATOMIC_ACQUIRE) != Committed) {
+			// empty or the next chunk is still being written
+			break;
+		}
+		const std::size_t length = header[2] | (header[3] << 8);
+
+		std::size_t count = length - readOffset;
+		if (count > maxLength - written) {
+			count = maxLength - written;
+		}
+
+		// data of the chunk, which might wrap around
+		if (count > 0)
+		{
+			const std::size_t index = (tail + HeaderSize + readOffset) & mask;
+			const std::size_t first = mask + 1 - index;
+			if (count <= first) {
+				device.write(buffer + index, count);
+			}
+			else {
+				device.write(buffer + index, first);
+				device.write(buffer, count - first);
+			}
+			written += count;
+			readOffset += count;
+		}
+
+		if (readOffset < length) {
+			break;
+		}
+
+		// clear the chunk, so that a new header at any position of the
+		// chunk doesn't look committed before it is
+		const std::size_t size = getChunkSize(length);
+		const std::size_t index = tail & mask;
+		const std::size_t first = mask + 1 - index;
+		if (size <= first) {
+			std::memset(buffer + index, 0, size);
+		}
+		else {
+			std::memset(buffer + index, 0, first);
+			std::memset(buffer, 0, size - first);
+		}
+		readOffset = 0;
+
+#ifdef XPCC_LOG_RING_BUFFER_LOCK
+		atomic::Lock lock;
+		__asm__ volatile ("" ::: "memory");
+		tail += size;
+#else
+		__atomic_store_n(&tail, tail + size, __ATOMIC_RELEASE);
+#endif
+	}
+	return written;
+}
+
+// ----------------------------------------------------------------------------
+bool
+xpcc::log::RingBuffer::isEmpty() const
+{
+	return (getLength() == 0);
+}
+
+std::size_t
+xpcc::log::RingBuffer::getLength() const
+{
+#ifdef XPCC_LOG_RING_BUFFER_LOCK
+	atomic::Lock lock;
+	return head - tail;
+#else
+	const std::size_t currentTail = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+	return __atomic_load_n(&head, __ATOMIC_ACQUIRE) - currentTail;
+#endif
+}
+
+uint32_t
+xpcc::log::RingBuffer::getDroppedChunks() const
+{
+#ifdef XPCC_LOG_RING_BUFFER_LOCK
+	atomic::Lock lock;
+	return dropped;
+#else
+	return __atomic_load_n(&dropped, __ATOMIC_RELAXED);
+#endif
+}
@@ -0,0 +1,174 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_LOG__RING_BUFFER_HPP
+#define XPCC_LOG__RING_BUFFER_HPP
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+
+#include <xpcc/architecture/utils.hpp>
+#include <xpcc/io/iodevice.hpp>
+
+namespace xpcc
+{
+
+namespace log
+{
+
+/**
+ * Lock-free ring buffer with several writers and one reader.
+ *
+ * Data is written in chunks: a writer reserves space for the whole chunk,
+ * copies the data and commits the chunk. Several writers, e.g. the main
+ * loop, interrupts of different priority or threads, can do this at the
+ * same time without waiting for each other. The reader outputs the chunks
+ * in the order of their reservation, but never a partially written one.
+ * Chunks which don't fit into the buffer are dropped and counted, writing
+ * never blocks.
+ *
+ * On hosted targets and Cortex-M3 and above the space is reserved with an
+ * atomic compare-and-swap. The AVR and Cortex-M0 don't have such an
+ * instruction, there interrupts are disabled for the few cycles of the
+ * reservation.
+ *
+ * Each chunk has a header of four bytes and is padded to a multiple of
+ * four bytes.
+ *
+ * @ingroup	logger
+ */
+class RingBuffer
+{
+public:
+	static constexpr std::size_t HeaderSize = 4;
+
+	/// Maximum length of a single chunk
+	static constexpr std::size_t MaxLength = 0xffff;
+
+	/// Writes the data of one chunk into the buffer
+	class Writer
+	{
+	public:
+		Writer() :
+			buffer(0), mask(0), start(0), position(0), length(0)
+		{
+		}
+
+		xpcc_always_inline void
+		write(const void *data, std::size_t size)
+		{
+			const uint8_t *ptr = static_cast<const uint8_t *>(data);
+			const std::size_t index = position & mask;
+			const std::size_t first = mask + 1 - index;
+			if (size <= first) {
+				std::memcpy(buffer + index, ptr, size);
+			}
+			else {
+				std::memcpy(buffer + index, ptr, first);
+				std::memcpy(buffer, ptr + first, size - first);
+			}
+			position += size;
+		}
+
+		xpcc_always_inline void
+		write(uint8_t value)
+		{
+			buffer[position & mask] = value;
+			position++;
+		}
+
+	private:
+		friend class RingBuffer;
+
+		uint8_t *buffer;
+		std::size_t mask;
+		std::size_t start;
+		std::size_t position;
+		std::size_t length;
+	};
+
+public:
+	/**
+	 * @param	memory	Memory used for the buffer
+	 * @param	size	Size of the memory in bytes, must be a power of two
+	 */
+	RingBuffer(void *memory, std::size_t size);
+
+	/**
+	 * Reserve space for a chunk of `length` bytes.
+	 *
+	 * The data has to be written with the `writer` and committed with
+	 * commit() afterwards, the following chunks are not read before.
+	 *
+	 * @return	`false` if the chunk doesn't fit, it is counted as dropped
+	 */
+	bool
+	reserve(std::size_t length, Writer& writer);
+
+	/// Make the chunk available to the reader
+	void
+	commit(const Writer& writer);
+
+	/// Reserve, write and commit a chunk
+	bool
+	write(const void *data, std::size_t length);
+
+	/// Count a chunk as dropped, which the caller didn't even try to write
+	void
+	drop();
+
+	/**
+	 * Write the committed chunks to the device.
+	 *
+	 * Only one context may read at a time.
+	 *
+	 * @param	maxLength	Write at most this number of bytes, the
+	 * 						rest is written by the next call.
+	 * @return	Number of bytes written
+	 */
+	std::size_t
+	read(IODevice& device, std::size_t maxLength = std::size_t(-1));
+
+	/// `true` if all chunks were read completely
+	bool
+	isEmpty() const;
+
+	/// Number of bytes used by the reserved chunks, including their headers
+	std::size_t
+	getLength() const;
+
+	/// Number of chunks dropped since the start
+	uint32_t
+	getDroppedChunks() const;
+
+private:
+	RingBuffer(const RingBuffer&);
+
+	RingBuffer&
+	operator = (const RingBuffer&);
+
+	uint8_t *const buffer;
+	const std::size_t mask;
+
+	// free-running positions, the index is (position & mask)
+	std::size_t head;
+	std::size_t tail;
+
+	// bytes of the current chunk already read
+	std::size_t readOffset;
+
+	uint32_t dropped;
+};
+
+}	// namespace log
+
+}	// namespace xpcc
+
+#endif	// XPCC_LOG__RING_BUFFER_HPP
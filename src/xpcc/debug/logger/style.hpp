@@ -69,6 +69,14 @@ namespace xpcc
 				(void) s;
 			}
 
+			/// Write a block of data to the sink.
+			inline void
+			write( const uint8_t* data, std::size_t length )
+			{
+				(void) data;
+				(void) length;
+			}
+
 			/// The message is complete and can be written/send/displayed.
 			inline void
 			flush()
@@ -117,6 +125,10 @@ namespace xpcc
 			inline void
 			write( const char* s );
 
+			/// Write a block of data to the sink.
+			inline void
+			write( const uint8_t* data, std::size_t length );
+
 			/// The message is complete and can be written/send/displayed.
 			inline void
 			flush();
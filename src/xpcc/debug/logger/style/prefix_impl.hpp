@@ -72,6 +72,17 @@ xpcc::log::Prefix<T, STYLE>::write( const char* s )
 	this->Style<STYLE>::write( s );
 }
 
+template <typename T, typename STYLE>
+void
+xpcc::log::Prefix<T, STYLE>::write( const uint8_t* data, std::size_t length )
+{
+	if( this->flushed ) {
+		this->flushed = false;
+		this->Style<STYLE>::write( this->value );
+	}
+	this->Style<STYLE>::write( data, length );
+}
+
 // ----------------------------------------------------------------------------
 template <typename T, typename STYLE>
 void
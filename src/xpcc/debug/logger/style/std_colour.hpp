@@ -82,6 +82,10 @@ namespace xpcc
 			void
 			write( const char* s );
 
+			/// Write a block of data to the sink, coloured only once.
+			void
+			write( const uint8_t* data, std::size_t length );
+
 			/// The message is complete and can be written/send/displayed.
 			void
 			flush();
@@ -79,6 +79,15 @@ xpcc::log::StdColour<TEXT, BACKGROUND, STYLE>::write( const char* s )
 	this->Style<STYLE>::write(s);
 }
 
+template <xpcc::log::Colour TEXT, xpcc::log::Colour BACKGROUND, typename STYLE>
+void
+xpcc::log::StdColour<TEXT, BACKGROUND, STYLE>::write( const uint8_t* data, std::size_t length )
+{
+	this->Style<STYLE>::write(this->getTextColour());
+	this->Style<STYLE>::write(this->getBackgroundColour());
+	this->Style<STYLE>::write(data, length);
+}
+
 // ----------------------------------------------------------------------------
 
 template <xpcc::log::Colour TEXT, xpcc::log::Colour BACKGROUND, typename STYLE>
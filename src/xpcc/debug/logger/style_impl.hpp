@@ -94,6 +94,20 @@ xpcc::log::Style<STYLE>::write( const char* s )
 
 // -----------------------------------------------------------------------------
 
+template < typename STYLE >
+void
+xpcc::log::Style<STYLE>::write( const uint8_t* data, std::size_t length )
+{
+	if ( tmp::SameType<STYLE, DefaultStyle>::value ) {
+		this->device->write( data, length );
+	}
+	else {
+		this->style.write( data, length );
+	}
+}
+
+// -----------------------------------------------------------------------------
+
 template < typename STYLE >
 void
 xpcc::log::Style<STYLE>::flush()
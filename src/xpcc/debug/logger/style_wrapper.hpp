@@ -57,12 +57,20 @@ namespace xpcc
 			virtual void
 			write(const char* str);
 
+			/// Forwards the whole block, so that it is styled only once
+			virtual void
+			write(const uint8_t* data, std::size_t length);
+
+			using IODevice::write;
+
 			virtual void
 			flush();
 
 			virtual bool
 			read(char&);
 
+			using IODevice::read;
+
 		private :
 			StyleWrapper( const StyleWrapper& );
 
@@ -109,6 +117,15 @@ xpcc::log::StyleWrapper<STYLE>::write( const char* s )
 
 // -----------------------------------------------------------------------------
 
+template < typename STYLE >
+void
+xpcc::log::StyleWrapper<STYLE>::write( const uint8_t* data, std::size_t length )
+{
+	this->style.write( data, length );
+}
+
+// -----------------------------------------------------------------------------
+
 template < typename STYLE >
 void
 xpcc::log::StyleWrapper<STYLE>::flush()
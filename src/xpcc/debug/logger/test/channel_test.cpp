@@ -0,0 +1,93 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/debug/logger/channel.hpp>
+
+#include "channel_test.hpp"
+
+#undef	XPCC_LOG_LEVEL
+#define	XPCC_LOG_LEVEL xpcc::log::INFO
+
+namespace
+{
+	XPCC_LOG_CHANNEL(VerboseLog, xpcc::log::DEBUG);
+	XPCC_LOG_CHANNEL(QuietLog, xpcc::log::WARNING);
+	XPCC_LOG_CHANNEL(RuntimeLog, xpcc::log::INFO);
+
+	int evaluated = 0;
+
+	int
+	argument()
+	{
+		return ++evaluated;
+	}
+}
+
+// ----------------------------------------------------------------------------
+void
+ChannelTest::testCompiledLevel()
+{
+	TEST_ASSERT_FALSE(XPCC_LOG_CHANNEL_ENABLED(QuietLog, xpcc::log::INFO));
+	TEST_ASSERT_TRUE(XPCC_LOG_CHANNEL_ENABLED(QuietLog, xpcc::log::WARNING));
+	TEST_ASSERT_TRUE(XPCC_LOG_CHANNEL_ENABLED(QuietLog, xpcc::log::ERROR));
+
+	// constant expression for the disabled levels
+	static_assert(not XPCC_LOG_CHANNEL_ENABLED(QuietLog, xpcc::log::INFO),
+			"INFO must be removed at compile time");
+}
+
+void
+ChannelTest::testFileLevel()
+{
+	// XPCC_LOG_LEVEL of this file is INFO
+	TEST_ASSERT_FALSE(XPCC_LOG_CHANNEL_ENABLED(VerboseLog, xpcc::log::DEBUG));
+	TEST_ASSERT_TRUE(XPCC_LOG_CHANNEL_ENABLED(VerboseLog, xpcc::log::INFO));
+}
+
+void
+ChannelTest::testArguments()
+{
+	evaluated = 0;
+
+	if (not XPCC_LOG_CHANNEL_ENABLED(QuietLog, xpcc::log::DEBUG)){}
+	else argument();
+	if (not XPCC_LOG_CHANNEL_ENABLED(QuietLog, xpcc::log::INFO)){}
+	else argument();
+	TEST_ASSERT_EQUALS(evaluated, 0);
+
+	if (not XPCC_LOG_CHANNEL_ENABLED(QuietLog, xpcc::log::ERROR)){}
+	else argument();
+	TEST_ASSERT_EQUALS(evaluated, 1);
+}
+
+void
+ChannelTest::testRuntimeLevel()
+{
+#if XPCC_LOG_RUNTIME_LEVEL
+	TEST_ASSERT_EQUALS(RuntimeLog::getLevel(), xpcc::log::INFO);
+	TEST_ASSERT_TRUE(XPCC_LOG_CHANNEL_ENABLED(RuntimeLog, xpcc::log::INFO));
+
+	RuntimeLog::setLevel(xpcc::log::ERROR);
+	TEST_ASSERT_FALSE(XPCC_LOG_CHANNEL_ENABLED(RuntimeLog, xpcc::log::INFO));
+	TEST_ASSERT_FALSE(XPCC_LOG_CHANNEL_ENABLED(RuntimeLog, xpcc::log::WARNING));
+	TEST_ASSERT_TRUE(XPCC_LOG_CHANNEL_ENABLED(RuntimeLog, xpcc::log::ERROR));
+
+	// the other channels are not affected
+	TEST_ASSERT_TRUE(XPCC_LOG_CHANNEL_ENABLED(VerboseLog, xpcc::log::INFO));
+
+	// messages below the compiled level can't be enabled
+	RuntimeLog::setLevel(xpcc::log::DEBUG);
+	TEST_ASSERT_FALSE(XPCC_LOG_CHANNEL_ENABLED(RuntimeLog, xpcc::log::DEBUG));
+	TEST_ASSERT_TRUE(XPCC_LOG_CHANNEL_ENABLED(RuntimeLog, xpcc::log::INFO));
+
+	RuntimeLog::setLevel(xpcc::log::INFO);
+#else
+	TEST_ASSERT_EQUALS(RuntimeLog::getLevel(), xpcc::log::INFO);
+#endif
+}
@@ -0,0 +1,157 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/debug/logger/deferred.hpp>
+#include <xpcc/architecture/driver/test/testing_clock.hpp>
+#include <xpcc/io/test/memory_writer.hpp>
+
+#include "deferred_logger_test.hpp"
+
+#undef	XPCC_LOG_LEVEL
+#define	XPCC_LOG_LEVEL xpcc::log::INFO
+
+namespace
+{
+	uint8_t logBuffer[64];
+
+	MemoryWriter device;
+}
+
+xpcc::log::DeferredLogger xpcc::log::deferred(logBuffer, sizeof(logBuffer));
+
+// ----------------------------------------------------------------------------
+void
+DeferredLoggerTest::setUp()
+{
+	// discard messages of previous tests
+	xpcc::log::deferred.flush(device);
+	device.clear();
+
+	TestingClock::time = 0x12345678;
+}
+
+void
+DeferredLoggerTest::testHash()
+{
+	// reference values of FNV-1a
+	TEST_ASSERT_EQUALS(xpcc::log::binary::hash(""), 0x811c9dc5UL);
+	TEST_ASSERT_EQUALS(xpcc::log::binary::hash("a"), 0xe40c292cUL);
+	TEST_ASSERT_EQUALS(xpcc::log::binary::hash("foobar"), 0xbf9cf968UL);
+}
+
+void
+DeferredLoggerTest::testRecord()
+{
+	TEST_ASSERT_TRUE(xpcc::log::deferred.isEmpty());
+
+	// record and chunk header, padded to 16 bytes
+	XPCC_LOG_DEFERRED_WARNING("foobar");
+	TEST_ASSERT_EQUALS(xpcc::log::deferred.getLength(), 16U);
+
+	// below XPCC_LOG_LEVEL, not even evaluated
+	XPCC_LOG_DEFERRED_DEBUG("debug");
+	TEST_ASSERT_EQUALS(xpcc::log::deferred.getLength(), 16U);
+
+	TEST_ASSERT_EQUALS(xpcc::log::deferred.flush(device), 10U);
+	TEST_ASSERT_TRUE(xpcc::log::deferred.isEmpty());
+
+	const uint8_t expected[] = {
+		0xA2,
+		0x68, 0xf9, 0x9c, 0xbf,
+		0x78, 0x56, 0x34, 0x12,
+		0 };
+	TEST_ASSERT_EQUALS(device.bytesWritten, 10U);
+	TEST_ASSERT_EQUALS_ARRAY(expected, device.buffer, 10);
+}
+
+void
+DeferredLoggerTest::testArguments()
+{
+	XPCC_LOG_DEFERRED_INFO("%d %u %d %s %c %s",
+			int8_t(-2), uint16_t(0x1234), int32_t(-1), "ab", 'x', true ? "cde" : "");
+	xpcc::log::deferred.flush(device);
+
+	const uint8_t expected[] = {
+		0xA1,
+		0, 0, 0, 0,			// id, not checked
+		0x78, 0x56, 0x34, 0x12,
+		21,
+		'b', 0xfe,
+		'H', 0x34, 0x12,
+		'i', 0xff, 0xff, 0xff, 0xff,
+		's', 2, 'a', 'b',
+		'c', 'x',
+		's', 3, 'c', 'd', 'e' };
+	TEST_ASSERT_EQUALS(device.bytesWritten, sizeof(expected));
+	TEST_ASSERT_EQUALS_ARRAY(expected, device.buffer, 1);
+	TEST_ASSERT_EQUALS_ARRAY(expected + 5, device.buffer + 5, sizeof(expected) - 5);
+
+	device.clear();
+	XPCC_LOG_DEFERRED_ERROR("%f", 1.5f);
+	xpcc::log::deferred.flush(device);
+
+	const uint8_t expectedFloat[] = { 5, 'f', 0x00, 0x00, 0xc0, 0x3f };
+	TEST_ASSERT_EQUALS(device.bytesWritten, 15U);
+	TEST_ASSERT_EQUALS(device.buffer[0], 0xA3);
+	TEST_ASSERT_EQUALS_ARRAY(expectedFloat, device.buffer + 9, sizeof(expectedFloat));
+}
+
+void
+DeferredLoggerTest::testWrapAround()
+{
+	// records of 15 bytes use chunks of 20 bytes, after 16 records every
+	// position in the 64 byte buffer was used once
+	for (uint8_t ii = 0; ii < 16; ++ii)
+	{
+		TEST_ASSERT_TRUE(XPCC_LOG_DEFERRED_MESSAGE(xpcc::log::INFO, "%d", int32_t(ii)));
+		TEST_ASSERT_EQUALS(xpcc::log::deferred.flush(device), 15U);
+		TEST_ASSERT_EQUALS(device.buffer[(ii * 15) + 11], ii);
+	}
+
+	// at least one record was written in two parts
+	TEST_ASSERT_TRUE(device.blockWrites > 16);
+	TEST_ASSERT_EQUALS(device.bytesWritten, 240U);
+}
+
+void
+DeferredLoggerTest::testDropped()
+{
+	const uint32_t dropped = xpcc::log::deferred.getDroppedMessages();
+
+	// three chunks of 20 bytes fit into 64 bytes
+	uint8_t written = 0;
+	for (uint8_t ii = 0; ii < 6; ++ii) {
+		written += XPCC_LOG_DEFERRED_MESSAGE(xpcc::log::INFO, "%d", int32_t(ii));
+	}
+	TEST_ASSERT_EQUALS(written, 3);
+	TEST_ASSERT_EQUALS(xpcc::log::deferred.getDroppedMessages(), dropped + 3);
+
+	TEST_ASSERT_EQUALS(xpcc::log::deferred.flush(device), 3U * 15U + 5U);
+
+	const uint8_t expected[] = { 0xAF, 3, 0, 0, 0 };
+	TEST_ASSERT_EQUALS_ARRAY(expected, device.buffer + 45, 5);
+
+	// reported only once
+	device.clear();
+	TEST_ASSERT_EQUALS(xpcc::log::deferred.flush(device), 0U);
+}
+
+void
+DeferredLoggerTest::testPartialFlush()
+{
+	XPCC_LOG_DEFERRED_INFO("%d", int32_t(7));
+	XPCC_LOG_DEFERRED_INFO("%d", int32_t(8));
+
+	// the second chunk is freed after it was read completely
+	TEST_ASSERT_EQUALS(xpcc::log::deferred.flush(device, 20), 20U);
+	TEST_ASSERT_EQUALS(xpcc::log::deferred.getLength(), 20U);
+	TEST_ASSERT_EQUALS(xpcc::log::deferred.flush(device, 20), 10U);
+	TEST_ASSERT_EQUALS(device.bytesWritten, 30U);
+	TEST_ASSERT_EQUALS(device.buffer[26], 8);
+}
@@ -0,0 +1,170 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/debug/logger/ring_buffer.hpp>
+#include <xpcc/debug/logger/buffered_device.hpp>
+#include <xpcc/io/test/memory_writer.hpp>
+
+#include "ring_buffer_test.hpp"
+
+namespace
+{
+	MemoryWriter device;
+	uint8_t memory[32];
+}
+
+// ----------------------------------------------------------------------------
+void
+RingBufferTest::setUp()
+{
+	device.clear();
+}
+
+void
+RingBufferTest::testChunks()
+{
+	xpcc::log::RingBuffer ring(memory, sizeof(memory));
+	TEST_ASSERT_TRUE(ring.isEmpty());
+
+	// header of four bytes, padded to a multiple of four
+	TEST_ASSERT_TRUE(ring.write("abc", 3));
+	TEST_ASSERT_EQUALS(ring.getLength(), 8U);
+	TEST_ASSERT_TRUE(ring.write("defgh", 5));
+	TEST_ASSERT_EQUALS(ring.getLength(), 20U);
+
+	TEST_ASSERT_EQUALS(ring.read(device), 8U);
+	TEST_ASSERT_TRUE(ring.isEmpty());
+	TEST_ASSERT_EQUALS(device.bytesWritten, 8U);
+	TEST_ASSERT_EQUALS_ARRAY("abcdefgh", device.buffer, 8);
+	TEST_ASSERT_EQUALS(device.blockWrites, 2U);
+
+	// empty chunks are allowed
+	TEST_ASSERT_TRUE(ring.write("", 0));
+	TEST_ASSERT_EQUALS(ring.getLength(), 4U);
+	TEST_ASSERT_EQUALS(ring.read(device), 0U);
+	TEST_ASSERT_TRUE(ring.isEmpty());
+}
+
+void
+RingBufferTest::testWrapAround()
+{
+	xpcc::log::RingBuffer ring(memory, sizeof(memory));
+
+	// chunks of 12 bytes, the data wraps around at different positions
+	for (uint8_t ii = 0; ii < 16; ++ii)
+	{
+		const uint8_t data[6] = { ii, 1, 2, 3, 4, ii };
+		TEST_ASSERT_TRUE(ring.write(data, sizeof(data)));
+		TEST_ASSERT_EQUALS(ring.read(device), 6U);
+		TEST_ASSERT_EQUALS_ARRAY(data, device.buffer + ii * 6, 6);
+	}
+	TEST_ASSERT_TRUE(device.blockWrites > 16);
+}
+
+void
+RingBufferTest::testPartialRead()
+{
+	xpcc::log::RingBuffer ring(memory, sizeof(memory));
+
+	TEST_ASSERT_TRUE(ring.write("0123456789", 10));
+	TEST_ASSERT_EQUALS(ring.read(device, 4), 4U);
+	TEST_ASSERT_FALSE(ring.isEmpty());
+
+	// the space is freed after the chunk was read completely
+	TEST_ASSERT_FALSE(ring.write("0123456789abcdef", 16));
+	TEST_ASSERT_EQUALS(ring.read(device, 4), 4U);
+	TEST_ASSERT_EQUALS(ring.read(device), 2U);
+	TEST_ASSERT_TRUE(ring.isEmpty());
+	TEST_ASSERT_EQUALS_ARRAY("0123456789", device.buffer, 10);
+
+	TEST_ASSERT_TRUE(ring.write("0123456789abcdef", 16));
+}
+
+void
+RingBufferTest::testUncommitted()
+{
+	xpcc::log::RingBuffer ring(memory, sizeof(memory));
+
+	// interrupted while writing the first chunk
+	xpcc::log::RingBuffer::Writer first;
+	TEST_ASSERT_TRUE(ring.reserve(2, first));
+	first.write('a');
+
+	TEST_ASSERT_TRUE(ring.write("bc", 2));
+
+	// the following chunks are read after the first one is committed
+	TEST_ASSERT_EQUALS(ring.read(device), 0U);
+	TEST_ASSERT_FALSE(ring.isEmpty());
+
+	first.write('z');
+	ring.commit(first);
+	TEST_ASSERT_EQUALS(ring.read(device), 4U);
+	TEST_ASSERT_EQUALS_ARRAY("azbc", device.buffer, 4);
+	TEST_ASSERT_TRUE(ring.isEmpty());
+}
+
+void
+RingBufferTest::testDropped()
+{
+	xpcc::log::RingBuffer ring(memory, sizeof(memory));
+
+	TEST_ASSERT_TRUE(ring.write("0123456789ab", 12));
+	TEST_ASSERT_TRUE(ring.write("0123456789ab", 12));
+	TEST_ASSERT_FALSE(ring.write("0", 1));
+	TEST_ASSERT_EQUALS(ring.getDroppedChunks(), 1U);
+
+	// larger than the buffer
+	TEST_ASSERT_FALSE(ring.write(device.buffer, 29));
+	TEST_ASSERT_EQUALS(ring.getDroppedChunks(), 2U);
+
+	ring.drop();
+	TEST_ASSERT_EQUALS(ring.getDroppedChunks(), 3U);
+
+	TEST_ASSERT_EQUALS(ring.read(device), 24U);
+	TEST_ASSERT_TRUE(ring.write(device.buffer, 28));
+}
+
+void
+RingBufferTest::testBufferedDevice()
+{
+	xpcc::log::BufferedDevice buffered(memory, sizeof(memory));
+	xpcc::IOStream stream(buffered);
+
+	stream << "x=" << 42 << '\n';
+	TEST_ASSERT_EQUALS(buffered.drain(device), 5U);
+	TEST_ASSERT_EQUALS_ARRAY("x=42\n", device.buffer, 5);
+	TEST_ASSERT_TRUE(buffered.isEmpty());
+
+	// only the first two values fit
+	device.clear();
+	stream << "0123456789" << "abcdef" << "ABCDEF";
+	TEST_ASSERT_EQUALS(buffered.getDroppedWrites(), 1U);
+
+	const char expected[] = "0123456789abcdef\n*** 1 log writes dropped ***\n";
+	TEST_ASSERT_EQUALS(buffered.drain(device), sizeof(expected) - 1);
+	TEST_ASSERT_EQUALS_ARRAY(expected, device.buffer, sizeof(expected) - 1);
+
+	// reported only once
+	TEST_ASSERT_EQUALS(buffered.drain(device), 0U);
+}
+
+void
+RingBufferTest::testBufferedDeviceSegments()
+{
+	xpcc::log::BufferedDevice buffered(memory, sizeof(memory));
+
+	// stored as one chunk of 4 + 8 bytes
+	const xpcc::IODevice::Segment segments[] = {
+			{ "[id]", 4 }, { "data", 4 } };
+	buffered.writeSegments(segments, 2);
+
+	TEST_ASSERT_EQUALS(buffered.drain(device), 8U);
+	TEST_ASSERT_EQUALS_ARRAY("[id]data", device.buffer, 8);
+	TEST_ASSERT_EQUALS(device.blockWrites, 1U);
+}
@@ -0,0 +1,53 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/debug/logger/logger.hpp>
+#include <xpcc/debug/logger/style_wrapper.hpp>
+#include <xpcc/debug/logger/style/prefix.hpp>
+#include <xpcc/debug/logger/style/std_colour.hpp>
+#include <xpcc/io/test/memory_writer.hpp>
+
+#include "style_test.hpp"
+
+namespace
+{
+	typedef xpcc::log::StdColour< xpcc::log::GREEN, xpcc::log::NONE > Green;
+}
+
+// ----------------------------------------------------------------------------
+void
+StyleTest::testPrefix()
+{
+	MemoryWriter device;
+	xpcc::log::StyleWrapper< xpcc::log::Prefix< char[7] > > wrapper(
+			xpcc::log::Prefix< char[7] >("Info: ", device));
+	xpcc::log::Logger logger(wrapper);
+
+	logger << 12345 << " abc " << int16_t(-42) << xpcc::endl;
+	logger << "next" << xpcc::endl;
+
+	TEST_ASSERT_EQUALS_STRING(device.getString(), "Info: 12345 abc -42\nInfo: next\n");
+}
+
+void
+StyleTest::testColourPerBlock()
+{
+	MemoryWriter device;
+	xpcc::log::StyleWrapper< xpcc::log::Prefix< char[7], Green > > wrapper(
+			xpcc::log::Prefix< char[7], Green >("Info: ", Green(device)));
+	xpcc::log::Logger logger(wrapper);
+
+	logger << 12345 << " abc" << xpcc::endl;
+
+	// the colour is set once for each block, not for each character
+	TEST_ASSERT_EQUALS_STRING(device.getString(),
+			"\033[32mInfo: \033[32m12345\033[32m abc\033[32m\n\033[0m");
+	// only the newline of xpcc::endl is a single character
+	TEST_ASSERT_EQUALS(device.charWrites, 1U);
+}
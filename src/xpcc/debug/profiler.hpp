@@ -0,0 +1,105 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @ingroup		debug
+ * @defgroup	profiler	Profiler
+ *
+ * Measures how long hot code paths take, without a debugger.
+ *
+ * A zone collects the number of runs, the minimum, mean and maximum
+ * duration and a histogram with logarithmic buckets in a fixed amount of
+ * RAM. The time is taken from the DWT cycle counter on Cortex-M3/M4/M7,
+ * from Timer1 on AVR and from `clock_gettime()` on hosted targets, see
+ * xpcc::profiler::Counter.
+ *
+ * @code
+ * // enable the profiler before including the header or for the whole
+ * // project with the define XPCC_PROFILER_ENABLED=1
+ * #define XPCC_PROFILER_ENABLED 1
+ * #include <xpcc/debug/profiler.hpp>
+ *
+ * void
+ * controlLoop()
+ * {
+ *     XPCC_PROFILE_ZONE("control");
+ *     readSensors();
+ *     {
+ *         XPCC_PROFILE_ZONE("filter");
+ *         filter.update();
+ *     }
+ *     setOutputs();
+ * }
+ *
+ * // once per second
+ * XPCC_PROFILE_DUMP(xpcc::log::info);
+ * XPCC_PROFILE_RESET();
+ * @endcode
+ *
+ * The statistics can also be read with xpcc::profiler::Zone::getFirst()
+ * and sent to another board, e.g. as payload of an xpcc event.
+ *
+ * If `XPCC_PROFILER_ENABLED` is not set to `1`, all macros expand to
+ * nothing and no code or RAM is used.
+ */
+
+#ifndef XPCC_PROFILER_HPP
+#define XPCC_PROFILER_HPP
+
+#include <xpcc/architecture/utils.hpp>
+
+/// @ingroup	profiler
+/// Set to `1` to enable the profiling macros
+#ifndef XPCC_PROFILER_ENABLED
+#	define XPCC_PROFILER_ENABLED 0
+#endif
+
+#if XPCC_PROFILER_ENABLED
+
+#include "profiler/counter.hpp"
+#include "profiler/zone.hpp"
+
+/**
+ * Measure the time until the end of the current scope.
+ *
+ * The zone is created when the scope is entered the first time.
+ *
+ * @ingroup	profiler
+ * @hideinitializer
+ */
+#define XPCC_PROFILE_ZONE(name) \
+	static ::xpcc::profiler::Zone XPCC_CONCAT(xpccProfileZone, __LINE__)(name); \
+	::xpcc::profiler::Scope XPCC_CONCAT(xpccProfileScope, __LINE__)(XPCC_CONCAT(xpccProfileZone, __LINE__))
+
+/**
+ * Write the statistics of all zones to an xpcc::IOStream.
+ *
+ * @ingroup	profiler
+ * @hideinitializer
+ */
+#define XPCC_PROFILE_DUMP(stream) \
+	::xpcc::profiler::dump(stream)
+
+/**
+ * Reset the statistics of all zones.
+ *
+ * @ingroup	profiler
+ * @hideinitializer
+ */
+#define XPCC_PROFILE_RESET() \
+	::xpcc::profiler::Zone::resetAll()
+
+#else
+
+#define XPCC_PROFILE_ZONE(name)
+#define XPCC_PROFILE_DUMP(stream)
+#define XPCC_PROFILE_RESET()
+
+#endif	// XPCC_PROFILER_ENABLED
+
+#endif	// XPCC_PROFILER_HPP
@@ -0,0 +1,193 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_PROFILER_COUNTER_HPP
+#define XPCC_PROFILER_COUNTER_HPP
+
+#include <stdint.h>
+
+#include <xpcc/architecture/detect.hpp>
+#include <xpcc/architecture/utils.hpp>
+
+#if defined(XPCC__CPU_CORTEX_M3) || defined(XPCC__CPU_CORTEX_M4) || defined(XPCC__CPU_CORTEX_M7)
+#	include <xpcc/architecture/platform.hpp>
+#elif defined(XPCC__CPU_AVR)
+#	include <avr/io.h>
+#elif defined(XPCC__OS_UNIX) || defined(XPCC__OS_LINUX) || defined(XPCC__OS_OSX)
+#	include <time.h>
+#elif defined(XPCC__OS_WIN32)
+#	include <windows.h>
+#else
+#	include <xpcc/architecture/driver/precise_clock.hpp>
+#endif
+
+namespace xpcc
+{
+
+namespace profiler
+{
+
+/**
+ * Free-running counter used to measure profiling zones
+ *
+ * | Target              | Source                     | Resolution     |
+ * |---------------------|----------------------------|----------------|
+ * | Cortex-M3/M4/M7     | DWT cycle counter          | 1 CPU cycle    |
+ * | AVR with Timer1     | Timer1, prescaler 8        | 8 CPU cycles   |
+ * | Linux, Unix, OS X   | `clock_gettime()`          | 1 ns           |
+ * | Windows             | `QueryPerformanceCounter()`| system defined |
+ * | others              | xpcc::PreciseClock         | 1 us           |
+ *
+ * The counter is 32 bit wide and wraps around, so zones must be shorter
+ * than 2^32 ticks (25s on a Cortex-M4 at 168MHz, 4.3s on hosted). On AVR
+ * only 16 bit are available, which limits zones to 32ms at 16MHz.
+ *
+ * The DWT cycle counter is enabled by the Cortex-M startup code, Timer1
+ * of the AVR must be started with initialize().
+ *
+ * @ingroup	profiler
+ */
+class Counter
+{
+public:
+	typedef uint32_t Type;
+
+#if defined(XPCC__CPU_CORTEX_M3) || defined(XPCC__CPU_CORTEX_M4) || defined(XPCC__CPU_CORTEX_M7)
+
+	static inline void
+	initialize()
+	{
+	}
+
+	static xpcc_always_inline Type
+	now()
+	{
+		return cortex::CycleCounter::getCount();
+	}
+
+	static inline uint32_t
+	getFrequency()
+	{
+		return xpcc::clock::fcpu;
+	}
+
+#elif defined(XPCC__CPU_AVR) && defined(TCNT1)
+
+	/// Runs Timer1 in normal mode with a prescaler of 8
+	static inline void
+	initialize()
+	{
+		TCCR1A = 0;
+		TCCR1B = (1 << CS11);
+	}
+
+	static xpcc_always_inline Type
+	now()
+	{
+		// TCNT1 is read atomically via the TEMP register of the timer
+		return TCNT1;
+	}
+
+	static inline uint32_t
+	getFrequency()
+	{
+		return F_CPU / 8;
+	}
+
+	static constexpr Type Mask = 0xffff;
+
+#elif defined(XPCC__OS_UNIX) || defined(XPCC__OS_LINUX) || defined(XPCC__OS_OSX)
+
+	static inline void
+	initialize()
+	{
+	}
+
+	static inline Type
+	now()
+	{
+		struct timespec time;
+		clock_gettime(CLOCK_MONOTONIC, &time);
+		return Type(time.tv_sec) * 1000000000UL + Type(time.tv_nsec);
+	}
+
+	static inline uint32_t
+	getFrequency()
+	{
+		return 1000000000UL;
+	}
+
+#elif defined(XPCC__OS_WIN32)
+
+	static inline void
+	initialize()
+	{
+	}
+
+	static inline Type
+	now()
+	{
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter(&counter);
+		return Type(counter.QuadPart);
+	}
+
+	static inline uint32_t
+	getFrequency()
+	{
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency(&frequency);
+		return uint32_t(frequency.QuadPart);
+	}
+
+#else
+
+	static inline void
+	initialize()
+	{
+	}
+
+	static inline Type
+	now()
+	{
+		return PreciseClock::now().getTime();
+	}
+
+	static inline uint32_t
+	getFrequency()
+	{
+		return 1000000UL;
+	}
+
+#endif
+
+#if !(defined(XPCC__CPU_AVR) && defined(TCNT1))
+	static constexpr Type Mask = 0xffffffff;
+#endif
+
+	/// Ticks between `start` and now, correct across one overflow of the counter
+	static xpcc_always_inline Type
+	elapsed(Type start)
+	{
+		return (now() - start) & Mask;
+	}
+
+	/// Convert ticks to nanoseconds
+	static inline uint32_t
+	toNanoseconds(Type ticks)
+	{
+		return uint32_t((uint64_t(ticks) * 1000000000UL) / getFrequency());
+	}
+};
+
+}	// namespace profiler
+
+}	// namespace xpcc
+
+#endif // XPCC_PROFILER_COUNTER_HPP
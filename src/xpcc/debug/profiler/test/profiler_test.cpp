@@ -0,0 +1,146 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#define XPCC_PROFILER_ENABLED 1
+#include <xpcc/debug/profiler.hpp>
+#include <xpcc/io/test/memory_writer.hpp>
+
+#include <string.h>
+
+#include "profiler_test.hpp"
+
+using xpcc::profiler::Zone;
+
+namespace
+{
+	Zone testZone("test");
+	Zone resetZone("reset");
+
+	uint8_t calls = 0;
+
+	void
+	profiledFunction()
+	{
+		XPCC_PROFILE_ZONE("profiled");
+		calls++;
+	}
+
+	Zone *
+	findZone(const char *name)
+	{
+		for (Zone *zone = Zone::getFirst(); zone != 0; zone = zone->getNext())
+		{
+			if (strcmp(zone->getName(), name) == 0) {
+				return zone;
+			}
+		}
+		return 0;
+	}
+}
+
+// ----------------------------------------------------------------------------
+void
+ProfilerTest::testBucketIndex()
+{
+	TEST_ASSERT_EQUALS(Zone::getBucketIndex(0), 0U);
+	TEST_ASSERT_EQUALS(Zone::getBucketIndex(1), 1U);
+	TEST_ASSERT_EQUALS(Zone::getBucketIndex(2), 2U);
+	TEST_ASSERT_EQUALS(Zone::getBucketIndex(3), 2U);
+	TEST_ASSERT_EQUALS(Zone::getBucketIndex(4), 3U);
+	TEST_ASSERT_EQUALS(Zone::getBucketIndex(1000), 10U);
+	TEST_ASSERT_EQUALS(Zone::getBucketIndex(1024), 11U);
+
+	// long durations end up in the last bucket
+	TEST_ASSERT_EQUALS(Zone::getBucketIndex(0xffffffff), uint8_t(Zone::Buckets - 1));
+}
+
+void
+ProfilerTest::testStatistics()
+{
+	TEST_ASSERT_EQUALS(testZone.getCount(), 0U);
+	TEST_ASSERT_EQUALS(testZone.getMinimum(), 0U);
+	TEST_ASSERT_EQUALS(testZone.getMean(), 0U);
+
+	testZone.add(100);
+	testZone.add(300);
+	testZone.add(200);
+	testZone.add(5);
+
+	TEST_ASSERT_EQUALS(testZone.getCount(), 4U);
+	TEST_ASSERT_EQUALS(testZone.getMinimum(), 5U);
+	TEST_ASSERT_EQUALS(testZone.getMaximum(), 300U);
+	TEST_ASSERT_EQUALS(testZone.getMean(), 151U);
+	TEST_ASSERT_EQUALS(testZone.getTotal(), 605U);
+
+	TEST_ASSERT_EQUALS(testZone.getBucket(3), 1U);	// 5
+	TEST_ASSERT_EQUALS(testZone.getBucket(7), 1U);	// 100
+	TEST_ASSERT_EQUALS(testZone.getBucket(8), 1U);	// 200
+	TEST_ASSERT_EQUALS(testZone.getBucket(9), 1U);	// 300
+	TEST_ASSERT_EQUALS(testZone.getBucket(Zone::Buckets), 0U);
+}
+
+void
+ProfilerTest::testReset()
+{
+	for (uint8_t ii = 0; ii < 10; ++ii) {
+		resetZone.add(ii);
+	}
+	TEST_ASSERT_EQUALS(resetZone.getCount(), 10U);
+
+	resetZone.reset();
+	TEST_ASSERT_EQUALS(resetZone.getCount(), 0U);
+	TEST_ASSERT_EQUALS(resetZone.getMaximum(), 0U);
+	TEST_ASSERT_EQUALS(resetZone.getBucket(1), 0U);
+
+	resetZone.add(7);
+	testZone.add(7);
+	Zone::resetAll();
+	TEST_ASSERT_EQUALS(resetZone.getCount(), 0U);
+	TEST_ASSERT_EQUALS(testZone.getCount(), 0U);
+}
+
+void
+ProfilerTest::testZoneMacro()
+{
+	// the zone is registered on first use
+	TEST_ASSERT_TRUE(findZone("profiled") == 0);
+
+	for (uint8_t ii = 0; ii < 5; ++ii) {
+		profiledFunction();
+	}
+	TEST_ASSERT_EQUALS(calls, 5U);
+
+	Zone *zone = findZone("profiled");
+	TEST_ASSERT_TRUE(zone != 0);
+	if (zone != 0) {
+		TEST_ASSERT_EQUALS(zone->getCount(), 5U);
+		TEST_ASSERT_TRUE(zone->getMinimum() <= zone->getMaximum());
+	}
+}
+
+void
+ProfilerTest::testDump()
+{
+	MemoryWriter device;
+	xpcc::IOStream stream(device);
+
+	testZone.add(10);
+	XPCC_PROFILE_DUMP(stream);
+
+	TEST_ASSERT_TRUE(strstr(device.getString(), "count") != 0);
+	TEST_ASSERT_TRUE(strstr(device.getString(), "test") != 0);
+	TEST_ASSERT_TRUE(strstr(device.getString(), "reset") != 0);
+
+	// the columns of the header and of the zones end at the same position
+	const char *header = device.getString();
+	const char *row = strchr(header, '\n') + 1;
+	TEST_ASSERT_EQUALS(strchr(header, '\n') - header, strchr(row, '\n') - row);
+	TEST_ASSERT_EQUALS(strstr(header, "count") + 5 - header, 26);
+	TEST_ASSERT_TRUE(row[25] != ' ' and row[26] == ' ');
+}
@@ -0,0 +1,186 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/architecture/driver/atomic/lock.hpp>
+
+#include "zone.hpp"
+
+xpcc::profiler::Zone *xpcc::profiler::Zone::first = 0;
+
+// ----------------------------------------------------------------------------
+xpcc::profiler::Zone::Zone(const char *name) :
+	name(name), next(0)
+{
+	reset();
+
+	// append, so that dump() lists the zones in the order of their first use
+	atomic::Lock lock;
+	Zone **link = &first;
+	while (*link != 0) {
+		link = &(*link)->next;
+	}
+	*link = this;
+}
+
+void
+xpcc::profiler::Zone::add(Counter::Type ticks)
+{
+	const uint8_t index = getBucketIndex(ticks);
+
+	atomic::Lock lock;
+
+	count++;
+	total += ticks;
+	if (ticks < minimum) {
+		minimum = ticks;
+	}
+	if (ticks > maximum) {
+		maximum = ticks;
+	}
+	if (histogram[index] < 0xffff) {
+		histogram[index]++;
+	}
+}
+
+void
+xpcc::profiler::Zone::reset()
+{
+	atomic::Lock lock;
+
+	count = 0;
+	minimum = Counter::Mask;
+	maximum = 0;
+	total = 0;
+	for (uint_fast8_t ii = 0; ii < Buckets; ++ii) {
+		histogram[ii] = 0;
+	}
+}
+
+xpcc::profiler::Counter::Type
+xpcc::profiler::Zone::getMean() const
+{
+	atomic::Lock lock;
+
+	if (count == 0) {
+		return 0;
+	}
+	return Counter::Type(total / count);
+}
+
+uint8_t
+xpcc::profiler::Zone::getBucketIndex(Counter::Type ticks)
+{
+	uint8_t index = 0;
+	while (ticks != 0 and index < (Buckets - 1))
+	{
+		ticks >>= 1;
+		index++;
+	}
+	return index;
+}
+
+void
+xpcc::profiler::Zone::resetAll()
+{
+	for (Zone *zone = first; zone != 0; zone = zone->next) {
+		zone->reset();
+	}
+}
+
+// ----------------------------------------------------------------------------
+namespace
+{
+	// widths of the columns of dump()
+	constexpr uint8_t NameWidth = 16;
+	constexpr uint8_t CountWidth = 10;
+	constexpr uint8_t TimeWidth = 12;
+
+	void
+	writePadded(xpcc::IOStream& stream, uint32_t value, uint8_t width)
+	{
+		uint8_t digits = 1;
+		for (uint32_t ii = value; ii >= 10; ii /= 10) {
+			digits++;
+		}
+		while (digits++ < width) {
+			stream << ' ';
+		}
+		stream << value;
+	}
+
+	void
+	writeName(xpcc::IOStream& stream, const char *name, uint8_t width)
+	{
+		uint8_t length = 0;
+		for (const char *c = name; *c != '\0'; ++c) {
+			length++;
+		}
+		stream << name;
+		while (length++ < width) {
+			stream << ' ';
+		}
+	}
+
+	/// Right aligned text
+	void
+	writeTitle(xpcc::IOStream& stream, const char *title, uint8_t width)
+	{
+		uint8_t length = 0;
+		for (const char *c = title; *c != '\0'; ++c) {
+			length++;
+		}
+		while (length++ < width) {
+			stream << ' ';
+		}
+		stream << title;
+	}
+}
+
+void
+xpcc::profiler::dump(IOStream& stream)
+{
+	writeName(stream, "zone", NameWidth);
+	writeTitle(stream, "count", CountWidth);
+	writeTitle(stream, "min [ns]", TimeWidth);
+	writeTitle(stream, "mean [ns]", TimeWidth);
+	writeTitle(stream, "max [ns]", TimeWidth);
+	stream << xpcc::endl;
+
+	for (Zone *zone = Zone::getFirst(); zone != 0; zone = zone->getNext())
+	{
+		writeName(stream, zone->getName(), NameWidth);
+		writePadded(stream, zone->getCount(), CountWidth);
+		writePadded(stream, Counter::toNanoseconds(zone->getMinimum()), TimeWidth);
+		writePadded(stream, Counter::toNanoseconds(zone->getMean()), TimeWidth);
+		writePadded(stream, Counter::toNanoseconds(zone->getMaximum()), TimeWidth);
+		stream << xpcc::endl;
+
+		bool empty = true;
+		for (uint_fast8_t ii = 0; ii < Zone::Buckets; ++ii)
+		{
+			const uint16_t value = zone->getBucket(ii);
+			if (value == 0) {
+				continue;
+			}
+
+			stream << "  ";
+			empty = false;
+			if (ii == Zone::Buckets - 1) {
+				stream << ">=" << Counter::toNanoseconds(Counter::Type(1) << (ii - 1));
+			}
+			else {
+				stream << '<' << Counter::toNanoseconds(Counter::Type(1) << ii);
+			}
+			stream << ": " << value;
+		}
+		if (not empty) {
+			stream << xpcc::endl;
+		}
+	}
+}
@@ -0,0 +1,194 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_PROFILER_ZONE_HPP
+#define XPCC_PROFILER_ZONE_HPP
+
+#include <stdint.h>
+
+#include <xpcc/architecture/utils.hpp>
+#include <xpcc/io/iostream.hpp>
+
+#include "counter.hpp"
+
+/// @ingroup	profiler
+/// Number of histogram buckets per zone
+#ifndef XPCC_PROFILER_BUCKETS
+#	define XPCC_PROFILER_BUCKETS 24
+#endif
+
+namespace xpcc
+{
+
+namespace profiler
+{
+
+/**
+ * Statistics of one profiling zone
+ *
+ * Records the number of runs, the minimum, maximum and mean duration and
+ * a histogram with logarithmic buckets: bucket `0` counts durations of
+ * zero ticks, bucket `i` counts durations from `2^(i-1)` to `2^i - 1`
+ * ticks. The last bucket also contains all longer durations. The bucket
+ * counters saturate instead of overflowing.
+ *
+ * All zones are registered in a list, which is used by dump() and
+ * resetAll(). Zones are not meant to be destroyed, declare them `static`.
+ *
+ * Use the XPCC_PROFILE_ZONE() macro instead of creating zones directly.
+ *
+ * @ingroup	profiler
+ */
+class Zone
+{
+public:
+	static constexpr uint8_t Buckets = XPCC_PROFILER_BUCKETS;
+
+	static_assert(Buckets >= 2 and Buckets <= 33,
+			"XPCC_PROFILER_BUCKETS must be between 2 and 33!");
+
+public:
+	Zone(const char *name);
+
+	/// Add one measurement, may be called from interrupts
+	void
+	add(Counter::Type ticks);
+
+	void
+	reset();
+
+	inline const char *
+	getName() const
+	{
+		return name;
+	}
+
+	/// Number of measurements since the last reset
+	inline uint32_t
+	getCount() const
+	{
+		return count;
+	}
+
+	/// Shortest duration in ticks, 0 if there is no measurement
+	inline Counter::Type
+	getMinimum() const
+	{
+		return (count > 0) ? minimum : 0;
+	}
+
+	/// Longest duration in ticks
+	inline Counter::Type
+	getMaximum() const
+	{
+		return maximum;
+	}
+
+	/// Mean duration in ticks
+	Counter::Type
+	getMean() const;
+
+	/// Total time spent in the zone in ticks
+	inline uint64_t
+	getTotal() const
+	{
+		return total;
+	}
+
+	inline uint16_t
+	getBucket(uint8_t index) const
+	{
+		return (index < Buckets) ? histogram[index] : 0;
+	}
+
+	/// Index of the histogram bucket containing `ticks`
+	static uint8_t
+	getBucketIndex(Counter::Type ticks);
+
+public:
+	/// First zone of the list of all zones
+	static inline Zone *
+	getFirst()
+	{
+		return first;
+	}
+
+	inline Zone *
+	getNext() const
+	{
+		return next;
+	}
+
+	/// Reset the statistics of all zones
+	static void
+	resetAll();
+
+private:
+	Zone(const Zone&);
+
+	Zone&
+	operator = (const Zone&);
+
+	const char *const name;
+	Zone *next;
+
+	uint32_t count;
+	Counter::Type minimum;
+	Counter::Type maximum;
+	uint64_t total;
+	uint16_t histogram[Buckets];
+
+	static Zone *first;
+};
+
+/**
+ * Measures the time from its construction to its destruction
+ *
+ * @ingroup	profiler
+ */
+class Scope
+{
+public:
+	xpcc_always_inline
+	Scope(Zone& zone) :
+		zone(zone), start(Counter::now())
+	{
+	}
+
+	xpcc_always_inline
+	~Scope()
+	{
+		zone.add(Counter::elapsed(start));
+	}
+
+private:
+	Zone& zone;
+	const Counter::Type start;
+};
+
+/**
+ * Write the statistics of all zones to the stream.
+ *
+ * Times are in nanoseconds, the histogram lists only buckets which are
+ * not empty with the upper bound of the bucket. For example:
+ *
+ * @code
+ * zone                   count    min [ns]   mean [ns]    max [ns]
+ * control                 1000       12345       13012       18871
+ *   <16384: 312  <32768: 688
+ * @endcode
+ */
+void
+dump(IOStream& stream);
+
+}	// namespace profiler
+
+}	// namespace xpcc
+
+#endif // XPCC_PROFILER_ZONE_HPP
@@ -36,3 +36,10 @@
 #include "io/iostream.hpp"
 #include "io/iodevice.hpp"
 #include "io/iodevice_wrapper.hpp"
+#include "io/dma_iodevice.hpp"
+#include "io/format.hpp"
+
+#include <xpcc/architecture/detect.hpp>
+#if defined(XPCC__OS_LINUX) || defined(XPCC__OS_OSX)
+#	include "io/hosted/mapped_file_device.hpp"
+#endif
@@ -0,0 +1,163 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_DMA_IODEVICE_HPP
+#define XPCC_DMA_IODEVICE_HPP
+
+#include <stdint.h>
+#include <cstddef>
+
+#include "iodevice.hpp"
+
+namespace xpcc
+{
+
+/**
+ * IODevice which transfers the data with DMA.
+ *
+ * Written data is copied into a transmit ring buffer and handed to the
+ * DMA in contiguous chunks, writing therefore never waits for the
+ * peripheral. When the buffer is full, the surplus data is discarded like
+ * with IOBuffer::DiscardIfFull of the IODeviceWrapper. The DMA-complete
+ * interrupt must call handleTransmitComplete(), which starts the transfer
+ * of the next chunk.
+ *
+ * Received data is written by a DMA in circular mode into the receive
+ * buffer, no interrupt is needed. The buffer must be read often enough,
+ * otherwise the DMA overwrites old data without notice.
+ *
+ * The `Transfer` class connects the device to the DMA channels of a
+ * peripheral and has to provide these static functions:
+ *
+ * @code
+ * struct UartDma
+ * {
+ *     // Start transmitting `length` bytes, the transfer complete
+ *     // interrupt calls handleTransmitComplete() of the device.
+ *     static void
+ *     startTransmit(const uint8_t *data, std::size_t length);
+ *
+ *     // Start receiving into `buffer` in circular mode.
+ *     static void
+ *     startReceive(uint8_t *buffer, std::size_t size);
+ *
+ *     // Number of bytes until the receive DMA wraps around
+ *     // (the NDTR register on STM32).
+ *     static std::size_t
+ *     getReceiveRemaining();
+ * };
+ *
+ * xpcc::DmaIODevice<UartDma, 1024, 128> device;
+ *
+ * XPCC_ISR(DMA1_Stream6)
+ * {
+ *     // acknowledge the interrupt of the DMA stream
+ *     ...
+ *     device.handleTransmitComplete();
+ * }
+ *
+ * int main()
+ * {
+ *     ...
+ *     device.initialize();
+ *     xpcc::IOStream stream(device);
+ *     stream << "never waits for the UART" << xpcc::endl;
+ * }
+ * @endcode
+ *
+ * Writing from several contexts at the same time is not supported, but
+ * handleTransmitComplete() may interrupt write().
+ *
+ * @tparam	Transfer		Binding to the DMA channels, see above
+ * @tparam	TxBufferSize	Size of the transmit buffer in bytes
+ * @tparam	RxBufferSize	Size of the receive buffer in bytes
+ *
+ * @ingroup	io
+ */
+template< class Transfer, std::size_t TxBufferSize, std::size_t RxBufferSize >
+class DmaIODevice : public IODevice
+{
+public:
+	using IODevice::write;
+	using IODevice::read;
+
+	DmaIODevice();
+
+	/// Start the reception, call after the DMA and peripheral are configured
+	void
+	initialize();
+
+	virtual void
+	write(char c);
+
+	virtual void
+	write(const uint8_t *data, std::size_t length);
+
+	/// Copies all segments before the transfer is started
+	virtual void
+	writeSegments(const Segment *segments, std::size_t count);
+
+	/// Does nothing, the data is transmitted in the background
+	virtual void
+	flush();
+
+	virtual bool
+	read(char& c);
+
+	virtual std::size_t
+	read(uint8_t *data, std::size_t length);
+
+	/// Call from the transfer complete interrupt of the transmit DMA
+	void
+	handleTransmitComplete();
+
+	/// `true` if all data was transmitted
+	bool
+	isTransmitFinished() const;
+
+	/// Number of bytes in the transmit buffer, including the active transfer
+	std::size_t
+	getTransmitLength() const;
+
+	/// Number of bytes which were discarded, because the buffer was full
+	inline std::size_t
+	getDiscardedBytes() const
+	{
+		return discarded;
+	}
+
+private:
+	/// Copy the data into the transmit buffer
+	void
+	append(const uint8_t *data, std::size_t length);
+
+	/// Start a DMA transfer if none is active
+	void
+	startTransmit();
+
+	uint8_t txBuffer[TxBufferSize];
+	uint8_t rxBuffer[RxBufferSize];
+
+	// written only by append()
+	std::size_t txHead;
+	std::size_t discarded;
+
+	// written only by startTransmit() and handleTransmitComplete()
+	std::size_t txTail;
+	std::size_t txActive;	///< length of the active transfer, 0 if idle
+
+	// written only by read()
+	std::size_t rxTail;
+};
+
+}	// namespace xpcc
+
+#include "dma_iodevice_impl.hpp"
+
+#endif	// XPCC_DMA_IODEVICE_HPP
@@ -0,0 +1,198 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_DMA_IODEVICE_HPP
+#	error	"Don't include this file directly, use 'dma_iodevice.hpp' instead!"
+#endif
+
+#include <cstring>
+
+#include <xpcc/architecture/driver/accessor.hpp>
+#include <xpcc/architecture/driver/atomic/lock.hpp>
+
+template< class Transfer, std::size_t TxBufferSize, std::size_t RxBufferSize >
+xpcc::DmaIODevice<Transfer, TxBufferSize, RxBufferSize>::DmaIODevice() :
+	txHead(0), discarded(0), txTail(0), txActive(0), rxTail(0)
+{
+	static_assert(TxBufferSize >= 2, "TxBufferSize must be at least 2");
+	static_assert(RxBufferSize >= 1, "RxBufferSize must be at least 1");
+}
+
+template< class Transfer, std::size_t TxBufferSize, std::size_t RxBufferSize >
+void
+xpcc::DmaIODevice<Transfer, TxBufferSize, RxBufferSize>::initialize()
+{
+	rxTail = 0;
+	Transfer::startReceive(rxBuffer, RxBufferSize);
+}
+
+// ----------------------------------------------------------------------------
+template< class Transfer, std::size_t TxBufferSize, std::size_t RxBufferSize >
+void
+xpcc::DmaIODevice<Transfer, TxBufferSize, RxBufferSize>::write(char c)
+{
+	write(reinterpret_cast<const uint8_t *>(&c), 1);
+}
+
+template< class Transfer, std::size_t TxBufferSize, std::size_t RxBufferSize >
+void
+xpcc::DmaIODevice<Transfer, TxBufferSize, RxBufferSize>::write(const uint8_t *data, std::size_t length)
+{
+	append(data, length);
+	startTransmit();
+}
+
+template< class Transfer, std::size_t TxBufferSize, std::size_t RxBufferSize >
+void
+xpcc::DmaIODevice<Transfer, TxBufferSize, RxBufferSize>::writeSegments(const Segment *segments, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i) {
+		append(static_cast<const uint8_t *>(segments[i].data), segments[i].length);
+	}
+	startTransmit();
+}
+
+template< class Transfer, std::size_t TxBufferSize, std::size_t RxBufferSize >
+void
+xpcc::DmaIODevice<Transfer, TxBufferSize, RxBufferSize>::append(const uint8_t *data, std::size_t length)
+{
+	// the data of the active transfer stays in the buffer until it is
+	// complete, one byte stays unused to distinguish full from empty
+	const std::size_t tail = xpcc::accessor::asVolatile(txTail);
+	std::size_t free;
+	if (tail > txHead) {
+		free = tail - txHead - 1;
+	}
+	else {
+		free = TxBufferSize - 1 - (txHead - tail);
+	}
+
+	if (length > free)
+	{
+		discarded += length - free;
+		length = free;
+	}
+	if (length == 0) {
+		return;
+	}
+
+	std::size_t head = txHead;
+	const std::size_t first = TxBufferSize - head;
+	if (length < first)
+	{
+		std::memcpy(txBuffer + head, data, length);
+		head += length;
+	}
+	else
+	{
+		std::memcpy(txBuffer + head, data, first);
+		std::memcpy(txBuffer, data + first, length - first);
+		head = length - first;
+	}
+
+	// the data must be in the buffer before the DMA can see it
+	__asm__ volatile ("" ::: "memory");
+	xpcc::accessor::asVolatile(txHead) = head;
+}
+
+template< class Transfer, std::size_t TxBufferSize, std::size_t RxBufferSize >
+void
+xpcc::DmaIODevice<Transfer, TxBufferSize, RxBufferSize>::flush()
+{
+}
+
+template< class Transfer, std::size_t TxBufferSize, std::size_t RxBufferSize >
+void
+xpcc::DmaIODevice<Transfer, TxBufferSize, RxBufferSize>::startTransmit()
+{
+	atomic::Lock lock;
+
+	const std::size_t head = xpcc::accessor::asVolatile(txHead);
+	if (txActive != 0 or head == txTail) {
+		return;
+	}
+
+	// contiguous part up to the head or the end of the buffer
+	txActive = ((head > txTail) ? head : TxBufferSize) - txTail;
+	Transfer::startTransmit(txBuffer + txTail, txActive);
+}
+
+template< class Transfer, std::size_t TxBufferSize, std::size_t RxBufferSize >
+void
+xpcc::DmaIODevice<Transfer, TxBufferSize, RxBufferSize>::handleTransmitComplete()
+{
+	{
+		atomic::Lock lock;
+
+		std::size_t tail = txTail + txActive;
+		if (tail >= TxBufferSize) {
+			tail = 0;
+		}
+		xpcc::accessor::asVolatile(txTail) = tail;
+		txActive = 0;
+	}
+	startTransmit();
+}
+
+template< class Transfer, std::size_t TxBufferSize, std::size_t RxBufferSize >
+bool
+xpcc::DmaIODevice<Transfer, TxBufferSize, RxBufferSize>::isTransmitFinished() const
+{
+	atomic::Lock lock;
+	return (txActive == 0 and txHead == txTail);
+}
+
+template< class Transfer, std::size_t TxBufferSize, std::size_t RxBufferSize >
+std::size_t
+xpcc::DmaIODevice<Transfer, TxBufferSize, RxBufferSize>::getTransmitLength() const
+{
+	atomic::Lock lock;
+	if (txHead >= txTail) {
+		return txHead - txTail;
+	}
+	return TxBufferSize - txTail + txHead;
+}
+
+// ----------------------------------------------------------------------------
+template< class Transfer, std::size_t TxBufferSize, std::size_t RxBufferSize >
+bool
+xpcc::DmaIODevice<Transfer, TxBufferSize, RxBufferSize>::read(char& c)
+{
+	return (read(reinterpret_cast<uint8_t *>(&c), 1) == 1);
+}
+
+template< class Transfer, std::size_t TxBufferSize, std::size_t RxBufferSize >
+std::size_t
+xpcc::DmaIODevice<Transfer, TxBufferSize, RxBufferSize>::read(uint8_t *data, std::size_t length)
+{
+	// position of the next byte written by the DMA, the counter is
+	// reloaded to the buffer size after it reached zero
+	std::size_t head = RxBufferSize - Transfer::getReceiveRemaining();
+	if (head >= RxBufferSize) {
+		head = 0;
+	}
+
+	std::size_t count = 0;
+	while (count < length and rxTail != head)
+	{
+		// contiguous part up to the head or the end of the buffer
+		std::size_t part = ((head > rxTail) ? head : RxBufferSize) - rxTail;
+		if (part > length - count) {
+			part = length - count;
+		}
+		std::memcpy(data + count, rxBuffer + rxTail, part);
+		count += part;
+
+		rxTail += part;
+		if (rxTail >= RxBufferSize) {
+			rxTail = 0;
+		}
+	}
+	return count;
+}
@@ -0,0 +1,114 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/architecture/driver/accessor/flash.hpp>
+
+#include "format.hpp"
+
+namespace
+{
+	FLASH_STORAGE_STRING(digitPairs) =
+			"00010203040506070809"
+			"10111213141516171819"
+			"20212223242526272829"
+			"30313233343536373839"
+			"40414243444546474849"
+			"50515253545556575859"
+			"60616263646566676869"
+			"70717273747576777879"
+			"80818283848586878889"
+			"90919293949596979899";
+
+	inline uint_fast8_t
+	countDigits(uint32_t value)
+	{
+		if (value < 10) return 1;
+		if (value < 100) return 2;
+		if (value < 1000) return 3;
+		if (value < 10000) return 4;
+		if (value < 100000) return 5;
+		if (value < 1000000) return 6;
+		if (value < 10000000) return 7;
+		if (value < 100000000) return 8;
+		if (value < 1000000000) return 9;
+		return 10;
+	}
+
+	// Fill the `length` characters before `end` with the lower digits of
+	// `value`, two at a time.
+	inline void
+	writeBackwards(char *end, uint32_t value, uint_fast8_t length)
+	{
+		xpcc::accessor::Flash<char> pairs = xpcc::accessor::asFlash(digitPairs);
+
+		while (length >= 2)
+		{
+			const uint32_t quotient = value / 100;
+			const uint_fast8_t index = (value - quotient * 100) * 2;
+			*--end = pairs[index + 1];
+			*--end = pairs[index];
+			value = quotient;
+			length -= 2;
+		}
+		if (length) {
+			*--end = static_cast<char>('0' + value % 10);
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+char *
+xpcc::format::writeDecimal(char *buffer, uint32_t value)
+{
+	const uint_fast8_t length = countDigits(value);
+	char *end = buffer + length;
+	writeBackwards(end, value, length);
+	*end = '\0';
+	return end;
+}
+
+char *
+xpcc::format::writeDecimal(char *buffer, int32_t value)
+{
+	if (value < 0)
+	{
+		*buffer++ = '-';
+		// negate in unsigned arithmetic, this works for INT32_MIN too
+		return writeDecimal(buffer, uint32_t(0) - static_cast<uint32_t>(value));
+	}
+	return writeDecimal(buffer, static_cast<uint32_t>(value));
+}
+
+char *
+xpcc::format::writeDecimal(char *buffer, uint64_t value)
+{
+	if (value <= 0xffffffff) {
+		return writeDecimal(buffer, static_cast<uint32_t>(value));
+	}
+
+	// One 64-bit division per eight digits, the rest is done in 32-bit
+	const uint64_t upper = value / 100000000;
+	const uint32_t lower = static_cast<uint32_t>(value - upper * 100000000);
+
+	char *end = writeDecimal(buffer, upper) + 8;
+	writeBackwards(end, lower, 8);
+	*end = '\0';
+	return end;
+}
+
+char *
+xpcc::format::writeDecimal(char *buffer, int64_t value)
+{
+	if (value < 0)
+	{
+		*buffer++ = '-';
+		return writeDecimal(buffer, uint64_t(0) - static_cast<uint64_t>(value));
+	}
+	return writeDecimal(buffer, static_cast<uint64_t>(value));
+}
@@ -0,0 +1,128 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_IO_FORMAT_HPP
+#define XPCC_IO_FORMAT_HPP
+
+#include <stdint.h>
+#include <cstddef>
+
+#include <xpcc/architecture/detect.hpp>
+
+namespace xpcc
+{
+
+/**
+ * Number to string conversion without the C library.
+ *
+ * Used by xpcc::IOStream, but also useful on its own, e.g. to fill a
+ * display buffer or a protocol frame. All functions write a
+ * null-terminated string to `buffer` and return a pointer to the
+ * terminating `'\0'`, so that conversions can be chained.
+ *
+ * - Integers are converted two digits at a time with a 200 byte lookup
+ *   table, which needs a fifth of the divisions of the usual
+ *   digit-by-digit loop. 64-bit values are split into 8-digit blocks
+ *   first, to avoid the slow 64-bit division on 32-bit targets.
+ * - Floating point values are converted with the Grisu2 algorithm
+ *   (Florian Loitsch, "Printing Floating-Point Numbers Quickly and
+ *   Accurately with Integers", 2010). It yields the shortest digit string
+ *   which reads back to the identical value in more than 99.9% of all
+ *   cases, and a string that still reads back correctly, but has one
+ *   digit more, otherwise.
+ *   Only integer arithmetic is used, the cached powers of ten need
+ *   about 1 kB of flash.
+ *
+ * writeScientific() and writeFixed() round the shortest representation
+ * of the value as a `double` to the requested precision where this is
+ * known to give the correctly rounded result. Otherwise, e.g. for 2.675
+ * (actually 2.67499999...) with two digits or for more than 15
+ * significant digits, the digits are generated from the exact binary
+ * value with a multiple precision integer on the stack. The result is
+ * identical to the one of `printf()` for all values and precisions.
+ *
+ * @code
+ * char buffer[xpcc::format::BufferSize];
+ *
+ * xpcc::format::writeShortest(buffer, 0.1f);         // "0.1"
+ * xpcc::format::writeScientific(buffer, 457.f, 5);   // "4.57000e+02"
+ * xpcc::format::writeFixed(buffer, -2.375, 2);       // "-2.38"
+ *
+ * char *ptr = xpcc::format::writeDecimal(buffer, int32_t(-42));
+ * *ptr++ = ' ';
+ * xpcc::format::writeDecimal(ptr, uint32_t(4000000000));   // "-42 4000000000"
+ * @endcode
+ *
+ * The floating point functions are not available on the AVR, where
+ * `double` is identical to `float` and avr-libc already provides compact
+ * `dtostre()` and `dtostrf()` functions.
+ *
+ * @ingroup	io
+ */
+namespace format
+{
+	/// A buffer of this size can hold the result of any function below
+	static constexpr std::size_t BufferSize = 42;
+
+	/// Maximum number of digits after the decimal point
+	static constexpr uint8_t MaxPrecision = 17;
+
+	char *
+	writeDecimal(char *buffer, uint32_t value);
+
+	char *
+	writeDecimal(char *buffer, int32_t value);
+
+	char *
+	writeDecimal(char *buffer, uint64_t value);
+
+	char *
+	writeDecimal(char *buffer, int64_t value);
+
+#if !defined(XPCC__CPU_AVR)
+
+	/**
+	 * Shortest representation which reads back to the same value.
+	 *
+	 * Values between 1e-6 and 1e21 use the positional notation ("0.001",
+	 * "1234.5", "100"), all others the exponential notation ("1.5e-07",
+	 * "2e+30"). Not-a-number and infinity are written as "nan" and "inf".
+	 */
+	char *
+	writeShortest(char *buffer, float value);
+
+	/// `precision` digits after the decimal point with an exponent,
+	/// identical to `printf("%.*e", precision, value)`
+	char *
+	writeScientific(char *buffer, float value, uint8_t precision);
+
+	/**
+	 * `precision` digits after the decimal point without an exponent,
+	 * identical to `printf("%.*f", precision, value)`.
+	 *
+	 * Values of 1e21 and above are written like writeScientific() to
+	 * bound the length of the result.
+	 */
+	char *
+	writeFixed(char *buffer, float value, uint8_t precision);
+
+	char *
+	writeShortest(char *buffer, double value);
+
+	char *
+	writeScientific(char *buffer, double value, uint8_t precision);
+
+	char *
+	writeFixed(char *buffer, double value, uint8_t precision);
+#endif
+}	// namespace format
+
+}	// namespace xpcc
+
+#endif // XPCC_IO_FORMAT_HPP
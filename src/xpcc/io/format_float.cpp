@@ -0,0 +1,847 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "format.hpp"
+
+#if !defined(XPCC__CPU_AVR)
+
+namespace
+{
+	// Floating point value `f * 2^e` with a 64-bit significand
+	struct DiyFp
+	{
+		uint64_t f;
+		int e;
+	};
+
+	inline DiyFp
+	makeDiyFp(uint64_t f, int e)
+	{
+		DiyFp result = { f, e };
+		return result;
+	}
+
+	// Upper 64 bits of the 128-bit product, rounded
+	inline DiyFp
+	multiply(const DiyFp& x, const DiyFp& y)
+	{
+		const uint64_t mask = 0xffffffff;
+		const uint64_t a = x.f >> 32;
+		const uint64_t b = x.f & mask;
+		const uint64_t c = y.f >> 32;
+		const uint64_t d = y.f & mask;
+
+		const uint64_t ac = a * c;
+		const uint64_t bc = b * c;
+		const uint64_t ad = a * d;
+		const uint64_t bd = b * d;
+
+		uint64_t middle = (bd >> 32) + (ad & mask) + (bc & mask);
+		middle += uint64_t(1) << 31;
+
+		return makeDiyFp(ac + (ad >> 32) + (bc >> 32) + (middle >> 32),
+				x.e + y.e + 64);
+	}
+
+	inline DiyFp
+	normalize(DiyFp value)
+	{
+		const int shift = __builtin_clzll(value.f);
+		value.f <<= shift;
+		value.e -= shift;
+		return value;
+	}
+
+	// Normalized 64-bit approximations of 10^-348, 10^-340, ..., 10^340,
+	// rounded to nearest.
+	const uint64_t cachedPowersF[] =
+	{
+		0xfa8fd5a0081c0288, 0xbaaee17fa23ebf76, 0x8b16fb203055ac76,
+		0xcf42894a5dce35ea, 0x9a6bb0aa55653b2d, 0xe61acf033d1a45df,
+		0xab70fe17c79ac6ca, 0xff77b1fcbebcdc4f, 0xbe5691ef416bd60c,
+		0x8dd01fad907ffc3c, 0xd3515c2831559a83, 0x9d71ac8fada6c9b5,
+		0xea9c227723ee8bcb, 0xaecc49914078536d, 0x823c12795db6ce57,
+		0xc21094364dfb5637, 0x9096ea6f3848984f, 0xd77485cb25823ac7,
+		0xa086cfcd97bf97f4, 0xef340a98172aace5, 0xb23867fb2a35b28e,
+		0x84c8d4dfd2c63f3b, 0xc5dd44271ad3cdba, 0x936b9fcebb25c996,
+		0xdbac6c247d62a584, 0xa3ab66580d5fdaf6, 0xf3e2f893dec3f126,
+		0xb5b5ada8aaff80b8, 0x87625f056c7c4a8b, 0xc9bcff6034c13053,
+		0x964e858c91ba2655, 0xdff9772470297ebd, 0xa6dfbd9fb8e5b88f,
+		0xf8a95fcf88747d94, 0xb94470938fa89bcf, 0x8a08f0f8bf0f156b,
+		0xcdb02555653131b6, 0x993fe2c6d07b7fac, 0xe45c10c42a2b3b06,
+		0xaa242499697392d3, 0xfd87b5f28300ca0e, 0xbce5086492111aeb,
+		0x8cbccc096f5088cc, 0xd1b71758e219652c, 0x9c40000000000000,
+		0xe8d4a51000000000, 0xad78ebc5ac620000, 0x813f3978f8940984,
+		0xc097ce7bc90715b3, 0x8f7e32ce7bea5c70, 0xd5d238a4abe98068,
+		0x9f4f2726179a2245, 0xed63a231d4c4fb27, 0xb0de65388cc8ada8,
+		0x83c7088e1aab65db, 0xc45d1df942711d9a, 0x924d692ca61be758,
+		0xda01ee641a708dea, 0xa26da3999aef774a, 0xf209787bb47d6b85,
+		0xb454e4a179dd1877, 0x865b86925b9bc5c2, 0xc83553c5c8965d3d,
+		0x952ab45cfa97a0b3, 0xde469fbd99a05fe3, 0xa59bc234db398c25,
+		0xf6c69a72a3989f5c, 0xb7dcbf5354e9bece, 0x88fcf317f22241e2,
+		0xcc20ce9bd35c78a5, 0x98165af37b2153df, 0xe2a0b5dc971f303a,
+		0xa8d9d1535ce3b396, 0xfb9b7cd9a4a7443c, 0xbb764c4ca7a44410,
+		0x8bab8eefb6409c1a, 0xd01fef10a657842c, 0x9b10a4e5e9913129,
+		0xe7109bfba19c0c9d, 0xac2820d9623bf429, 0x80444b5e7aa7cf85,
+		0xbf21e44003acdd2d, 0x8e679c2f5e44ff8f, 0xd433179d9c8cb841,
+		0x9e19db92b4e31ba9, 0xeb96bf6ebadf77d9, 0xaf87023b9bf0ee6b
+	};
+
+	const int16_t cachedPowersE[] =
+	{
+		-1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+		-954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+		-688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+		-422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+		-157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+		109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+		375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+		641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+		907, 933, 960, 986, 1013, 1039, 1066
+	};
+
+	// Power of ten c = 10^-k, which moves the product with a value of
+	// binary exponent `e` into the exponent range of the digit generation
+	inline DiyFp
+	getCachedPower(int e, int& k)
+	{
+		// ceil((-61 - e) * log10(2)) with log10(2) ~ 78913 / 2^18
+		const int32_t exponent = ((int32_t(-61 - e) * 78913) + ((1 << 18) - 1)) >> 18;
+		const uint_fast8_t index = ((exponent + 347) >> 3) + 1;
+
+		k = -(-348 + int(index) * 8);
+		return makeDiyFp(cachedPowersF[index], cachedPowersE[index]);
+	}
+
+	const uint32_t powersOfTen[] =
+	{
+		1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+	};
+
+	inline uint_fast8_t
+	countDigits(uint32_t value)
+	{
+		uint_fast8_t digits = 1;
+		while (digits < 10 and value >= powersOfTen[digits]) {
+			digits++;
+		}
+		return digits;
+	}
+
+	// Move the last digit towards the exact value, as long as the result
+	// stays within the rounding interval
+	inline void
+	roundWeed(char *digits, int length, uint64_t delta, uint64_t rest,
+			uint64_t tenKappa, uint64_t distance)
+	{
+		while (rest < distance and delta - rest >= tenKappa and
+				(rest + tenKappa < distance or
+				 distance - rest > rest + tenKappa - distance))
+		{
+			digits[length - 1]--;
+			rest += tenKappa;
+		}
+	}
+
+	int
+	generateDigits(const DiyFp& w, const DiyFp& upper, uint64_t delta,
+			char *digits, int& k)
+	{
+		const DiyFp one = makeDiyFp(uint64_t(1) << -upper.e, upper.e);
+		uint64_t distance = upper.f - w.f;
+
+		uint32_t integral = static_cast<uint32_t>(upper.f >> -one.e);
+		uint64_t fractional = upper.f & (one.f - 1);
+
+		int kappa = countDigits(integral);
+		int length = 0;
+
+		while (kappa > 0)
+		{
+			const uint32_t divisor = powersOfTen[kappa - 1];
+			const uint32_t digit = integral / divisor;
+			integral -= digit * divisor;
+
+			if (digit or length) {
+				digits[length++] = static_cast<char>('0' + digit);
+			}
+			kappa--;
+
+			const uint64_t rest = (static_cast<uint64_t>(integral) << -one.e) + fractional;
+			if (rest <= delta)
+			{
+				k += kappa;
+				roundWeed(digits, length, delta, rest,
+						static_cast<uint64_t>(powersOfTen[kappa]) << -one.e, distance);
+				return length;
+			}
+		}
+
+		while (true)
+		{
+			fractional *= 10;
+			delta *= 10;
+			distance *= 10;
+
+			const char digit = static_cast<char>(fractional >> -one.e);
+			if (digit or length) {
+				digits[length++] = static_cast<char>('0' + digit);
+			}
+			fractional &= one.f - 1;
+			kappa--;
+
+			if (fractional < delta)
+			{
+				k += kappa;
+				roundWeed(digits, length, delta, fractional, one.f, distance);
+				return length;
+			}
+		}
+	}
+
+	// Decimal representation of a finite value: digits * 10^exponent
+	struct Decimal
+	{
+		char digits[40];
+		int length;
+		int exponent;
+	};
+
+	/**
+	 * Grisu2 for a value `f * 2^e`.
+	 *
+	 * @param	lowerCloser		`true` if the next smaller value is only
+	 * 							half as far away (power of two)
+	 */
+	void
+	grisu2(uint64_t f, int e, bool lowerCloser, Decimal& result)
+	{
+		if (f == 0)
+		{
+			result.digits[0] = '0';
+			result.length = 1;
+			result.exponent = 0;
+			return;
+		}
+
+		const DiyFp upper = normalize(makeDiyFp((f << 1) + 1, e - 1));
+		DiyFp lower = lowerCloser ? makeDiyFp((f << 2) - 1, e - 2) :
+									makeDiyFp((f << 1) - 1, e - 1);
+		lower.f <<= lower.e - upper.e;
+		lower.e = upper.e;
+
+		int k;
+		const DiyFp power = getCachedPower(upper.e, k);
+
+		const DiyFp w = multiply(normalize(makeDiyFp(f, e)), power);
+		DiyFp wUpper = multiply(upper, power);
+		DiyFp wLower = multiply(lower, power);
+		wLower.f++;
+		wUpper.f--;
+
+		result.exponent = k;
+		result.length = generateDigits(w, wUpper, wUpper.f - wLower.f,
+				result.digits, result.exponent);
+	}
+
+	enum class
+	Class : uint8_t
+	{
+		Finite,
+		Infinite,
+		NotANumber,
+	};
+
+	Class
+	decompose(float value, bool& negative, Decimal& decimal)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+
+		negative = (bits >> 31);
+		const uint32_t biased = (bits >> 23) & 0xff;
+		const uint32_t significand = bits & 0x7fffff;
+
+		if (biased == 0xff) {
+			return (significand == 0) ? Class::Infinite : Class::NotANumber;
+		}
+
+		if (biased == 0) {
+			grisu2(significand, -149, false, decimal);
+		}
+		else {
+			grisu2(significand | 0x800000, int(biased) - 150,
+					(significand == 0 and biased > 1), decimal);
+		}
+		return Class::Finite;
+	}
+
+	Class
+	decompose(double value, bool& negative, Decimal& decimal)
+	{
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+
+		negative = (bits >> 63);
+		const uint32_t biased = (bits >> 52) & 0x7ff;
+		const uint64_t significand = bits & 0xfffffffffffffull;
+
+		if (biased == 0x7ff) {
+			return (significand == 0) ? Class::Infinite : Class::NotANumber;
+		}
+
+		if (biased == 0) {
+			grisu2(significand, -1074, false, decimal);
+		}
+		else {
+			grisu2(significand | 0x10000000000000ull, int(biased) - 1075,
+					(significand == 0 and biased > 1), decimal);
+		}
+		return Class::Finite;
+	}
+
+	// ------------------------------------------------------------------------
+	char *
+	writeString(char *buffer, const char *str)
+	{
+		while (*str) {
+			*buffer++ = *str++;
+		}
+		*buffer = '\0';
+		return buffer;
+	}
+
+	char *
+	writeSpecial(char *buffer, Class type, bool negative)
+	{
+		if (type == Class::NotANumber) {
+			return writeString(buffer, "nan");
+		}
+		if (negative) {
+			*buffer++ = '-';
+		}
+		return writeString(buffer, "inf");
+	}
+
+	// Round to `count` significant digits, half to even. Returns `true` if
+	// the carry has propagated out of the first digit, which is then "1".
+	bool
+	roundDigits(Decimal& decimal, int count)
+	{
+		if (count >= decimal.length) {
+			return false;
+		}
+		if (count < 0)
+		{
+			decimal.length = 0;
+			return false;
+		}
+
+		bool up = false;
+		const char next = decimal.digits[count];
+		if (next > '5') {
+			up = true;
+		}
+		else if (next == '5')
+		{
+			for (int i = count + 1; i < decimal.length; ++i) {
+				up = up or (decimal.digits[i] != '0');
+			}
+			// exactly in the middle
+			if (not up) {
+				up = (count > 0) and ((decimal.digits[count - 1] - '0') & 1);
+			}
+		}
+
+		decimal.exponent += decimal.length - count;
+		decimal.length = count;
+
+		if (up)
+		{
+			for (int i = count - 1; i >= 0; --i)
+			{
+				if (decimal.digits[i] != '9')
+				{
+					decimal.digits[i]++;
+					return false;
+				}
+				decimal.digits[i] = '0';
+			}
+
+			// all digits were nine (or there were none)
+			decimal.digits[0] = '1';
+			decimal.length = (count > 0) ? count : 1;
+			decimal.exponent += (count > 0) ? 1 : 0;
+			return true;
+		}
+		return false;
+	}
+
+	// ------------------------------------------------------------------------
+	const uint64_t powersOf10[] =
+	{
+		1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+		10000000ull, 100000000ull, 1000000000ull, 10000000000ull,
+		100000000000ull, 1000000000000ull, 10000000000000ull,
+		100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+		100000000000000000ull,
+	};
+
+	/**
+	 * Checks if rounding the shortest representation to `count` significant
+	 * digits may give another result than rounding the exact value.
+	 *
+	 * Both differ by at most half a unit in the last place of the `double`,
+	 * i.e. less than 2^-53 of the value unless it is subnormal. Rounding
+	 * gives the same result, unless a point in the middle between two
+	 * outputs lies within twice this distance from the shortest digits.
+	 */
+	bool
+	isAmbiguous(double value, const Decimal& decimal, int count)
+	{
+		if (decimal.length == 1 and decimal.digits[0] == '0') {
+			return false;
+		}
+		if (value < 2.2250738585072014e-308 or count > 15) {
+			return true;
+		}
+		if (count < 0) {
+			// less than a tenth of the unit of the result
+			return false;
+		}
+
+		// the digits after the rounding position, padded with zeros
+		const int total = (decimal.length > count) ? decimal.length : (count + 1);
+		uint64_t rest = 0;
+		for (int i = count; i < total; ++i) {
+			rest = rest * 10 + ((i < decimal.length) ? (decimal.digits[i] - '0') : 0);
+		}
+
+		const uint64_t middle = 5 * powersOf10[total - count - 1];
+		const uint64_t margin = (powersOf10[total] >> 52) + 1;
+		return (rest + margin > middle) and (rest < middle + margin);
+	}
+
+	// Little-endian multiple precision integer, large enough for the
+	// integer part (< 2^1024) and for the fraction (1074 bits) of a `double`
+	// multiplied by 10^9.
+	struct BigInteger
+	{
+		uint32_t words[35];
+		int size;
+	};
+
+	void
+	trim(BigInteger& value)
+	{
+		while (value.size > 0 and value.words[value.size - 1] == 0) {
+			value.size--;
+		}
+	}
+
+	// Divides by 10^9, returns the remainder
+	uint32_t
+	divideChunk(BigInteger& value)
+	{
+		uint64_t remainder = 0;
+		for (int i = value.size - 1; i >= 0; --i)
+		{
+			const uint64_t current = (remainder << 32) | value.words[i];
+			value.words[i] = current / 1000000000;
+			remainder = current % 1000000000;
+		}
+		trim(value);
+		return remainder;
+	}
+
+	// Multiplies the fraction `value / 2^bits` by 10^9, returns the integer
+	// part and keeps the fraction
+	uint32_t
+	multiplyChunk(BigInteger& value, int bits)
+	{
+		uint64_t carry = 0;
+		for (int i = 0; i < value.size; ++i)
+		{
+			carry += uint64_t(value.words[i]) * 1000000000;
+			value.words[i] = carry;
+			carry >>= 32;
+		}
+		if (carry != 0) {
+			value.words[value.size++] = carry;
+		}
+
+		const int index = bits / 32;
+		if (value.size <= index) {
+			return 0;
+		}
+
+		// less than 2^30, in at most two words
+		uint64_t chunk = 0;
+		for (int i = value.size - 1; i >= index; --i) {
+			chunk = (chunk << 32) | value.words[i];
+		}
+		chunk >>= bits % 32;
+
+		value.words[index] &= (uint32_t(1) << (bits % 32)) - 1;
+		value.size = index + 1;
+		trim(value);
+		return chunk;
+	}
+
+	// Collects the significant digits of the exact value down to the
+	// position of the digit which decides the rounding
+	struct DigitCollector
+	{
+		int position;		// of the next digit, 0 for the ones
+		int first;			// position of the first significant digit
+		int last;			// position of the digit which decides the rounding
+		int significant;	// number of significant digits, 0 for fixed
+		bool sticky;		// a non-zero digit follows the last position
+	};
+
+	void
+	collectChunk(DigitCollector& collector, Decimal& decimal, uint32_t chunk)
+	{
+		char digits[9];
+		for (int i = 8; i >= 0; --i)
+		{
+			digits[i] = '0' + chunk % 10;
+			chunk /= 10;
+		}
+
+		for (int i = 0; i < 9; ++i, --collector.position)
+		{
+			if (decimal.length == 0)
+			{
+				if (digits[i] == '0') {
+					continue;
+				}
+				collector.first = collector.position;
+				if (collector.significant > 0) {
+					collector.last = collector.position - collector.significant;
+				}
+			}
+
+			if (collector.position >= collector.last) {
+				decimal.digits[decimal.length++] = digits[i];
+			}
+			else if (digits[i] != '0') {
+				collector.sticky = true;
+			}
+		}
+	}
+
+	/**
+	 * Rounds the exact value to `precision` digits after the decimal point,
+	 * or to `significant` digits if that is not zero. Like printf() it
+	 * rounds half to even.
+	 *
+	 * The integer part is converted by repeated division by 10^9, the
+	 * fraction by repeated multiplication until the rounding position is
+	 * reached. This needs about 300 bytes of stack.
+	 */
+	void
+	roundExact(double value, int precision, int significant, Decimal& decimal)
+	{
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+
+		const uint32_t biased = (bits >> 52) & 0x7ff;
+		uint64_t significand = bits & 0xfffffffffffffull;
+		int exponent = -1074;
+		if (biased != 0)
+		{
+			significand |= 0x10000000000000ull;
+			exponent = int(biased) - 1075;
+		}
+
+		BigInteger integer = {};
+		BigInteger fraction = {};
+		if (exponent >= 0)
+		{
+			const int index = exponent / 32;
+			const int shift = exponent % 32;
+			const uint64_t low = significand << shift;
+			integer.words[index] = low;
+			integer.words[index + 1] = low >> 32;
+			integer.words[index + 2] = (shift > 0) ? (significand >> (64 - shift)) : 0;
+			integer.size = index + 3;
+		}
+		else
+		{
+			const int shift = -exponent;
+			uint64_t rest = significand;
+			if (shift < 64)
+			{
+				const uint64_t whole = significand >> shift;
+				integer.words[0] = whole;
+				integer.words[1] = whole >> 32;
+				integer.size = 2;
+				rest &= (uint64_t(1) << shift) - 1;
+			}
+			fraction.words[0] = rest;
+			fraction.words[1] = rest >> 32;
+			fraction.size = 2;
+		}
+		trim(integer);
+		trim(fraction);
+
+		DigitCollector collector = { 0, 0, -precision - 1, significant, false };
+		decimal.length = 0;
+
+		// the chunks of the integer part are generated in reverse order
+		uint32_t chunks[35];
+		int count = 0;
+		while (integer.size > 0) {
+			chunks[count++] = divideChunk(integer);
+		}
+		collector.position = 9 * count - 1;
+		while (count > 0) {
+			collectChunk(collector, decimal, chunks[--count]);
+		}
+
+		while (fraction.size > 0 and (collector.position >= collector.last or
+				(significant > 0 and decimal.length == 0))) {
+			collectChunk(collector, decimal, multiplyChunk(fraction, -exponent));
+		}
+		if (fraction.size > 0) {
+			collector.sticky = true;
+		}
+
+		if (decimal.length == 0)
+		{
+			// less than a tenth of the unit of the last digit
+			decimal.exponent = collector.last + 1;
+			return;
+		}
+
+		decimal.exponent = collector.first - decimal.length + 1;
+		if (collector.sticky)
+		{
+			// stands for all following digits, which are only needed to
+			// decide if the value is exactly in the middle
+			decimal.digits[decimal.length++] = '1';
+			decimal.exponent--;
+		}
+		roundDigits(decimal, collector.first - collector.last);
+	}
+
+	char *
+	writeExponent(char *buffer, int exponent)
+	{
+		*buffer++ = 'e';
+		if (exponent < 0) {
+			*buffer++ = '-';
+			exponent = -exponent;
+		}
+		else {
+			*buffer++ = '+';
+		}
+		if (exponent < 10) {
+			*buffer++ = '0';
+		}
+		return xpcc::format::writeDecimal(buffer, static_cast<uint32_t>(exponent));
+	}
+
+	char *
+	layoutShortest(char *buffer, const Decimal& decimal)
+	{
+		// position of the decimal point relative to the first digit
+		const int point = decimal.length + decimal.exponent;
+
+		if (0 < point and point <= 21)
+		{
+			for (int i = 0; i < point or i < decimal.length; ++i)
+			{
+				if (i == point) {
+					*buffer++ = '.';
+				}
+				*buffer++ = (i < decimal.length) ? decimal.digits[i] : '0';
+			}
+		}
+		else if (-6 < point and point <= 0)
+		{
+			*buffer++ = '0';
+			*buffer++ = '.';
+			for (int i = point; i < 0; ++i) {
+				*buffer++ = '0';
+			}
+			for (int i = 0; i < decimal.length; ++i) {
+				*buffer++ = decimal.digits[i];
+			}
+		}
+		else
+		{
+			*buffer++ = decimal.digits[0];
+			if (decimal.length > 1)
+			{
+				*buffer++ = '.';
+				for (int i = 1; i < decimal.length; ++i) {
+					*buffer++ = decimal.digits[i];
+				}
+			}
+			return writeExponent(buffer, point - 1);
+		}
+		*buffer = '\0';
+		return buffer;
+	}
+
+	char *
+	layoutScientific(char *buffer, Decimal& decimal, uint8_t precision)
+	{
+		int exponent = 0;
+		if (not (decimal.length == 1 and decimal.digits[0] == '0'))
+		{
+			roundDigits(decimal, precision + 1);
+			exponent = decimal.length + decimal.exponent - 1;
+		}
+
+		*buffer++ = decimal.digits[0];
+		if (precision > 0)
+		{
+			*buffer++ = '.';
+			for (int i = 1; i <= precision; ++i) {
+				*buffer++ = (i < decimal.length) ? decimal.digits[i] : '0';
+			}
+		}
+		return writeExponent(buffer, exponent);
+	}
+
+	char *
+	layoutFixed(char *buffer, Decimal& decimal, uint8_t precision)
+	{
+		// round to `precision` digits after the decimal point
+		roundDigits(decimal, decimal.length + decimal.exponent + precision);
+
+		const int point = decimal.length + decimal.exponent;
+		if (point <= 0) {
+			*buffer++ = '0';
+		}
+		for (int i = 0; i < point; ++i) {
+			*buffer++ = (i < decimal.length) ? decimal.digits[i] : '0';
+		}
+		if (precision > 0)
+		{
+			*buffer++ = '.';
+			for (int i = point; i < point + precision; ++i) {
+				*buffer++ = (0 <= i and i < decimal.length) ? decimal.digits[i] : '0';
+			}
+		}
+		*buffer = '\0';
+		return buffer;
+	}
+
+	template <typename T>
+	char *
+	writeShortest(char *buffer, T value)
+	{
+		bool negative;
+		Decimal decimal;
+		const Class type = decompose(value, negative, decimal);
+		if (type != Class::Finite) {
+			return writeSpecial(buffer, type, negative);
+		}
+		if (negative) {
+			*buffer++ = '-';
+		}
+		return layoutShortest(buffer, decimal);
+	}
+
+	char *
+	writeScientific(char *buffer, double value, uint8_t precision)
+	{
+		bool negative;
+		Decimal decimal;
+		const Class type = decompose(value, negative, decimal);
+		if (type != Class::Finite) {
+			return writeSpecial(buffer, type, negative);
+		}
+		if (negative) {
+			*buffer++ = '-';
+		}
+		if (precision > xpcc::format::MaxPrecision) {
+			precision = xpcc::format::MaxPrecision;
+		}
+		if (isAmbiguous(negative ? -value : value, decimal, precision + 1)) {
+			roundExact(value, 0, precision + 1, decimal);
+		}
+		return layoutScientific(buffer, decimal, precision);
+	}
+
+	char *
+	writeFixed(char *buffer, double value, uint8_t precision)
+	{
+		bool negative;
+		Decimal decimal;
+		const Class type = decompose(value, negative, decimal);
+		if (type != Class::Finite) {
+			return writeSpecial(buffer, type, negative);
+		}
+		if (negative) {
+			*buffer++ = '-';
+		}
+		if (precision > xpcc::format::MaxPrecision) {
+			precision = xpcc::format::MaxPrecision;
+		}
+		const double magnitude = negative ? -value : value;
+		if (decimal.length + decimal.exponent > 21)
+		{
+			if (isAmbiguous(magnitude, decimal, precision + 1)) {
+				roundExact(value, 0, precision + 1, decimal);
+			}
+			return layoutScientific(buffer, decimal, precision);
+		}
+		if (isAmbiguous(magnitude, decimal, decimal.length + decimal.exponent + precision)) {
+			roundExact(value, precision, 0, decimal);
+		}
+		return layoutFixed(buffer, decimal, precision);
+	}
+}
+
+// ----------------------------------------------------------------------------
+char *
+xpcc::format::writeShortest(char *buffer, float value)
+{
+	return ::writeShortest(buffer, value);
+}
+
+// A float converted to double keeps its exact value
+char *
+xpcc::format::writeScientific(char *buffer, float value, uint8_t precision)
+{
+	return ::writeScientific(buffer, static_cast<double>(value), precision);
+}
+
+char *
+xpcc::format::writeFixed(char *buffer, float value, uint8_t precision)
+{
+	return ::writeFixed(buffer, static_cast<double>(value), precision);
+}
+
+char *
+xpcc::format::writeShortest(char *buffer, double value)
+{
+	return ::writeShortest(buffer, value);
+}
+
+char *
+xpcc::format::writeScientific(char *buffer, double value, uint8_t precision)
+{
+	return ::writeScientific(buffer, value, precision);
+}
+
+char *
+xpcc::format::writeFixed(char *buffer, double value, uint8_t precision)
+{
+	return ::writeFixed(buffer, value, precision);
+}
+
+#endif
@@ -0,0 +1,257 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "mapped_file_device.hpp"
+
+xpcc::hosted::MappedFileDevice::MappedFileDevice() :
+	nextChunkSize(16 * 1024 * 1024), chunkSize(nextChunkSize), sync(Sync::Chunk), maxFileSize(0), maxFiles(0),
+	fileDescriptor(-1), chunk(nullptr), chunkOffset(0), position(0)
+{
+}
+
+xpcc::hosted::MappedFileDevice::~MappedFileDevice()
+{
+	close();
+}
+
+// ----------------------------------------------------------------------------
+void
+xpcc::hosted::MappedFileDevice::setChunkSize(std::size_t size)
+{
+	const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+	if (size < pageSize) {
+		size = pageSize;
+	}
+	nextChunkSize = (size + pageSize - 1) / pageSize * pageSize;
+}
+
+void
+xpcc::hosted::MappedFileDevice::setSync(Sync sync)
+{
+	this->sync = sync;
+}
+
+void
+xpcc::hosted::MappedFileDevice::setRotation(std::size_t maxFileSize, unsigned int maxFiles)
+{
+	this->maxFileSize = maxFileSize;
+	this->maxFiles = maxFiles;
+}
+
+// ----------------------------------------------------------------------------
+bool
+xpcc::hosted::MappedFileDevice::open(const std::string& path)
+{
+	close();
+	this->path = path;
+	return openFile();
+}
+
+bool
+xpcc::hosted::MappedFileDevice::isOpen() const
+{
+	return (chunk != nullptr);
+}
+
+void
+xpcc::hosted::MappedFileDevice::close()
+{
+	closeFile();
+}
+
+std::size_t
+xpcc::hosted::MappedFileDevice::getLength() const
+{
+	return chunkOffset + position;
+}
+
+// ----------------------------------------------------------------------------
+bool
+xpcc::hosted::MappedFileDevice::openFile()
+{
+	fileDescriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fileDescriptor < 0)
+	{
+		std::cerr << "Failed to open " << path << ": " << std::strerror(errno) << std::endl;
+		return false;
+	}
+
+	// the chunk size must not change while a chunk is mapped
+	chunkSize = nextChunkSize;
+	chunkOffset = 0;
+	if (not mapChunk())
+	{
+		::close(fileDescriptor);
+		fileDescriptor = -1;
+		return false;
+	}
+	return true;
+}
+
+void
+xpcc::hosted::MappedFileDevice::closeFile()
+{
+	if (fileDescriptor < 0) {
+		return;
+	}
+
+	const std::size_t length = getLength();
+	if (chunk != nullptr)
+	{
+		if (sync != Sync::Never) {
+			msync(chunk, position, MS_SYNC);
+		}
+		unmapChunk();
+	}
+
+	// remove the unused rest of the last chunk
+	if (ftruncate(fileDescriptor, length) != 0) {
+		std::cerr << "Failed to truncate " << path << ": " << std::strerror(errno) << std::endl;
+	}
+	if (sync != Sync::Never) {
+		fsync(fileDescriptor);
+	}
+	::close(fileDescriptor);
+	fileDescriptor = -1;
+}
+
+bool
+xpcc::hosted::MappedFileDevice::mapChunk()
+{
+	// grow the file first, writing to a mapping beyond its end fails
+	if (ftruncate(fileDescriptor, chunkOffset + chunkSize) != 0)
+	{
+		std::cerr << "Failed to grow " << path << ": " << std::strerror(errno) << std::endl;
+		return false;
+	}
+
+	void *memory = mmap(nullptr, chunkSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+			fileDescriptor, chunkOffset);
+	if (memory == MAP_FAILED)
+	{
+		std::cerr << "Failed to map " << path << ": " << std::strerror(errno) << std::endl;
+		return false;
+	}
+	chunk = static_cast<uint8_t *>(memory);
+	position = 0;
+	return true;
+}
+
+void
+xpcc::hosted::MappedFileDevice::unmapChunk()
+{
+	munmap(chunk, chunkSize);
+	chunk = nullptr;
+}
+
+void
+xpcc::hosted::MappedFileDevice::rotate()
+{
+	closeFile();
+
+	// trace.log.(n-1) -> trace.log.n, ..., trace.log -> trace.log.1
+	if (maxFiles == 0) {
+		std::remove(path.c_str());
+	}
+	else
+	{
+		std::remove((path + '.' + std::to_string(maxFiles)).c_str());
+		for (unsigned int i = maxFiles - 1; i > 0; --i)
+		{
+			std::rename((path + '.' + std::to_string(i)).c_str(),
+					(path + '.' + std::to_string(i + 1)).c_str());
+		}
+		std::rename(path.c_str(), (path + ".1").c_str());
+	}
+
+	openFile();
+}
+
+// ----------------------------------------------------------------------------
+void
+xpcc::hosted::MappedFileDevice::write(char c)
+{
+	if (chunk != nullptr and position < chunkSize and
+			(maxFileSize == 0 or getLength() < maxFileSize)) {
+		chunk[position++] = c;
+	}
+	else {
+		write(reinterpret_cast<const uint8_t *>(&c), 1);
+	}
+}
+
+void
+xpcc::hosted::MappedFileDevice::write(const uint8_t* data, std::size_t length)
+{
+	if (chunk == nullptr) {
+		return;
+	}
+
+	if (maxFileSize != 0 and getLength() != 0 and getLength() + length > maxFileSize)
+	{
+		rotate();
+		if (chunk == nullptr) {
+			return;
+		}
+	}
+
+	while (length > 0)
+	{
+		if (position == chunkSize)
+		{
+			// the data since the last flush() is only in this chunk
+			if (sync != Sync::Never) {
+				msync(chunk, chunkSize, MS_SYNC);
+			}
+			unmapChunk();
+
+			chunkOffset += chunkSize;
+			if (not mapChunk())
+			{
+				// keep the written data, further writes are ignored
+				chunkOffset -= chunkSize;
+				position = chunkSize;
+				closeFile();
+				return;
+			}
+		}
+
+		std::size_t count = chunkSize - position;
+		if (count > length) {
+			count = length;
+		}
+		std::memcpy(chunk + position, data, count);
+		position += count;
+		data += count;
+		length -= count;
+	}
+}
+
+void
+xpcc::hosted::MappedFileDevice::flush()
+{
+	if (sync == Sync::Flush and chunk != nullptr) {
+		msync(chunk, position, MS_SYNC);
+	}
+}
+
+bool
+xpcc::hosted::MappedFileDevice::read(char&)
+{
+	return false;
+}
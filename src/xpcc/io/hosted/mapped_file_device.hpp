@@ -0,0 +1,158 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_HOSTED__MAPPED_FILE_DEVICE_HPP
+#define XPCC_HOSTED__MAPPED_FILE_DEVICE_HPP
+
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+
+#include <xpcc/io/iodevice.hpp>
+
+namespace xpcc
+{
+
+namespace hosted
+{
+
+/**
+ * Writes into a memory-mapped file.
+ *
+ * The file is mapped in chunks: writing only copies the data into the
+ * current chunk, a system call is needed only every few megabytes when
+ * the file grows and the next chunk is mapped. Text of an IOStream or
+ * Logger as well as raw binary traces can therefore be captured at the
+ * speed of the memory.
+ *
+ * @code
+ * xpcc::hosted::MappedFileDevice trace;
+ * trace.setRotation(256 * 1024 * 1024, 4);
+ * trace.open("sensors.log");
+ *
+ * xpcc::log::Logger xpcc::log::info(trace);
+ * @endcode
+ *
+ * While the file is open its size is a multiple of the chunk size, the
+ * unused rest is filled with zeros. close() truncates it to the written
+ * length.
+ *
+ * Data in the mapped memory survives a crash of the program, but not of
+ * the operating system. The Sync policy defines when the data is written
+ * to the disk explicitly.
+ *
+ * If a maximum file size is set, the file is rotated like by `logrotate`
+ * before a write would exceed it: `trace.log` is renamed to
+ * `trace.log.1`, `trace.log.1` to `trace.log.2` and so on, the oldest
+ * file is deleted. A single write is never split between two files.
+ *
+ * The device is not thread-safe.
+ *
+ * @ingroup	io
+ */
+class MappedFileDevice : public IODevice
+{
+public:
+	using IODevice::write;
+	using IODevice::read;
+
+	/// When the data is written to the disk with `msync()`
+	enum class
+	Sync
+	{
+		Never,	///< only by the operating system and on close()
+		Chunk,	///< every time a chunk is full
+		Flush,	///< on every flush(), e.g. at every xpcc::endl, and every time a chunk is full
+	};
+
+	MappedFileDevice();
+
+	/// Closes the file
+	~MappedFileDevice();
+
+	/// Size of the mapped chunks, rounded up to a multiple of the page
+	/// size. Takes effect with the next open().
+	void
+	setChunkSize(std::size_t size);
+
+	void
+	setSync(Sync sync);
+
+	/**
+	 * Rotate the file before it exceeds `maxFileSize` bytes.
+	 *
+	 * @param	maxFileSize	0 disables the rotation
+	 * @param	maxFiles	Number of old files kept
+	 */
+	void
+	setRotation(std::size_t maxFileSize, unsigned int maxFiles);
+
+	/// Create or truncate the file
+	bool
+	open(const std::string& path);
+
+	bool
+	isOpen() const;
+
+	/// Write all data to the disk, truncate the file and close it
+	void
+	close();
+
+	/// Number of bytes written to the current file
+	std::size_t
+	getLength() const;
+
+	virtual void
+	write(char c);
+
+	virtual void
+	write(const uint8_t* data, std::size_t length);
+
+	/// Writes the data to the disk with the Sync::Flush policy
+	virtual void
+	flush();
+
+	/// Always `false`, the device is write-only
+	virtual bool
+	read(char& c);
+
+private:
+	bool
+	openFile();
+
+	void
+	closeFile();
+
+	bool
+	mapChunk();
+
+	void
+	unmapChunk();
+
+	void
+	rotate();
+
+	std::string path;
+	std::size_t nextChunkSize;	///< chunk size for the next open()
+	std::size_t chunkSize;		///< chunk size of the open file
+	Sync sync;
+	std::size_t maxFileSize;
+	unsigned int maxFiles;
+
+	int fileDescriptor;
+	uint8_t* chunk;				///< currently mapped chunk
+	std::size_t chunkOffset;	///< offset of the chunk in the file
+	std::size_t position;		///< write position in the chunk
+};
+
+}	// namespace hosted
+
+}	// namespace xpcc
+
+#endif	// XPCC_HOSTED__MAPPED_FILE_DEVICE_HPP
@@ -0,0 +1,184 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/io/hosted/mapped_file_device.hpp>
+#include <xpcc/io/iostream.hpp>
+
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <sstream>
+
+#include <unistd.h>
+
+#include "mapped_file_device_test.hpp"
+
+namespace
+{
+	std::string path;
+
+	bool
+	exists(const std::string& file)
+	{
+		return (access(file.c_str(), F_OK) == 0);
+	}
+
+	std::string
+	readFile(const std::string& file)
+	{
+		std::ifstream stream(file, std::ios::binary);
+		std::ostringstream content;
+		content << stream.rdbuf();
+		return content.str();
+	}
+}
+
+void
+MappedFileDeviceTest::setUp()
+{
+	path = "/tmp/xpcc_mapped_file_test_" + std::to_string(getpid()) + ".log";
+}
+
+void
+MappedFileDeviceTest::tearDown()
+{
+	std::remove(path.c_str());
+	for (int i = 1; i <= 4; ++i) {
+		std::remove((path + '.' + std::to_string(i)).c_str());
+	}
+}
+
+// ----------------------------------------------------------------------------
+void
+MappedFileDeviceTest::testStream()
+{
+	xpcc::hosted::MappedFileDevice device;
+	TEST_ASSERT_FALSE(device.isOpen());
+	TEST_ASSERT_TRUE(device.open(path));
+	TEST_ASSERT_TRUE(device.isOpen());
+
+	xpcc::IOStream stream(device);
+	stream << "value=" << 42 << xpcc::endl;
+	stream << 'x';
+	TEST_ASSERT_EQUALS(device.getLength(), 10U);
+
+	char c;
+	TEST_ASSERT_FALSE(device.read(c));
+
+	device.close();
+	TEST_ASSERT_FALSE(device.isOpen());
+
+	// the unused rest of the chunk is removed
+	TEST_ASSERT_TRUE(readFile(path) == "value=42\nx");
+
+	// writing to a closed device is ignored
+	stream << "lost";
+	TEST_ASSERT_EQUALS(device.getLength(), 10U);
+}
+
+void
+MappedFileDeviceTest::testGrowth()
+{
+	xpcc::hosted::MappedFileDevice device;
+	device.setChunkSize(1);		// one page
+	TEST_ASSERT_TRUE(device.open(path));
+
+	const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+	std::string expected;
+
+	// blocks which don't fit into the rest of a chunk
+	std::string block(pageSize / 3, ' ');
+	for (int i = 0; i < 10; ++i)
+	{
+		block.assign(block.size(), 'a' + i);
+		device.write(reinterpret_cast<const uint8_t *>(block.data()), block.size());
+		device.write('\n');
+		expected += block + '\n';
+	}
+
+	// a block larger than several chunks
+	std::string large(pageSize * 3 + 7, 'z');
+	device.write(reinterpret_cast<const uint8_t *>(large.data()), large.size());
+	expected += large;
+
+	TEST_ASSERT_EQUALS(device.getLength(), expected.size());
+	device.close();
+	TEST_ASSERT_TRUE(readFile(path) == expected);
+}
+
+void
+MappedFileDeviceTest::testChunkSizeWhileOpen()
+{
+	xpcc::hosted::MappedFileDevice device;
+	device.setChunkSize(1);		// one page
+	TEST_ASSERT_TRUE(device.open(path));
+
+	// the open file keeps its chunk size
+	device.setChunkSize(1 << 20);
+	std::string block(200000, 'a');
+	device.write(reinterpret_cast<const uint8_t *>(block.data()), block.size());
+	TEST_ASSERT_EQUALS(device.getLength(), block.size());
+	device.close();
+	TEST_ASSERT_TRUE(readFile(path) == block);
+
+	// and the next one uses the new size
+	TEST_ASSERT_TRUE(device.open(path));
+	device.write(reinterpret_cast<const uint8_t *>(block.data()), block.size());
+	device.close();
+	TEST_ASSERT_TRUE(readFile(path) == block);
+}
+
+void
+MappedFileDeviceTest::testRotation()
+{
+	xpcc::hosted::MappedFileDevice device;
+	device.setRotation(10, 2);
+	TEST_ASSERT_TRUE(device.open(path));
+
+	xpcc::IOStream stream(device);
+	stream << "first";
+	stream << "12345";		// fills the file exactly
+	stream << "second";		// would exceed the size
+	stream << "thrd";
+	stream << "fourth";
+	stream << "fifth";
+	device.close();
+
+	TEST_ASSERT_TRUE(readFile(path) == "fifth");
+	TEST_ASSERT_TRUE(readFile(path + ".1") == "fourth");
+	TEST_ASSERT_TRUE(readFile(path + ".2") == "secondthrd");
+	TEST_ASSERT_FALSE(exists(path + ".3"));
+
+	// without old files the full file is replaced
+	device.setRotation(4, 0);
+	TEST_ASSERT_TRUE(device.open(path));
+	device.write("abc");
+	device.write("defg");
+	device.close();
+	TEST_ASSERT_TRUE(readFile(path) == "defg");
+	TEST_ASSERT_TRUE(readFile(path + ".1") == "fourth");
+}
+
+void
+MappedFileDeviceTest::testSync()
+{
+	xpcc::hosted::MappedFileDevice device;
+	device.setSync(xpcc::hosted::MappedFileDevice::Sync::Flush);
+	TEST_ASSERT_TRUE(device.open(path));
+
+	xpcc::IOStream stream(device);
+	stream << "synced" << xpcc::endl;
+
+	// the data is visible in the file before it is closed
+	std::string content = readFile(path);
+	TEST_ASSERT_EQUALS(content.compare(0, 7, "synced\n"), 0);
+
+	device.close();
+	TEST_ASSERT_TRUE(readFile(path) == "synced\n");
+}
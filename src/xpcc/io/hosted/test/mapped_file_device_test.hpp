@@ -0,0 +1,35 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <unittest/testsuite.hpp>
+
+class MappedFileDeviceTest : public unittest::TestSuite
+{
+public:
+	virtual void
+	setUp();
+
+	virtual void
+	tearDown();
+
+	void
+	testStream();
+
+	void
+	testGrowth();
+
+	void
+	testChunkSizeWhileOpen();
+
+	void
+	testRotation();
+
+	void
+	testSync();
+};
@@ -7,14 +7,40 @@
  */
 // ----------------------------------------------------------------------------
 
+#include <string.h>
+
 #include "iodevice.hpp"
 
 // ----------------------------------------------------------------------------
 void
 xpcc::IODevice::write(const char* str)
 {
-	char c;
-	while ((c = *str++)) {
-		this->write(c);
+	this->write(reinterpret_cast<const uint8_t*>(str), strlen(str));
+}
+
+void
+xpcc::IODevice::write(const uint8_t* data, std::size_t length)
+{
+	for (std::size_t i = 0; i < length; ++i) {
+		this->write(static_cast<char>(data[i]));
+	}
+}
+
+void
+xpcc::IODevice::writeSegments(const Segment* segments, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i) {
+		this->write(static_cast<const uint8_t*>(segments[i].data), segments[i].length);
+	}
+}
+
+// ----------------------------------------------------------------------------
+std::size_t
+xpcc::IODevice::read(uint8_t* data, std::size_t length)
+{
+	std::size_t count = 0;
+	while (count < length and this->read(reinterpret_cast<char&>(data[count]))) {
+		count++;
 	}
+	return count;
 }
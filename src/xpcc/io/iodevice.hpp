@@ -10,6 +10,9 @@
 #ifndef XPCC_IODEVICE_HPP
 #define XPCC_IODEVICE_HPP
 
+#include <stdint.h>
+#include <cstddef>
+
 namespace xpcc
 {
 
@@ -22,6 +25,13 @@ namespace xpcc
 class IODevice
 {
 public :
+	/// Continuous block of memory, see writeSegments()
+	struct Segment
+	{
+		const void *data;
+		std::size_t length;
+	};
+
 	IODevice()
 	{
 	}
@@ -39,6 +49,28 @@ public :
 	virtual void
 	write(const char* str);
 
+	/**
+	 * Write a block of bytes.
+	 *
+	 * The default implementation calls `write(char)` for every byte.
+	 * Devices which can transfer a whole block at once (e.g. by DMA or
+	 * a single system call) should override this method.
+	 */
+	virtual void
+	write(const uint8_t* data, std::size_t length);
+
+	/**
+	 * Write several blocks of bytes in order (gather write).
+	 *
+	 * Allows to send e.g. a header and a payload from different places
+	 * without copying them into one buffer first. The default
+	 * implementation calls `write(const uint8_t*, std::size_t)` for every
+	 * segment. Devices which can transfer them at once (e.g. `writev()`)
+	 * should override this method.
+	 */
+	virtual void
+	writeSegments(const Segment* segments, std::size_t count);
+
 	virtual void
 	flush() = 0;
 
@@ -46,6 +78,17 @@ public :
 	virtual bool
 	read(char& c) = 0;
 
+	/**
+	 * Read up to `length` bytes.
+	 *
+	 * The default implementation calls `read(char&)` until no more
+	 * data is available.
+	 *
+	 * @return	Number of bytes read
+	 */
+	virtual std::size_t
+	read(uint8_t* data, std::size_t length);
+
 private :
 	IODevice(const IODevice&);
 };
@@ -11,12 +11,58 @@
 #define XPCC_IODEVICE_WRAPPER_HPP
 
 #include <stdint.h>
+#include <cstddef>
 
 #include "iodevice.hpp"
 
 namespace xpcc
 {
 
+/// @cond
+namespace iodevice_wrapper
+{
+	// Use the block methods of the peripheral if it has them, all UARTs
+	// do, other devices (e.g. Ft245) may only transfer single bytes.
+	template< class Device >
+	inline auto
+	write(const uint8_t *data, std::size_t length, int)
+		-> decltype(static_cast<std::size_t (*)(const uint8_t *, std::size_t)>(&Device::write), std::size_t())
+	{
+		return Device::write(data, length);
+	}
+
+	template< class Device >
+	inline std::size_t
+	write(const uint8_t *data, std::size_t length, long)
+	{
+		std::size_t count = 0;
+		while (count < length and Device::write(data[count])) {
+			count++;
+		}
+		return count;
+	}
+
+	template< class Device >
+	inline auto
+	read(uint8_t *data, std::size_t length, int)
+		-> decltype(static_cast<std::size_t (*)(uint8_t *, std::size_t)>(&Device::read), std::size_t())
+	{
+		return Device::read(data, length);
+	}
+
+	template< class Device >
+	inline std::size_t
+	read(uint8_t *data, std::size_t length, long)
+	{
+		std::size_t count = 0;
+		while (count < length and Device::read(data[count])) {
+			count++;
+		}
+		return count;
+	}
+}
+/// @endcond
+
 /// The preferred behavior when the IODevice buffer is full
 /// @ingroup	io
 enum class
@@ -55,6 +101,9 @@ IOBuffer
  * There is no default template argument, so that you hopefully make
  * a concious decision and be aware of this behavior.
  *
+ * If the peripheral can be fed by DMA, the DmaIODevice avoids both
+ * options with a large transmit buffer that is emptied in the background.
+ *
  * Example:
  * @code
  * // configure a UART
@@ -109,21 +158,24 @@ public:
 	virtual void
 	write(const char *s)
 	{
-		// this branch will be optimized away, since `behavior` is a template argument
-		if (behavior == IOBuffer::DiscardIfFull)
-		{
-			while (*s)
-			{
-				Device::write(static_cast<uint8_t>(*s));
-				s++;
-			}
+		const char *end = s;
+		while (*end) {
+			end++;
 		}
-		else
+		write(reinterpret_cast<const uint8_t *>(s), end - s);
+	}
+
+	/// Forwards the whole block to the peripheral, e.g. to start a DMA transfer
+	virtual void
+	write(const uint8_t *data, std::size_t length)
+	{
+		std::size_t count = iodevice_wrapper::write<Device>(data, length, 0);
+
+		// this branch will be optimized away, since `behavior` is a template argument
+		if (behavior == IOBuffer::BlockIfFull)
 		{
-			while (*s) {
-				while( !Device::write(static_cast<uint8_t>(*s)) )
-					;
-				s++;
+			while (count < length) {
+				count += iodevice_wrapper::write<Device>(data + count, length - count, 0);
 			}
 		}
 	}
@@ -138,6 +190,12 @@ public:
 	{
 		return Device::read(reinterpret_cast<uint8_t&>(c));
 	}
+
+	virtual std::size_t
+	read(uint8_t *data, std::size_t length)
+	{
+		return iodevice_wrapper::read<Device>(data, length, 0);
+	}
 };
 
 }
@@ -12,33 +12,55 @@
 #include <xpcc/utils/arithmetic_traits.hpp>
 #include <xpcc/architecture/driver/accessor/flash.hpp>
 
+#include "format.hpp"
 #include "iostream.hpp"
 
+#if defined(XPCC__CPU_AVR)
 FLASH_STORAGE(uint16_t base[]) = { 10, 100, 1000, 10000 };
+#endif
 
 // ----------------------------------------------------------------------------
 xpcc::IOStream::IOStream(IODevice& outputDevice) :
 	device(&outputDevice),
-	mode(Mode::Ascii)
+	mode(Mode::Ascii),
+	bufferLength(0)
 {
 }
 
+// ----------------------------------------------------------------------------
+void
+xpcc::IOStream::put(const char* s)
+{
+	char c;
+	while ((c = *s++)) {
+		this->put(c);
+	}
+}
+
 // ----------------------------------------------------------------------------
 void
 xpcc::IOStream::writeInteger(int16_t value)
 {
+#if defined(XPCC__CPU_AVR)
 	if (value < 0) {
-		this->device->write('-');
+		this->put('-');
 		this->writeInteger(static_cast<uint16_t>(-value));
 	}
 	else{
 		this->writeInteger(static_cast<uint16_t>(value));
 	}
+#else
+	char buffer[ArithmeticTraits<int16_t>::decimalDigits + 1]; // +1 for '\0'
+	format::writeDecimal(buffer, static_cast<int32_t>(value));
+	this->put(buffer);
+	this->flushBuffer();
+#endif
 }
 
 void
 xpcc::IOStream::writeInteger(uint16_t value)
 {
+#if defined(XPCC__CPU_AVR)
 	accessor::Flash<uint16_t> basePtr = xpcc::accessor::asFlash(base);
 
 	bool zero = true;
@@ -52,11 +74,17 @@ xpcc::IOStream::writeInteger(uint16_t value)
 			zero = false;
 		}
 		if (!zero) {
-			this->device->write(d);
+			this->put(d);
 		}
 	} while (i);
 
-	this->device->write(static_cast<char>(value) + '0');
+	this->put(static_cast<char>(value) + '0');
+#else
+	char buffer[ArithmeticTraits<uint16_t>::decimalDigits + 1]; // +1 for '\0'
+	format::writeDecimal(buffer, static_cast<uint32_t>(value));
+	this->put(buffer);
+#endif
+	this->flushBuffer();
 }
 
 void
@@ -68,81 +96,47 @@ xpcc::IOStream::writeInteger(int32_t value)
 	// Uses the optimized non standard function 'ltoa()' which is
 	// not always available.
 
-	this->device->write(ltoa(value, buffer, 10));
+	this->put(ltoa(value, buffer, 10));
 #else
-	if (value < 0) {
-		this->device->write('-');
-		this->writeInteger(static_cast<uint32_t>(-value));
-	}
-	else{
-		this->writeInteger(static_cast<uint32_t>(value));
-	}
+	char buffer[ArithmeticTraits<int32_t>::decimalDigits + 1]; // +1 for '\0'
+	format::writeDecimal(buffer, value);
+	this->put(buffer);
 #endif
+	this->flushBuffer();
 }
 
 void
 xpcc::IOStream::writeInteger(uint32_t value)
 {
-#if defined(XPCC__CPU_AVR)
 	char buffer[ArithmeticTraits<uint32_t>::decimalDigits + 1]; // +1 for '\0'
-
+#if defined(XPCC__CPU_AVR)
 	// Uses the optimized non standard function 'ultoa()' which is
 	// not always available.
-	this->device->write(ultoa(value, buffer, 10));
+	this->put(ultoa(value, buffer, 10));
 #else
-	char buffer[ArithmeticTraits<uint32_t>::decimalDigits + 1]; // +1 for '\0'
-
-	// ptr points to the end of the string, it will be filled backwards
-	char *ptr = buffer + ArithmeticTraits<uint32_t>::decimalDigits;
-
-	*ptr = '\0';
-
-	// calculate the string backwards
-	do{
-		uint32_t quot = value / 10;
-		uint8_t rem = value - quot*10;
-		*(--ptr) = static_cast<char>(rem) + '0';
-		value = quot;
-	}while (value != 0);
-
-	// write string
-	this->device->write(ptr);
+	format::writeDecimal(buffer, value);
+	this->put(buffer);
 #endif
+	this->flushBuffer();
 }
 
 #ifndef XPCC__CPU_AVR
 void
 xpcc::IOStream::writeInteger(int64_t value)
 {
-	if (value < 0) {
-		this->device->write('-');
-		this->writeInteger(static_cast<uint64_t>(-value));
-	}
-	else{
-		this->writeInteger(static_cast<uint64_t>(value));
-	}
+	char buffer[ArithmeticTraits<int64_t>::decimalDigits + 1]; // +1 for '\0'
+	format::writeDecimal(buffer, value);
+	this->put(buffer);
+	this->flushBuffer();
 }
 
 void
 xpcc::IOStream::writeInteger(uint64_t value)
 {
 	char buffer[ArithmeticTraits<uint64_t>::decimalDigits + 1]; // +1 for '\0'
-
-	// ptr points to the end of the string, it will be filled backwards
-	char *ptr = buffer + ArithmeticTraits<uint64_t>::decimalDigits;
-
-	*ptr = '\0';
-
-	// calculate the string backwards
-	do{
-		uint64_t quot = value / 10;
-		uint8_t rem = value - quot*10;
-		*(--ptr) = static_cast<char>(rem) + '0';
-		value = quot;
-	}while (value != 0);
-
-	// write string
-	this->device->write(ptr);
+	format::writeDecimal(buffer, value);
+	this->put(buffer);
+	this->flushBuffer();
 }
 #endif
 
@@ -151,9 +145,11 @@ void
 xpcc::IOStream::writeHex(const char* s)
 {
 	while (*s != '\0') {
-		this->writeHex(*s);
+		writeHexNibble(*s >> 4);
+		writeHexNibble(*s & 0xF);
 		s++;
 	}
+	this->flushBuffer();
 }
 
 void
@@ -176,7 +172,7 @@ xpcc::IOStream::writeHexNibble(uint8_t nibble)
 	else {
 		character = nibble + '0';
 	}
-	this->device->write(character);
+	this->put(character);
 }
 
 // ----------------------------------------------------------------------------
@@ -185,6 +181,7 @@ xpcc::IOStream::writeHex(uint8_t value)
 {
 	writeHexNibble(value >> 4);
 	writeHexNibble(value & 0xF);
+	this->flushBuffer();
 }
 
 void
@@ -193,14 +190,14 @@ xpcc::IOStream::writeBin(uint8_t value)
 	for (uint_fast8_t ii = 0; ii < 8; ii++)
 	{
 		if (value & 0x80) {
-			this->device->write('1');
+			this->put('1');
 		}
 		else {
-			this->device->write('0');
+			this->put('0');
 		}
 		value <<= 1;
 	}
-
+	this->flushBuffer();
 }
 
 // ----------------------------------------------------------------------------
@@ -221,8 +218,8 @@ xpcc::IOStream::operator << (const void* p)
 {
 #if XPCC__SIZEOF_POINTER == 2
 
-	this->device->write('0');
-	this->device->write('x');
+	this->put('0');
+	this->put('x');
 
 	uint16_t value = reinterpret_cast<uint16_t>(p);
 
@@ -231,8 +228,8 @@ xpcc::IOStream::operator << (const void* p)
 
 #elif XPCC__SIZEOF_POINTER == 4
 
-	this->device->write('0');
-	this->device->write('x');
+	this->put('0');
+	this->put('x');
 
 	uint32_t value = reinterpret_cast<uint32_t>(p);
 
@@ -243,8 +240,8 @@ xpcc::IOStream::operator << (const void* p)
 
 #elif XPCC__SIZEOF_POINTER == 8
 
-	this->device->write('0');
-	this->device->write('x');
+	this->put('0');
+	this->put('x');
 
 	uint64_t value = reinterpret_cast<uint64_t>(p);
 
@@ -20,6 +20,22 @@
 #include "iodevice.hpp"
 #include "iodevice_wrapper.hpp"
 
+/**
+ * Size of the formatting buffer of every IOStream in bytes (max. 255).
+ *
+ * Formatted values are collected in this buffer and handed to the
+ * IODevice as one block. Can be overwritten in the project configuration.
+ *
+ * @ingroup io
+ */
+#ifndef XPCC_IOSTREAM_BUFFER_SIZE
+#	if defined(XPCC__CPU_AVR)
+#		define XPCC_IOSTREAM_BUFFER_SIZE	8
+#	else
+#		define XPCC_IOSTREAM_BUFFER_SIZE	32
+#	endif
+#endif
+
 namespace xpcc
 {
 
@@ -28,6 +44,13 @@ namespace xpcc
  * output or it reads values from a input and converts them to
  * a given type;
  *
+ * Numbers, hex and binary dumps and printf() output are formatted into
+ * a small internal buffer first, which is written to the IODevice with
+ * `IODevice::write(const uint8_t*, std::size_t)` at the end of every
+ * operation. This replaces one virtual call per character with one per
+ * value. Since the buffer is always empty after an operation returns,
+ * the data reaches the device as soon as before.
+ *
  * @ingroup io
  * @author	Martin Rosekeit <martin.rosekeit@rwth-aachen.de>
  */
@@ -51,6 +74,33 @@ public:
 		return *this;
 	}
 
+	/**
+	 * Write several blocks of binary data without copying them.
+	 *
+	 * The segments are passed to IODevice::writeSegments() as they are:
+	 *
+	 * @code
+	 * const xpcc::IODevice::Segment segments[] = {
+	 *     { &header, sizeof(header) },
+	 *     { payload, payloadLength },
+	 *     { &crc, sizeof(crc) } };
+	 * stream.writeSegments(segments);
+	 * @endcode
+	 */
+	inline IOStream&
+	writeSegments(const IODevice::Segment* segments, std::size_t count)
+	{
+		this->device->writeSegments(segments, count);
+		return *this;
+	}
+
+	template< std::size_t N >
+	inline IOStream&
+	writeSegments(const IODevice::Segment (&segments)[N])
+	{
+		return this->writeSegments(segments, N);
+	}
+
 	static constexpr char eof = -1;
 
 	/// Reads one character and returns it if available. Otherwise, returns IOStream::eof.
@@ -97,6 +147,7 @@ public:
 	inline IOStream&
 	flush()
 	{
+		this->flushBuffer();
 		this->device->flush();
 		this->mode = Mode::Ascii;
 		return *this;
@@ -152,18 +203,19 @@ public:
 				break;
 			case Mode::Binary:
 				// upper nibble
-				this->device->write('0');
-				this->device->write('0');
-				this->device->write('0');
-				this->device->write('0');
+				this->put('0');
+				this->put('0');
+				this->put('0');
+				this->put('0');
 
 				// lower nibble
-				this->device->write('0');
-				this->device->write('0');
+				this->put('0');
+				this->put('0');
 				// fallthrough
 			case Mode::Hexadecimal:
-				this->device->write('0');
-				this->device->write(v ? '1' : '0');
+				this->put('0');
+				this->put(v ? '1' : '0');
+				this->flushBuffer();
 				break;
 		}
 		return *this;
@@ -414,7 +466,7 @@ public:
 	 * - `d`	signed  decimal
 	 * - `u`	unsigned decimal
 	 * - `x`	hex
-	 * - `f`	float
+	 * - `f`	float, rounded like printf() of the C library except on the AVR
 	 * - `%`	%
 	 *
 	 * Combined with the length modifiers you get:
@@ -510,6 +562,31 @@ protected:
 	void
 	writeUnsignedInteger(unsigned long unsignedValue, uint_fast8_t base, size_t width, char fill, bool isNegative);
 
+	/// Append a character to the formatting buffer
+	xpcc_always_inline void
+	put(char c)
+	{
+		if (bufferLength >= XPCC_IOSTREAM_BUFFER_SIZE) {
+			this->flushBuffer();
+		}
+		buffer[bufferLength++] = c;
+	}
+
+	/// Append a C-string to the formatting buffer
+	void
+	put(const char* s);
+
+	/// Write the content of the formatting buffer to the device
+	inline void
+	flushBuffer()
+	{
+		if (bufferLength > 0)
+		{
+			this->device->write(reinterpret_cast<const uint8_t*>(buffer), bufferLength);
+			bufferLength = 0;
+		}
+	}
+
 private:
 	enum class
 	Mode
@@ -527,6 +604,9 @@ private:
 private:
 	IODevice* const	device;
 	Mode mode;
+
+	uint8_t bufferLength;
+	char buffer[XPCC_IOSTREAM_BUFFER_SIZE];
 };
 
 /// Flushes the output stream.
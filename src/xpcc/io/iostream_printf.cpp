@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include <xpcc/math/utils/misc.hpp>        // xpcc::pow
 
+#include "format.hpp"
 #include "iostream.hpp"
 
 xpcc::IOStream&
@@ -42,13 +43,14 @@ xpcc::IOStream::vprintf(const char *fmt, va_list ap)
 
 		if (c != '%')
 		{
-			this->device->write(c);
+			this->put(c);
 			continue;
 		}
 		c = *fmt++;
 
 		size_t width = 0;
 		size_t width_frac = 0;
+		bool hasPrecision = false;
 		char fill = ' ';
 		if (c == '0')
 		{
@@ -62,6 +64,7 @@ xpcc::IOStream::vprintf(const char *fmt, va_list ap)
 		}
 
 		if (c == '.') {
+			hasPrecision = true;
 			c = *fmt++;
 
 			if (c >= '0' && c <= '9') {
@@ -90,14 +93,14 @@ xpcc::IOStream::vprintf(const char *fmt, va_list ap)
 				/* no break */
 
 			default:
-				this->device->write(c);
+				this->put(c);
 				continue;
 
 			case 's':
 				ptr = (char *) va_arg(ap, char *);
 				while ((c = *ptr++))
 				{
-					this->device->write(c);
+					this->put(c);
 				}
 				continue;
 
@@ -114,8 +117,8 @@ xpcc::IOStream::vprintf(const char *fmt, va_list ap)
 				break;
 
 			case 'p':
-				this->device->write('0');
-				this->device->write('x');
+				this->put('0');
+				this->put('x');
 				fill = '0';
 				width = (XPCC__SIZEOF_POINTER * 2);
 				isLong = (XPCC__SIZEOF_POINTER == 4);
@@ -134,6 +137,7 @@ xpcc::IOStream::vprintf(const char *fmt, va_list ap)
 		// Number output
 		if (isFloat)
 		{
+#if defined(XPCC__CPU_AVR)
 			// va_arg(ap, float) not allowed
 			float float_value = va_arg(ap, double);
 
@@ -155,7 +159,7 @@ xpcc::IOStream::vprintf(const char *fmt, va_list ap)
 			writeUnsignedInteger((unsigned int)float_value, base, width_integer, fill, isNegative);
 
 			// 2) Decimal dot
-			this->device->write('.');
+			this->put('.');
 
 			// 3) Fractional part
 			float_value = float_value - ((int) float_value);
@@ -168,6 +172,26 @@ xpcc::IOStream::vprintf(const char *fmt, va_list ap)
 
 			// Print fractional part
 			writeUnsignedInteger((unsigned int)float_value, base, width_frac, '0', false);
+#else
+			char str[format::BufferSize];
+
+			// Same as printf(): six digits after the decimal point if no
+			// precision is given
+			const char *end = format::writeFixed(str, va_arg(ap, double),
+					hasPrecision ? width_frac : 6);
+			size_t length = end - str;
+
+			ptr = str;
+			if (fill == '0' and *ptr == '-')
+			{
+				// zeros are inserted between the sign and the digits
+				this->put(*ptr++);
+			}
+			for (; length < width; ++length) {
+				this->put(fill);
+			}
+			this->put(ptr);
+#endif
 		}
 		else
 		{
@@ -201,6 +225,7 @@ xpcc::IOStream::vprintf(const char *fmt, va_list ap)
 		}
 	}
 
+	this->flushBuffer();
 	return *this;
 }
 
@@ -246,6 +271,6 @@ xpcc::IOStream::writeUnsignedInteger(
 	// output result
 	char ch;
 	while ((ch = *ptr++)) {
-		this->device->write(ch);
+		this->put(ch);
 	}
 }
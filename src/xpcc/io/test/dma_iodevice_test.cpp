@@ -0,0 +1,210 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/io/dma_iodevice.hpp>
+#include <xpcc/io/iostream.hpp>
+
+#include <string.h>
+
+#include "dma_iodevice_test.hpp"
+
+namespace
+{
+	// records the transfers instead of starting a DMA
+	struct FakeTransfer
+	{
+		static void
+		startTransmit(const uint8_t *data, std::size_t length)
+		{
+			txData = data;
+			txLength = length;
+			txCount++;
+		}
+
+		static void
+		startReceive(uint8_t *buffer, std::size_t size)
+		{
+			rxBuffer = buffer;
+			rxSize = size;
+			rxRemaining = size;
+		}
+
+		static std::size_t
+		getReceiveRemaining()
+		{
+			return rxRemaining;
+		}
+
+		// simulates the circular receive DMA
+		static void
+		receive(const char *data)
+		{
+			while (*data)
+			{
+				rxBuffer[rxSize - rxRemaining] = *data++;
+				if (--rxRemaining == 0) {
+					rxRemaining = rxSize;
+				}
+			}
+		}
+
+		static const uint8_t *txData;
+		static std::size_t txLength;
+		static std::size_t txCount;
+
+		static uint8_t *rxBuffer;
+		static std::size_t rxSize;
+		static std::size_t rxRemaining;
+	};
+
+	const uint8_t *FakeTransfer::txData;
+	std::size_t FakeTransfer::txLength;
+	std::size_t FakeTransfer::txCount;
+	uint8_t *FakeTransfer::rxBuffer;
+	std::size_t FakeTransfer::rxSize;
+	std::size_t FakeTransfer::rxRemaining;
+
+	typedef xpcc::DmaIODevice<FakeTransfer, 16, 8> Device;
+}
+
+// ----------------------------------------------------------------------------
+void
+DmaIodeviceTest::setUp()
+{
+	FakeTransfer::txData = 0;
+	FakeTransfer::txLength = 0;
+	FakeTransfer::txCount = 0;
+}
+
+void
+DmaIodeviceTest::testTransmit()
+{
+	Device device;
+	TEST_ASSERT_TRUE(device.isTransmitFinished());
+
+	device.write(reinterpret_cast<const uint8_t *>("hello"), 5);
+	TEST_ASSERT_EQUALS(FakeTransfer::txCount, 1U);
+	TEST_ASSERT_EQUALS(FakeTransfer::txLength, 5U);
+	TEST_ASSERT_EQUALS_ARRAY("hello", FakeTransfer::txData, 5);
+
+	// appended while the transfer is active
+	device.write(' ');
+	device.write(reinterpret_cast<const uint8_t *>("world"), 5);
+	TEST_ASSERT_EQUALS(FakeTransfer::txCount, 1U);
+	TEST_ASSERT_EQUALS(device.getTransmitLength(), 11U);
+	TEST_ASSERT_FALSE(device.isTransmitFinished());
+
+	// the rest is sent as one chunk
+	device.handleTransmitComplete();
+	TEST_ASSERT_EQUALS(FakeTransfer::txCount, 2U);
+	TEST_ASSERT_EQUALS(FakeTransfer::txLength, 6U);
+	TEST_ASSERT_EQUALS_ARRAY(" world", FakeTransfer::txData, 6);
+
+	device.handleTransmitComplete();
+	TEST_ASSERT_EQUALS(FakeTransfer::txCount, 2U);
+	TEST_ASSERT_TRUE(device.isTransmitFinished());
+	TEST_ASSERT_EQUALS(device.getTransmitLength(), 0U);
+}
+
+void
+DmaIodeviceTest::testTransmitWrapAround()
+{
+	Device device;
+
+	device.write(reinterpret_cast<const uint8_t *>("0123456789"), 10);
+	device.handleTransmitComplete();
+
+	// wraps around at the end of the buffer, sent in two chunks
+	device.write(reinterpret_cast<const uint8_t *>("abcdefghij"), 10);
+	TEST_ASSERT_EQUALS(FakeTransfer::txLength, 6U);
+	TEST_ASSERT_EQUALS_ARRAY("abcdef", FakeTransfer::txData, 6);
+
+	device.handleTransmitComplete();
+	TEST_ASSERT_EQUALS(FakeTransfer::txLength, 4U);
+	TEST_ASSERT_EQUALS_ARRAY("ghij", FakeTransfer::txData, 4);
+
+	device.handleTransmitComplete();
+	TEST_ASSERT_TRUE(device.isTransmitFinished());
+	TEST_ASSERT_EQUALS(FakeTransfer::txCount, 3U);
+}
+
+void
+DmaIodeviceTest::testDiscard()
+{
+	Device device;
+
+	// 15 bytes fit, the data of the active transfer is not overwritten
+	device.write(reinterpret_cast<const uint8_t *>("0123456789abcdefghij"), 20);
+	TEST_ASSERT_EQUALS(device.getDiscardedBytes(), 5U);
+	TEST_ASSERT_EQUALS(device.getTransmitLength(), 15U);
+
+	device.write('x');
+	TEST_ASSERT_EQUALS(device.getDiscardedBytes(), 6U);
+	TEST_ASSERT_EQUALS_ARRAY("0123456789abcde", FakeTransfer::txData, 15);
+
+	device.handleTransmitComplete();
+	device.write('x');
+	TEST_ASSERT_EQUALS(device.getDiscardedBytes(), 6U);
+	TEST_ASSERT_EQUALS(FakeTransfer::txLength, 1U);
+	TEST_ASSERT_EQUALS(FakeTransfer::txData[0], 'x');
+}
+
+void
+DmaIodeviceTest::testReceive()
+{
+	Device device;
+	device.initialize();
+
+	char c;
+	TEST_ASSERT_FALSE(device.read(c));
+
+	FakeTransfer::receive("abc");
+	TEST_ASSERT_TRUE(device.read(c));
+	TEST_ASSERT_EQUALS(c, 'a');
+
+	uint8_t data[8];
+	TEST_ASSERT_EQUALS(device.read(data, sizeof(data)), 2U);
+	TEST_ASSERT_EQUALS_ARRAY("bc", data, 2);
+
+	// wraps around the end of the receive buffer
+	FakeTransfer::receive("defghij");
+	TEST_ASSERT_EQUALS(device.read(data, 3), 3U);
+	TEST_ASSERT_EQUALS_ARRAY("def", data, 3);
+	TEST_ASSERT_EQUALS(device.read(data, sizeof(data)), 4U);
+	TEST_ASSERT_EQUALS_ARRAY("ghij", data, 4);
+	TEST_ASSERT_FALSE(device.read(c));
+}
+
+void
+DmaIodeviceTest::testStream()
+{
+	Device device;
+	xpcc::IOStream stream(device);
+
+	stream << "x=" << 42;
+	TEST_ASSERT_EQUALS(FakeTransfer::txLength, 2U);
+	TEST_ASSERT_EQUALS(device.getTransmitLength(), 4U);
+
+	device.handleTransmitComplete();
+	TEST_ASSERT_EQUALS_ARRAY("42", FakeTransfer::txData, 2);
+}
+
+void
+DmaIodeviceTest::testSegments()
+{
+	Device device;
+
+	// a single transfer for all segments
+	const xpcc::IODevice::Segment segments[] = {
+			{ "ab", 2 }, { "cde", 3 }, { "f", 1 } };
+	device.writeSegments(segments, 3);
+	TEST_ASSERT_EQUALS(FakeTransfer::txCount, 1U);
+	TEST_ASSERT_EQUALS(FakeTransfer::txLength, 6U);
+	TEST_ASSERT_EQUALS_ARRAY("abcdef", FakeTransfer::txData, 6);
+}
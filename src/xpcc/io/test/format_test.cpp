@@ -0,0 +1,199 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <xpcc/io/format.hpp>
+
+#include "format_test.hpp"
+
+namespace
+{
+	char buffer[xpcc::format::BufferSize];
+
+	bool
+	compare(const char *expected, const char *end)
+	{
+		return (strcmp(expected, buffer) == 0) and
+				(end == buffer + strlen(expected));
+	}
+}
+
+// ----------------------------------------------------------------------------
+void
+FormatTest::testDecimal32()
+{
+	TEST_ASSERT_TRUE(compare("0", xpcc::format::writeDecimal(buffer, uint32_t(0))));
+	TEST_ASSERT_TRUE(compare("7", xpcc::format::writeDecimal(buffer, uint32_t(7))));
+	TEST_ASSERT_TRUE(compare("10", xpcc::format::writeDecimal(buffer, uint32_t(10))));
+	TEST_ASSERT_TRUE(compare("999", xpcc::format::writeDecimal(buffer, uint32_t(999))));
+	TEST_ASSERT_TRUE(compare("1000", xpcc::format::writeDecimal(buffer, uint32_t(1000))));
+	TEST_ASSERT_TRUE(compare("4294967295", xpcc::format::writeDecimal(buffer, uint32_t(4294967295UL))));
+
+	TEST_ASSERT_TRUE(compare("0", xpcc::format::writeDecimal(buffer, int32_t(0))));
+	TEST_ASSERT_TRUE(compare("-1", xpcc::format::writeDecimal(buffer, int32_t(-1))));
+	TEST_ASSERT_TRUE(compare("-12345", xpcc::format::writeDecimal(buffer, int32_t(-12345))));
+	TEST_ASSERT_TRUE(compare("2147483647", xpcc::format::writeDecimal(buffer, int32_t(2147483647L))));
+	TEST_ASSERT_TRUE(compare("-2147483648", xpcc::format::writeDecimal(buffer, int32_t(-2147483647L - 1))));
+}
+
+void
+FormatTest::testDecimal64()
+{
+	TEST_ASSERT_TRUE(compare("0", xpcc::format::writeDecimal(buffer, uint64_t(0))));
+	TEST_ASSERT_TRUE(compare("99999999", xpcc::format::writeDecimal(buffer, uint64_t(99999999ULL))));
+	TEST_ASSERT_TRUE(compare("100000000", xpcc::format::writeDecimal(buffer, uint64_t(100000000ULL))));
+	TEST_ASSERT_TRUE(compare("10000000000000001", xpcc::format::writeDecimal(buffer, uint64_t(10000000000000001ULL))));
+	TEST_ASSERT_TRUE(compare("18446744073709551615", xpcc::format::writeDecimal(buffer, uint64_t(18446744073709551615ULL))));
+
+	TEST_ASSERT_TRUE(compare("-4000000000", xpcc::format::writeDecimal(buffer, int64_t(-4000000000LL))));
+	TEST_ASSERT_TRUE(compare("9223372036854775807", xpcc::format::writeDecimal(buffer, int64_t(9223372036854775807LL))));
+	TEST_ASSERT_TRUE(compare("-9223372036854775808", xpcc::format::writeDecimal(buffer, int64_t(-9223372036854775807LL - 1))));
+
+	// conversions can be chained
+	char *ptr = xpcc::format::writeDecimal(buffer, int32_t(-42));
+	*ptr++ = ' ';
+	ptr = xpcc::format::writeDecimal(ptr, uint64_t(4000000000ULL));
+	TEST_ASSERT_TRUE(compare("-42 4000000000", ptr));
+}
+
+// ----------------------------------------------------------------------------
+void
+FormatTest::testShortest()
+{
+#if !defined(XPCC__CPU_AVR)
+	TEST_ASSERT_TRUE(compare("0.1", xpcc::format::writeShortest(buffer, 0.1f)));
+	TEST_ASSERT_TRUE(compare("0.1", xpcc::format::writeShortest(buffer, 0.1)));
+	TEST_ASSERT_TRUE(compare("0.30000000000000004", xpcc::format::writeShortest(buffer, 0.1 + 0.2)));
+	TEST_ASSERT_TRUE(compare("100", xpcc::format::writeShortest(buffer, 100.f)));
+	TEST_ASSERT_TRUE(compare("-1234.5", xpcc::format::writeShortest(buffer, -1234.5)));
+	TEST_ASSERT_TRUE(compare("0.001", xpcc::format::writeShortest(buffer, 0.001f)));
+	TEST_ASSERT_TRUE(compare("1e-07", xpcc::format::writeShortest(buffer, 1e-7f)));
+	TEST_ASSERT_TRUE(compare("1.5e+30", xpcc::format::writeShortest(buffer, 1.5e30)));
+	TEST_ASSERT_TRUE(compare("3.4028235e+38", xpcc::format::writeShortest(buffer, 3.40282347e+38f)));
+	TEST_ASSERT_TRUE(compare("1e-45", xpcc::format::writeShortest(buffer, 1.4e-45f)));
+	TEST_ASSERT_TRUE(compare("1.7976931348623157e+308", xpcc::format::writeShortest(buffer, 1.7976931348623157e+308)));
+	TEST_ASSERT_TRUE(compare("5e-324", xpcc::format::writeShortest(buffer, 4.9406564584124654e-324)));
+#endif
+}
+
+void
+FormatTest::testScientific()
+{
+#if !defined(XPCC__CPU_AVR)
+	TEST_ASSERT_TRUE(compare("4.57000e+02", xpcc::format::writeScientific(buffer, 457.f, 5)));
+	TEST_ASSERT_TRUE(compare("-7.23400e-04", xpcc::format::writeScientific(buffer, -0.0007234f, 5)));
+	TEST_ASSERT_TRUE(compare("1e+01", xpcc::format::writeScientific(buffer, 9.5, 0)));
+	TEST_ASSERT_TRUE(compare("1.00e+100", xpcc::format::writeScientific(buffer, 9.999e99, 2)));
+	TEST_ASSERT_TRUE(compare("2.5e+00", xpcc::format::writeScientific(buffer, 2.5f, 1)));
+	TEST_ASSERT_TRUE(compare("0.000e+00", xpcc::format::writeScientific(buffer, 0.0, 3)));
+	TEST_ASSERT_TRUE(compare("1.1754943508222875e-38",
+			xpcc::format::writeScientific(buffer, 1.17549435e-38f, 16)));
+
+	// all digits of large integers, not only the shortest representation
+	TEST_ASSERT_TRUE(compare("5.2927152571547648e+16",
+			xpcc::format::writeScientific(buffer, 52927152571547648.0, 16)));
+
+	// rounded from the exact value, 1.0005 is actually 1.000499999...
+	TEST_ASSERT_TRUE(compare("1.000e+00", xpcc::format::writeScientific(buffer, 1.0005, 3)));
+	TEST_ASSERT_TRUE(compare("1.00000000000000006e-01",
+			xpcc::format::writeScientific(buffer, 0.1, 17)));
+	TEST_ASSERT_TRUE(compare("4.94065645841246544e-324",
+			xpcc::format::writeScientific(buffer, 4.9406564584124654e-324, 17)));
+#endif
+}
+
+void
+FormatTest::testFixed()
+{
+#if !defined(XPCC__CPU_AVR)
+	TEST_ASSERT_TRUE(compare("-2.38", xpcc::format::writeFixed(buffer, -2.375, 2)));
+	TEST_ASSERT_TRUE(compare("2", xpcc::format::writeFixed(buffer, 2.5, 0)));
+	TEST_ASSERT_TRUE(compare("4", xpcc::format::writeFixed(buffer, 3.5, 0)));
+	TEST_ASSERT_TRUE(compare("0.000", xpcc::format::writeFixed(buffer, 0.0004f, 3)));
+	TEST_ASSERT_TRUE(compare("0.001", xpcc::format::writeFixed(buffer, 0.0005f, 3)));
+	TEST_ASSERT_TRUE(compare("-0.00", xpcc::format::writeFixed(buffer, -0.001, 2)));
+	TEST_ASSERT_TRUE(compare("123.456789", xpcc::format::writeFixed(buffer, 123.456789, 6)));
+	TEST_ASSERT_TRUE(compare("1000.0", xpcc::format::writeFixed(buffer, 999.96f, 1)));
+	TEST_ASSERT_TRUE(compare("16777216", xpcc::format::writeFixed(buffer, 16777216.f, 0)));
+	TEST_ASSERT_TRUE(compare("100000000000000000000.00",
+			xpcc::format::writeFixed(buffer, 1e20, 2)));
+
+	// integers from 2^53 on are written exactly like by printf()
+	TEST_ASSERT_TRUE(compare("9007199254740991.0",
+			xpcc::format::writeFixed(buffer, 9007199254740991.0, 1)));
+	TEST_ASSERT_TRUE(compare("9007199254740992.0",
+			xpcc::format::writeFixed(buffer, 9007199254740992.0, 1)));
+	TEST_ASSERT_TRUE(compare("10000000000000000.00",
+			xpcc::format::writeFixed(buffer, 1e16, 2)));
+	TEST_ASSERT_TRUE(compare("52927152571547648.000000000",
+			xpcc::format::writeFixed(buffer, 52927152571547648.0, 9)));
+	TEST_ASSERT_TRUE(compare("-52927152571547648",
+			xpcc::format::writeFixed(buffer, -52927152571547648.f, 0)));
+	TEST_ASSERT_TRUE(compare("18446742974197923840",
+			xpcc::format::writeFixed(buffer, 18446742974197923840.f, 0)));
+
+	// rounded from the exact value, 2.675 is actually 2.67499999...
+	TEST_ASSERT_TRUE(compare("2.67", xpcc::format::writeFixed(buffer, 2.675, 2)));
+	TEST_ASSERT_TRUE(compare("1.00", xpcc::format::writeFixed(buffer, 1.005, 2)));
+	TEST_ASSERT_TRUE(compare("0.12", xpcc::format::writeFixed(buffer, 0.125, 2)));
+	TEST_ASSERT_TRUE(compare("0.10000000000000001", xpcc::format::writeFixed(buffer, 0.1, 17)));
+	TEST_ASSERT_TRUE(compare("1234567890.123457",
+			xpcc::format::writeFixed(buffer, 1234567890.123456789, 6)));
+	TEST_ASSERT_TRUE(compare("0.00", xpcc::format::writeFixed(buffer, 1e-300, 2)));
+
+	// falls back to the exponential notation
+	TEST_ASSERT_TRUE(compare("1.00e+21", xpcc::format::writeFixed(buffer, 1e21, 2)));
+#endif
+}
+
+void
+FormatTest::testSpecialValues()
+{
+#if !defined(XPCC__CPU_AVR)
+	const double inf = __builtin_inf();
+	const double nan = __builtin_nan("");
+
+	TEST_ASSERT_TRUE(compare("inf", xpcc::format::writeShortest(buffer, inf)));
+	TEST_ASSERT_TRUE(compare("-inf", xpcc::format::writeScientific(buffer, -inf, 3)));
+	TEST_ASSERT_TRUE(compare("inf", xpcc::format::writeFixed(buffer, float(inf), 2)));
+	TEST_ASSERT_TRUE(compare("nan", xpcc::format::writeShortest(buffer, nan)));
+	TEST_ASSERT_TRUE(compare("nan", xpcc::format::writeFixed(buffer, nan, 1)));
+
+	TEST_ASSERT_TRUE(compare("0", xpcc::format::writeShortest(buffer, 0.f)));
+	TEST_ASSERT_TRUE(compare("-0", xpcc::format::writeShortest(buffer, -0.0)));
+	TEST_ASSERT_TRUE(compare("-0.0", xpcc::format::writeFixed(buffer, -0.0, 1)));
+#endif
+}
+
+void
+FormatTest::testRoundTrip()
+{
+#if !defined(XPCC__CPU_AVR)
+	// pseudo random bit patterns (xorshift) covering the whole range
+	uint32_t state = 2463534242UL;
+	for (uint_fast16_t ii = 0; ii < 2000; ++ii)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+
+		float value;
+		memcpy(&value, &state, sizeof(value));
+		if (value != value or (value - value) != 0) {
+			// skip nan and infinity
+			continue;
+		}
+
+		xpcc::format::writeShortest(buffer, value);
+		TEST_ASSERT_TRUE(strtof(buffer, 0) == value);
+	}
+#endif
+}
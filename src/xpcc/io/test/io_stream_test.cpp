@@ -8,57 +8,10 @@
 // ----------------------------------------------------------------------------
 
 #include "io_stream_test.hpp"
+#include "memory_writer.hpp"
 
 #include <xpcc/architecture/utils.hpp> // XPCC_ARRAY_SIZE
 #include <stdio.h>	// snprintf
-#include <string.h>	// memset
-
-// ----------------------------------------------------------------------------
-// simple IODevice which stores all data in a memory buffer
-// used for testing the output of an IOStream
-
-class MemoryWriter : public xpcc::IODevice
-{
-public:
-	MemoryWriter() :
-		bytesWritten(0) {}
-
-	/// Write a single char to the buffer.
-	virtual void
-	write(char c)
-	{
-		this->buffer[this->bytesWritten] = c;
-		this->bytesWritten++;
-	}
-
-	using xpcc::IODevice::write;
-
-	virtual void
-	flush()
-	{
-		memset(this->buffer, 0, this->buffer_length);
-		this->bytesWritten = 0;
-	}
-
-	/// Reading is not implemented
-	virtual bool
-	read(char& /*c*/)
-	{
-		return false;
-	}
-
-	/// Clear the buffer and reset counter.
-	void
-	clear()
-	{
-		memset(this->buffer, 0, this->buffer_length);
-		this->bytesWritten = 0;
-	}
-
-	static constexpr std::size_t buffer_length = 100;
-	char buffer[buffer_length];
-	size_t bytesWritten;
-};
 
 // ----------------------------------------------------------------------------
 static MemoryWriter device;
@@ -511,7 +464,7 @@ IoStreamTest::testPrintf2()
 
 				TEST_ASSERT_EQUALS_ARRAY(glibc, device.buffer, len);
 				TEST_ASSERT_EQUALS(device.bytesWritten, len);
-				(*stream).flush();
+				device.clear();
 			}
 		}
 	}
@@ -558,3 +511,51 @@ IoStreamTest::testPointer()
 	TEST_ASSERT_EQUALS_ARRAY(string, device.buffer, bytesWritten);
 	TEST_ASSERT_EQUALS(device.bytesWritten, bytesWritten);
 }
+
+void
+IoStreamTest::testBlockWrite()
+{
+	// every value is handed to the device as one block
+	(*stream) << static_cast<uint32_t>(1234567);
+	TEST_ASSERT_EQUALS(device.blockWrites, 1U);
+
+	(*stream).printf(" %d items, %lx", -12, 0xbeefl);
+	TEST_ASSERT_EQUALS(device.blockWrites, 2U);
+
+	(*stream) << xpcc::hex << "ab" << xpcc::ascii;
+	TEST_ASSERT_EQUALS(device.blockWrites, 3U);
+
+	char string[] = "1234567 -12 items, BEEF6162";
+	TEST_ASSERT_EQUALS_ARRAY(string, device.buffer, 27);
+	TEST_ASSERT_EQUALS(device.bytesWritten, 27U);
+
+	// longer output is split into blocks of the buffer size
+	device.clear();
+	(*stream).printf("%s", "0123456789012345678901234567890123456789012345678901234567890123");
+	TEST_ASSERT_EQUALS(device.bytesWritten, 64U);
+	TEST_ASSERT_EQUALS(device.blockWrites, (64U + XPCC_IOSTREAM_BUFFER_SIZE - 1) / XPCC_IOSTREAM_BUFFER_SIZE);
+
+	uint8_t data[4];
+	TEST_ASSERT_EQUALS(device.read(data, sizeof(data)), 0U);
+}
+
+void
+IoStreamTest::testSegments()
+{
+	const uint8_t header[] = { 0xA5, 3 };
+	const char payload[] = "abc";
+	const xpcc::IODevice::Segment segments[] = {
+			{ header, sizeof(header) },
+			{ payload, 3 },
+			{ payload, 0 },
+			{ "\n", 1 } };
+
+	(*stream).writeSegments(segments);
+
+	const uint8_t expected[] = { 0xA5, 3, 'a', 'b', 'c', '\n' };
+	TEST_ASSERT_EQUALS(device.bytesWritten, sizeof(expected));
+	TEST_ASSERT_EQUALS_ARRAY(expected, device.buffer, sizeof(expected));
+
+	// one block per segment with the default implementation
+	TEST_ASSERT_EQUALS(device.blockWrites, 4U);
+}
@@ -133,6 +133,12 @@ public:
 	void
 	testPointer();
 
+	void
+	testBlockWrite();
+
+	void
+	testSegments();
+
 private:
 	xpcc::IOStream *stream;
 };
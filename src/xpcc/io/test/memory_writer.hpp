@@ -0,0 +1,96 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_IO_TEST_MEMORY_WRITER_HPP
+#define XPCC_IO_TEST_MEMORY_WRITER_HPP
+
+#include <xpcc/io/iodevice.hpp>
+
+#include <string.h>	// memset
+
+/**
+ * IODevice which stores all data in a memory buffer, used for testing the
+ * output of an IOStream.
+ *
+ * The buffer is always null-terminated, data beyond its size is dropped.
+ * Single characters and blocks are counted separately, to check how the
+ * data was passed to the device.
+ */
+class MemoryWriter : public xpcc::IODevice
+{
+public:
+	using xpcc::IODevice::write;
+	using xpcc::IODevice::read;
+
+	MemoryWriter()
+	{
+		clear();
+	}
+
+	virtual void
+	write(char c)
+	{
+		charWrites++;
+		append(c);
+	}
+
+	virtual void
+	write(const uint8_t* data, std::size_t length)
+	{
+		blockWrites++;
+		while (length--) {
+			append(static_cast<char>(*data++));
+		}
+	}
+
+	virtual void
+	flush()
+	{
+	}
+
+	/// Reading is not implemented
+	virtual bool
+	read(char& /*c*/)
+	{
+		return false;
+	}
+
+	/// Clear the buffer and reset the counters
+	void
+	clear()
+	{
+		memset(buffer, 0, sizeof(buffer));
+		bytesWritten = 0;
+		charWrites = 0;
+		blockWrites = 0;
+	}
+
+	const char *
+	getString() const
+	{
+		return reinterpret_cast<const char *>(buffer);
+	}
+
+	static constexpr std::size_t buffer_length = 300;
+	uint8_t buffer[buffer_length];
+	std::size_t bytesWritten;
+	std::size_t charWrites;		///< calls of write(char)
+	std::size_t blockWrites;	///< calls of write(const uint8_t*, std::size_t)
+
+private:
+	void
+	append(char c)
+	{
+		if (bytesWritten < buffer_length - 1) {
+			buffer[bytesWritten++] = c;
+		}
+	}
+};
+
+#endif	// XPCC_IO_TEST_MEMORY_WRITER_HPP
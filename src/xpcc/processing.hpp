@@ -23,5 +23,8 @@
 
 #include "processing/task.hpp"
 #include "processing/scheduler/scheduler.hpp"
+#include "processing/scheduler/delta_scheduler.hpp"
+#include "processing/monitor/task_statistics.hpp"
+#include "processing/executor.hpp"
 
 #endif	// XPCC_PROCESSING_HPP
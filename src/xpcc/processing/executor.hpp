@@ -0,0 +1,68 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @ingroup		processing
+ * @defgroup	executor		Event-driven Executor
+ *
+ * Resumes protothreads and resumable tasks only when they can make progress.
+ *
+ * Usually all protothreads are polled in the main loop, even if they are
+ * only waiting for a timeout or an interrupt. With many tasks most of the
+ * CPU time is spent checking conditions which did not change.
+ *
+ * Tasks derived from xpcc::ExecutorTask instead tell the xpcc::Executor
+ * what they are waiting for: an xpcc::EventFlag, an xpcc::EventSemaphore,
+ * a timeout or a point in time. The executor keeps a queue of ready tasks
+ * and a list of sleeping tasks sorted by their deadline, so one update
+ * only touches the tasks which can continue. Events may be signalled from
+ * interrupts, e.g. by a UART receive handler or by the
+ * xpcc::I2cEventTransaction when an I2C transfer has finished.
+ *
+ * @code
+ * class Blinker : public xpcc::ExecutorTask, private xpcc::pt::Protothread
+ * {
+ * public:
+ *     bool
+ *     run() override
+ *     {
+ *         PT_BEGIN();
+ *         while (true)
+ *         {
+ *             Led::toggle();
+ *             timeout.restart(500);
+ *             PT_WAIT_UNTIL(wait(timeout));
+ *         }
+ *         PT_END();
+ *     }
+ *
+ * private:
+ *     xpcc::Timeout timeout;
+ * };
+ *
+ * xpcc::Executor executor;
+ * Blinker blinker;
+ *
+ * int
+ * main()
+ * {
+ *     executor.add(blinker);
+ *     while (true)
+ *     {
+ *         executor.update();
+ *         executor.sleep(1000);
+ *     }
+ * }
+ * @endcode
+ *
+ * Since the executor knows when the next task will become ready,
+ * `Executor::sleep()` lets the CPU idle until then.
+ */
+
+#include "executor/executor.hpp"
+#include "executor/event.hpp"
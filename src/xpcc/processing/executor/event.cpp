@@ -0,0 +1,102 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/architecture/driver/atomic/lock.hpp>
+
+#include "event.hpp"
+#include "executor.hpp"
+
+// ----------------------------------------------------------------------------
+xpcc::EventWaitable::EventWaitable() :
+	waiters(0)
+{
+}
+
+void
+xpcc::EventWaitable::wakeOne()
+{
+	ExecutorTask *task = waiters;
+	if (task != 0)
+	{
+		waiters = task->nextWaiting;
+		task->waitingOn = 0;
+		task->executor->wake(task);
+	}
+}
+
+void
+xpcc::EventWaitable::wakeAll()
+{
+	while (waiters != 0) {
+		wakeOne();
+	}
+}
+
+void
+xpcc::EventWaitable::addWaiter(ExecutorTask *task)
+{
+	// append, so that the tasks are woken in the order they started waiting
+	ExecutorTask **link = &waiters;
+	while (*link != 0) {
+		link = &(*link)->nextWaiting;
+	}
+	task->nextWaiting = 0;
+	task->waitingOn = this;
+	*link = task;
+}
+
+void
+xpcc::EventWaitable::removeWaiter(ExecutorTask *task)
+{
+	for (ExecutorTask **link = &waiters; *link != 0; link = &(*link)->nextWaiting)
+	{
+		if (*link == task)
+		{
+			*link = task->nextWaiting;
+			break;
+		}
+	}
+	task->waitingOn = 0;
+}
+
+// ----------------------------------------------------------------------------
+xpcc::EventFlag::EventFlag() :
+	flag(false)
+{
+}
+
+void
+xpcc::EventFlag::signal()
+{
+	atomic::Lock lock;
+
+	flag = true;
+	wakeAll();
+}
+
+void
+xpcc::EventFlag::clear()
+{
+	flag = false;
+}
+
+// ----------------------------------------------------------------------------
+xpcc::EventSemaphore::EventSemaphore(uint16_t initial) :
+	count(initial)
+{
+}
+
+void
+xpcc::EventSemaphore::signal()
+{
+	atomic::Lock lock;
+
+	count = count + 1;
+	wakeOne();
+}
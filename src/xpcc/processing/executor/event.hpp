@@ -0,0 +1,121 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_EXECUTOR_EVENT_HPP
+#define XPCC_EXECUTOR_EVENT_HPP
+
+#include <stdint.h>
+
+namespace xpcc
+{
+
+class ExecutorTask;
+
+/**
+ * Base class of objects an xpcc::ExecutorTask can wait on
+ *
+ * Keeps the list of waiting tasks.
+ *
+ * @ingroup	executor
+ */
+class EventWaitable
+{
+	friend class ExecutorTask;
+	friend class Executor;
+
+protected:
+	EventWaitable();
+
+	/// Make the first waiting task ready, call with interrupts disabled
+	void
+	wakeOne();
+
+	/// Make all waiting tasks ready, call with interrupts disabled
+	void
+	wakeAll();
+
+private:
+	EventWaitable(const EventWaitable&);
+
+	EventWaitable&
+	operator = (const EventWaitable&);
+
+	void
+	addWaiter(ExecutorTask *task);
+
+	void
+	removeWaiter(ExecutorTask *task);
+
+private:
+	ExecutorTask *waiters;
+};
+
+/**
+ * Binary event flag
+ *
+ * `signal()` sets the flag and resumes all waiting tasks. A task which
+ * successfully waits on the flag clears it again. May be signalled from
+ * an interrupt.
+ *
+ * @ingroup	executor
+ */
+class EventFlag : public EventWaitable
+{
+	friend class ExecutorTask;
+
+public:
+	EventFlag();
+
+	void
+	signal();
+
+	void
+	clear();
+
+	inline bool
+	isSet() const
+	{
+		return flag;
+	}
+
+private:
+	volatile bool flag;
+};
+
+/**
+ * Counting semaphore
+ *
+ * `signal()` increments the counter and resumes the first waiting task,
+ * waiting decrements the counter. May be signalled from an interrupt.
+ *
+ * @ingroup	executor
+ */
+class EventSemaphore : public EventWaitable
+{
+	friend class ExecutorTask;
+
+public:
+	EventSemaphore(uint16_t initial = 0);
+
+	void
+	signal();
+
+	inline uint16_t
+	getCount() const
+	{
+		return count;
+	}
+
+private:
+	volatile uint16_t count;
+};
+
+}	// namespace xpcc
+
+#endif // XPCC_EXECUTOR_EVENT_HPP
@@ -0,0 +1,347 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/architecture/driver/atomic/lock.hpp>
+#include <xpcc/architecture/driver/clock.hpp>
+#include <xpcc/architecture/driver/idle.hpp>
+
+#include "executor.hpp"
+#include "event.hpp"
+
+// ----------------------------------------------------------------------------
+xpcc::ExecutorTask::ExecutorTask() :
+	executor(0), nextReady(0), nextWaiting(0), nextSleeping(0),
+	waitingOn(0), deadline(0), ready(false), sleeping(false)
+{
+}
+
+xpcc::ExecutorTask::~ExecutorTask()
+{
+	if (executor != 0) {
+		executor->remove(*this);
+	}
+}
+
+// ----------------------------------------------------------------------------
+bool
+xpcc::ExecutorTask::wait(EventFlag& flag)
+{
+	atomic::Lock lock;
+
+	if (flag.flag)
+	{
+		flag.flag = false;
+		return true;
+	}
+	waitFor(flag);
+	return false;
+}
+
+bool
+xpcc::ExecutorTask::wait(EventSemaphore& semaphore)
+{
+	atomic::Lock lock;
+
+	if (semaphore.count > 0)
+	{
+		semaphore.count = semaphore.count - 1;
+		return true;
+	}
+	waitFor(semaphore);
+	return false;
+}
+
+bool
+xpcc::ExecutorTask::wait(const Timeout& timeout)
+{
+	const Timestamp::SignedType remaining = timeout.remaining();
+	if (remaining <= 0) {
+		return true;
+	}
+	return waitUntil(Clock::now() + Timestamp(remaining));
+}
+
+bool
+xpcc::ExecutorTask::waitUntil(const Timestamp time)
+{
+	if (Clock::now() >= time) {
+		return true;
+	}
+
+	if (executor != 0)
+	{
+		atomic::Lock lock;
+		if (sleeping) {
+			executor->removeSleeping(this);
+		}
+		deadline = time;
+		executor->insertSleeping(this);
+	}
+	return false;
+}
+
+void
+xpcc::ExecutorTask::waitFor(EventWaitable& waitable)
+{
+	// without an executor the task is polled, nothing to register
+	if (executor == 0 or waitingOn == &waitable) {
+		return;
+	}
+
+	if (waitingOn != 0) {
+		waitingOn->removeWaiter(this);
+	}
+	waitable.addWaiter(this);
+}
+
+// ----------------------------------------------------------------------------
+xpcc::Executor::Executor() :
+	readyHead(0), readyTail(0), readyCount(0), sleepList(0)
+{
+}
+
+bool
+xpcc::Executor::add(ExecutorTask& task)
+{
+	atomic::Lock lock;
+
+	if (task.executor != 0) {
+		return false;
+	}
+	task.executor = this;
+	pushReady(&task);
+
+	return true;
+}
+
+bool
+xpcc::Executor::remove(ExecutorTask& task)
+{
+	atomic::Lock lock;
+
+	if (task.executor != this) {
+		return false;
+	}
+	unsubscribe(&task);
+	if (task.ready) {
+		removeReady(&task);
+	}
+	task.executor = 0;
+
+	return true;
+}
+
+uint_fast16_t
+xpcc::Executor::update()
+{
+	{
+		const Timestamp now = Clock::now();
+
+		atomic::Lock lock;
+		while (sleepList != 0 and sleepList->deadline <= now)
+		{
+			ExecutorTask *task = sleepList;
+			sleepList = task->nextSleeping;
+			task->sleeping = false;
+
+			if (task->waitingOn != 0) {
+				task->waitingOn->removeWaiter(task);
+			}
+			pushReady(task);
+		}
+	}
+
+	// only the tasks which are ready now are resumed
+	uint_fast16_t count;
+	{
+		atomic::Lock lock;
+		count = readyCount;
+	}
+
+	uint_fast16_t resumed = 0;
+	while (resumed < count)
+	{
+		ExecutorTask *task;
+		{
+			atomic::Lock lock;
+			task = readyHead;
+			if (task == 0) {
+				// tasks were removed while updating
+				break;
+			}
+			readyHead = task->nextReady;
+			if (readyHead == 0) {
+				readyTail = 0;
+			}
+			readyCount--;
+			task->ready = false;
+		}
+
+		const bool running = task->run();
+		resumed++;
+
+		atomic::Lock lock;
+		if (task->executor != this) {
+			// removed itself while running
+			continue;
+		}
+
+		if (not running)
+		{
+			unsubscribe(task);
+			if (task->ready) {
+				removeReady(task);
+			}
+			task->executor = 0;
+		}
+		else if (not task->ready and task->waitingOn == 0 and not task->sleeping)
+		{
+			// not waiting for anything => yield
+			pushReady(task);
+		}
+	}
+
+	return resumed;
+}
+
+bool
+xpcc::Executor::isIdle() const
+{
+	return (readyHead == 0);
+}
+
+bool
+xpcc::Executor::nextDeadline(Timestamp& deadline) const
+{
+	atomic::Lock lock;
+
+	if (readyHead != 0)
+	{
+		deadline = Clock::now();
+		return true;
+	}
+	if (sleepList != 0)
+	{
+		deadline = sleepList->deadline;
+		return true;
+	}
+	return false;
+}
+
+void
+xpcc::Executor::sleep(const Timestamp maximum) const
+{
+	Timestamp::SignedType time = maximum.getTime();
+
+	Timestamp deadline;
+	if (nextDeadline(deadline))
+	{
+		const Timestamp::SignedType remaining =
+				Timestamp::SignedType((deadline - Clock::now()).getTime());
+		if (remaining < time) {
+			time = remaining;
+		}
+	}
+
+	if (time > 0) {
+		xpcc::idleFor(time);
+	}
+}
+
+// ----------------------------------------------------------------------------
+void
+xpcc::Executor::pushReady(ExecutorTask *task)
+{
+	if (task->ready) {
+		return;
+	}
+
+	task->ready = true;
+	task->nextReady = 0;
+	if (readyTail == 0) {
+		readyHead = task;
+	}
+	else {
+		readyTail->nextReady = task;
+	}
+	readyTail = task;
+	readyCount++;
+}
+
+void
+xpcc::Executor::removeReady(ExecutorTask *task)
+{
+	ExecutorTask *previous = 0;
+	for (ExecutorTask *item = readyHead; item != 0; item = item->nextReady)
+	{
+		if (item == task)
+		{
+			if (previous == 0) {
+				readyHead = task->nextReady;
+			}
+			else {
+				previous->nextReady = task->nextReady;
+			}
+			if (readyTail == task) {
+				readyTail = previous;
+			}
+			readyCount--;
+			break;
+		}
+		previous = item;
+	}
+	task->ready = false;
+}
+
+void
+xpcc::Executor::insertSleeping(ExecutorTask *task)
+{
+	// tasks with the same deadline are resumed in the order they started waiting
+	ExecutorTask **link = &sleepList;
+	while (*link != 0 and (*link)->deadline <= task->deadline) {
+		link = &(*link)->nextSleeping;
+	}
+	task->nextSleeping = *link;
+	*link = task;
+	task->sleeping = true;
+}
+
+void
+xpcc::Executor::removeSleeping(ExecutorTask *task)
+{
+	for (ExecutorTask **link = &sleepList; *link != 0; link = &(*link)->nextSleeping)
+	{
+		if (*link == task)
+		{
+			*link = task->nextSleeping;
+			break;
+		}
+	}
+	task->sleeping = false;
+}
+
+void
+xpcc::Executor::unsubscribe(ExecutorTask *task)
+{
+	if (task->waitingOn != 0) {
+		task->waitingOn->removeWaiter(task);
+	}
+	if (task->sleeping) {
+		removeSleeping(task);
+	}
+}
+
+void
+xpcc::Executor::wake(ExecutorTask *task)
+{
+	if (task->sleeping) {
+		removeSleeping(task);
+	}
+	pushReady(task);
+}
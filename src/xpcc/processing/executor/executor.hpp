@@ -0,0 +1,238 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_EXECUTOR_HPP
+#define XPCC_EXECUTOR_HPP
+
+#include <stdint.h>
+
+#include <xpcc/processing/timer/timeout.hpp>
+
+namespace xpcc
+{
+
+class Executor;
+class EventWaitable;
+class EventFlag;
+class EventSemaphore;
+
+/**
+ * Task which is resumed by an xpcc::Executor
+ *
+ * The `run()` method follows the protothread convention: it returns `true`
+ * while the task is still running and `false` once it has finished. Use
+ * the protothread or resumable macros together with the `wait()` methods
+ * to suspend the task until something happened:
+ *
+ * @code
+ * class Sensor : public xpcc::ExecutorTask, private xpcc::pt::Protothread
+ * {
+ * public:
+ *     bool
+ *     run() override
+ *     {
+ *         PT_BEGIN();
+ *         while (true)
+ *         {
+ *             timeout.restart(10);
+ *             PT_WAIT_UNTIL(wait(timeout));
+ *
+ *             startConversion();
+ *             PT_WAIT_UNTIL(wait(conversionDone));
+ *         }
+ *         PT_END();
+ *     }
+ * ...
+ * @endcode
+ *
+ * Each `wait()` returns `true` if the condition is already fulfilled.
+ * Otherwise it registers the task with the wait object and returns
+ * `false`, the executor then resumes the task only after the wait object
+ * was signalled. Waiting on several objects at once (e.g. an event and a
+ * timeout) is possible by combining the calls with `or`, but only one
+ * event object and one time can be waited on at the same time.
+ *
+ * A task which returns without waiting for anything is resumed again in
+ * the next call of Executor::update(), like a yield.
+ *
+ * @ingroup	executor
+ */
+class ExecutorTask
+{
+	friend class Executor;
+	friend class EventWaitable;
+
+public:
+	ExecutorTask();
+
+	virtual
+	~ExecutorTask();
+
+	/// @return	`true` while the task is running, `false` when it has finished
+	virtual bool
+	run() = 0;
+
+	/// @return	`true` if the task was added to an executor and has not finished yet
+	inline bool
+	isScheduled() const
+	{
+		return (executor != 0);
+	}
+
+protected:
+	/// Wait until the flag is set. The flag is cleared again.
+	/// @return	`true` if the flag was set
+	bool
+	wait(EventFlag& flag);
+
+	/// Wait until the semaphore can be acquired.
+	/// @return	`true` if the semaphore was acquired
+	bool
+	wait(EventSemaphore& semaphore);
+
+	/// Wait until the timeout has expired.
+	/// @return	`true` if the timeout has expired or is stopped
+	bool
+	wait(const Timeout& timeout);
+
+	/// Wait until the given point in time.
+	/// @return	`true` if the time has been reached
+	bool
+	waitUntil(const Timestamp time);
+
+private:
+	void
+	waitFor(EventWaitable& waitable);
+
+private:
+	Executor *executor;
+
+	ExecutorTask *nextReady;
+	ExecutorTask *nextWaiting;
+	ExecutorTask *nextSleeping;
+
+	EventWaitable *waitingOn;
+	Timestamp deadline;
+
+	bool ready;
+	bool sleeping;
+};
+
+/**
+ * Cooperative executor with a ready queue
+ *
+ * In contrast to calling `run()` of every protothread in the main loop,
+ * the executor only resumes tasks which are ready: tasks which yielded or
+ * whose events were signalled or whose time has come. The cost of one
+ * update therefore depends on the activity and not on the number of tasks.
+ *
+ * @code
+ * xpcc::Executor executor;
+ * executor.add(sensor);
+ * executor.add(display);
+ *
+ * while (true)
+ * {
+ *     executor.update();
+ *     // sleep until the next task is ready, but at most 100ms
+ *     executor.sleep(100);
+ * }
+ * @endcode
+ *
+ * Event objects may be signalled from interrupts, everything else must be
+ * called from the main context. On hosted targets the executor is not
+ * thread-safe.
+ *
+ * @ingroup	executor
+ */
+class Executor
+{
+	friend class ExecutorTask;
+	friend class EventWaitable;
+
+public:
+	Executor();
+
+	/// Add a task, it is resumed in the next update.
+	/// @return	`false` if the task already belongs to an executor
+	bool
+	add(ExecutorTask& task);
+
+	/// Remove a task without finishing it.
+	/// @return	`false` if the task does not belong to this executor
+	bool
+	remove(ExecutorTask& task);
+
+	/**
+	 * Resume all tasks which are ready.
+	 *
+	 * Every task is resumed at most once, tasks which become ready while
+	 * updating are resumed in the next call.
+	 *
+	 * @return	number of resumed tasks
+	 */
+	uint_fast16_t
+	update();
+
+	/// @return	`true` if no task is ready
+	bool
+	isIdle() const;
+
+	/**
+	 * Find the point in time when the next task becomes ready.
+	 *
+	 * Tasks waiting only for events have no deadline.
+	 *
+	 * @return	`false` if no task is ready or waiting for a time
+	 */
+	bool
+	nextDeadline(Timestamp& deadline) const;
+
+	/**
+	 * Sleep until the next deadline, but for at most `maximum`.
+	 *
+	 * Returns immediately if a task is ready. Interrupts, which signal
+	 * events, end the sleep on microcontrollers.
+	 */
+	void
+	sleep(const Timestamp maximum) const;
+
+private:
+	void
+	pushReady(ExecutorTask *task);
+
+	void
+	removeReady(ExecutorTask *task);
+
+	void
+	insertSleeping(ExecutorTask *task);
+
+	void
+	removeSleeping(ExecutorTask *task);
+
+	/// Remove the task from all lists it is waiting in
+	void
+	unsubscribe(ExecutorTask *task);
+
+	/// Called by an event object with interrupts disabled
+	void
+	wake(ExecutorTask *task);
+
+private:
+	ExecutorTask *readyHead;
+	ExecutorTask *readyTail;
+	uint_fast16_t readyCount;
+
+	/// Sorted by deadline
+	ExecutorTask *sleepList;
+};
+
+}	// namespace xpcc
+
+#endif // XPCC_EXECUTOR_HPP
@@ -0,0 +1,82 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_EXECUTOR_I2C_EVENT_TRANSACTION_HPP
+#define XPCC_EXECUTOR_I2C_EVENT_TRANSACTION_HPP
+
+#include <xpcc/architecture/interface/i2c_transaction.hpp>
+
+#include "event.hpp"
+
+namespace xpcc
+{
+
+/**
+ * I2C transaction which signals an event flag when it was detached
+ *
+ * Lets an xpcc::ExecutorTask sleep until the I2C master finished the
+ * transaction instead of polling the transaction state:
+ *
+ * @code
+ * xpcc::I2cEventTransaction<> transaction(0x48);
+ *
+ * transaction.configureWriteRead(command, 1, data, 2);
+ * PT_WAIT_UNTIL(I2cMaster::start(&transaction));
+ * PT_WAIT_UNTIL(wait(transaction.getCompletion()));
+ * @endcode
+ *
+ * @tparam	Transaction		the transaction type to extend
+ *
+ * @ingroup	executor
+ */
+template< class Transaction = I2cWriteReadTransaction >
+class I2cEventTransaction : public Transaction
+{
+public:
+	I2cEventTransaction(uint8_t address) :
+		Transaction(address)
+	{
+	}
+
+	/// Signalled when the transaction was detached, with or without error
+	inline EventFlag&
+	getCompletion()
+	{
+		return completion;
+	}
+
+protected:
+	bool
+	attaching() override
+	{
+		if (Transaction::attaching())
+		{
+			completion.clear();
+			return true;
+		}
+		return false;
+	}
+
+	void
+	detaching(I2c::DetachCause cause) override
+	{
+		Transaction::detaching(cause);
+		// the transaction was not started, a running one must not be signalled
+		if (cause != I2c::DetachCause::FailedToAttach) {
+			completion.signal();
+		}
+	}
+
+private:
+	EventFlag completion;
+};
+
+}	// namespace xpcc
+
+#endif // XPCC_EXECUTOR_I2C_EVENT_TRANSACTION_HPP
@@ -0,0 +1,403 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/processing/executor.hpp>
+#include <xpcc/processing/protothread.hpp>
+
+#include "executor_test.hpp"
+
+/**
+ * Gain full access to xpcc::Clock
+ *
+ * Only useful if the define XPCC__CLOCK_TESTMODE is set to 1.
+ */
+class TestingClock : public xpcc::Clock
+{
+public:
+	// expose protected members
+	using xpcc::Clock::time;
+};
+
+namespace
+{
+	/// Counts its calls, finishes after `limit` calls
+	class CountingTask : public xpcc::ExecutorTask
+	{
+	public:
+		CountingTask(uint16_t limit = 0xffff) :
+			calls(0), limit(limit)
+		{
+		}
+
+		bool
+		run() override
+		{
+			calls++;
+			return (calls < limit);
+		}
+
+		uint16_t calls;
+		uint16_t limit;
+	};
+
+	class FlagTask : public xpcc::ExecutorTask, private xpcc::pt::Protothread
+	{
+	public:
+		FlagTask(xpcc::EventFlag& flag) :
+			flag(flag), calls(0), events(0)
+		{
+		}
+
+		bool
+		run() override
+		{
+			calls++;
+
+			PT_BEGIN();
+			while (true)
+			{
+				PT_WAIT_UNTIL(wait(flag));
+				events++;
+			}
+			PT_END();
+		}
+
+		xpcc::EventFlag& flag;
+		uint16_t calls;
+		uint16_t events;
+	};
+
+	class SemaphoreTask : public xpcc::ExecutorTask, private xpcc::pt::Protothread
+	{
+	public:
+		SemaphoreTask(xpcc::EventSemaphore& semaphore) :
+			semaphore(semaphore), events(0)
+		{
+		}
+
+		bool
+		run() override
+		{
+			PT_BEGIN();
+			while (true)
+			{
+				PT_WAIT_UNTIL(wait(semaphore));
+				events++;
+			}
+			PT_END();
+		}
+
+		xpcc::EventSemaphore& semaphore;
+		uint16_t events;
+	};
+
+	class TimeoutTask : public xpcc::ExecutorTask, private xpcc::pt::Protothread
+	{
+	public:
+		TimeoutTask(xpcc::EventFlag *flag = 0) :
+			flag(flag), calls(0), expired(0), events(0)
+		{
+		}
+
+		bool
+		run() override
+		{
+			calls++;
+
+			PT_BEGIN();
+			while (true)
+			{
+				timeout.restart(100);
+				PT_WAIT_UNTIL((flag != 0 and wait(*flag)) or wait(timeout));
+
+				if (timeout.isExpired()) {
+					expired++;
+				} else {
+					events++;
+				}
+			}
+			PT_END();
+		}
+
+		xpcc::EventFlag *flag;
+		xpcc::Timeout timeout;
+		uint16_t calls;
+		uint16_t expired;
+		uint16_t events;
+	};
+}
+
+// ----------------------------------------------------------------------------
+void
+ExecutorTest::setUp()
+{
+	TestingClock::time = 0;
+}
+
+void
+ExecutorTest::testYield()
+{
+	xpcc::Executor executor;
+	CountingTask task1;
+	CountingTask task2;
+
+	TEST_ASSERT_TRUE(executor.isIdle());
+	TEST_ASSERT_TRUE(executor.add(task1));
+	TEST_ASSERT_FALSE(executor.add(task1));
+	TEST_ASSERT_TRUE(executor.add(task2));
+	TEST_ASSERT_TRUE(task1.isScheduled());
+	TEST_ASSERT_FALSE(executor.isIdle());
+
+	// tasks not waiting for anything are resumed in every update
+	for (uint8_t i = 0; i < 5; ++i) {
+		TEST_ASSERT_EQUALS(executor.update(), 2U);
+	}
+	TEST_ASSERT_EQUALS(task1.calls, 5U);
+	TEST_ASSERT_EQUALS(task2.calls, 5U);
+
+	xpcc::Timestamp deadline;
+	TEST_ASSERT_TRUE(executor.nextDeadline(deadline));
+	TEST_ASSERT_EQUALS(deadline, xpcc::Timestamp(0));
+}
+
+void
+ExecutorTest::testFinish()
+{
+	xpcc::Executor executor;
+	CountingTask task(3);
+
+	executor.add(task);
+
+	TEST_ASSERT_EQUALS(executor.update(), 1U);
+	TEST_ASSERT_EQUALS(executor.update(), 1U);
+	TEST_ASSERT_EQUALS(executor.update(), 1U);
+	TEST_ASSERT_FALSE(task.isScheduled());
+	TEST_ASSERT_TRUE(executor.isIdle());
+
+	TEST_ASSERT_EQUALS(executor.update(), 0U);
+	TEST_ASSERT_EQUALS(task.calls, 3U);
+
+	// a finished task can be added again
+	TEST_ASSERT_TRUE(executor.add(task));
+	TEST_ASSERT_EQUALS(executor.update(), 1U);
+	TEST_ASSERT_EQUALS(task.calls, 4U);
+}
+
+void
+ExecutorTest::testRemove()
+{
+	xpcc::Executor executor;
+	xpcc::Executor other;
+	xpcc::EventFlag flag;
+	FlagTask task(flag);
+	CountingTask counter;
+
+	executor.add(task);
+	executor.add(counter);
+	executor.update();
+
+	TEST_ASSERT_FALSE(other.remove(task));
+	TEST_ASSERT_TRUE(executor.remove(task));
+	TEST_ASSERT_FALSE(executor.remove(task));
+	TEST_ASSERT_FALSE(task.isScheduled());
+
+	// the removed task is no longer woken by its event
+	flag.signal();
+	TEST_ASSERT_EQUALS(executor.update(), 1U);
+	TEST_ASSERT_EQUALS(task.calls, 1U);
+
+	TEST_ASSERT_TRUE(executor.remove(counter));
+	TEST_ASSERT_EQUALS(executor.update(), 0U);
+	TEST_ASSERT_TRUE(executor.isIdle());
+}
+
+void
+ExecutorTest::testFlag()
+{
+	xpcc::Executor executor;
+	xpcc::EventFlag flag;
+	FlagTask task1(flag);
+	FlagTask task2(flag);
+
+	executor.add(task1);
+	executor.add(task2);
+
+	TEST_ASSERT_EQUALS(executor.update(), 2U);
+	TEST_ASSERT_TRUE(executor.isIdle());
+
+	xpcc::Timestamp deadline;
+	TEST_ASSERT_FALSE(executor.nextDeadline(deadline));
+
+	// nothing happens without the event
+	TEST_ASSERT_EQUALS(executor.update(), 0U);
+	TEST_ASSERT_EQUALS(task1.calls, 1U);
+
+	// all waiting tasks are woken, the first one consumes the flag
+	flag.signal();
+	TEST_ASSERT_TRUE(flag.isSet());
+	TEST_ASSERT_FALSE(executor.isIdle());
+	TEST_ASSERT_EQUALS(executor.update(), 2U);
+	TEST_ASSERT_EQUALS(task1.events, 1U);
+	TEST_ASSERT_EQUALS(task2.events, 0U);
+	TEST_ASSERT_FALSE(flag.isSet());
+
+	// task1 waits again, task2 is still waiting
+	TEST_ASSERT_EQUALS(executor.update(), 0U);
+
+	// signalling several times before the update wakes the tasks only once
+	flag.signal();
+	flag.signal();
+	TEST_ASSERT_EQUALS(executor.update(), 2U);
+	TEST_ASSERT_EQUALS(task1.calls + task2.calls, 6);
+	TEST_ASSERT_EQUALS(task1.events + task2.events, 2);
+
+	// a flag which is already set is consumed without waiting
+	xpcc::EventFlag other;
+	other.signal();
+	FlagTask task3(other);
+	executor.add(task3);
+	TEST_ASSERT_EQUALS(executor.update(), 1U);
+	TEST_ASSERT_EQUALS(task3.events, 1U);
+	TEST_ASSERT_FALSE(other.isSet());
+}
+
+void
+ExecutorTest::testSemaphore()
+{
+	xpcc::Executor executor;
+	xpcc::EventSemaphore semaphore(1);
+	SemaphoreTask task(semaphore);
+
+	executor.add(task);
+	executor.update();
+	TEST_ASSERT_EQUALS(task.events, 1U);
+	TEST_ASSERT_EQUALS(semaphore.getCount(), 0U);
+
+	TEST_ASSERT_EQUALS(executor.update(), 0U);
+
+	semaphore.signal();
+	semaphore.signal();
+	semaphore.signal();
+	TEST_ASSERT_EQUALS(semaphore.getCount(), 3U);
+
+	// every signal is counted
+	TEST_ASSERT_EQUALS(executor.update(), 1U);
+	TEST_ASSERT_EQUALS(task.events, 4U);
+	TEST_ASSERT_EQUALS(semaphore.getCount(), 0U);
+	TEST_ASSERT_TRUE(executor.isIdle());
+}
+
+void
+ExecutorTest::testTimeout()
+{
+	xpcc::Executor executor;
+	TimeoutTask task;
+
+	executor.add(task);
+	TEST_ASSERT_EQUALS(executor.update(), 1U);
+	TEST_ASSERT_TRUE(executor.isIdle());
+
+	xpcc::Timestamp deadline;
+	TEST_ASSERT_TRUE(executor.nextDeadline(deadline));
+	TEST_ASSERT_EQUALS(deadline, xpcc::Timestamp(100));
+
+	TestingClock::time = 99;
+	TEST_ASSERT_EQUALS(executor.update(), 0U);
+	TEST_ASSERT_EQUALS(task.calls, 1U);
+
+	TestingClock::time = 100;
+	TEST_ASSERT_EQUALS(executor.update(), 1U);
+	TEST_ASSERT_EQUALS(task.expired, 1U);
+
+	TEST_ASSERT_TRUE(executor.nextDeadline(deadline));
+	TEST_ASSERT_EQUALS(deadline, xpcc::Timestamp(200));
+
+	// a late update resumes the task once
+	TestingClock::time = 450;
+	TEST_ASSERT_EQUALS(executor.update(), 1U);
+	TEST_ASSERT_EQUALS(task.expired, 2U);
+	TEST_ASSERT_TRUE(executor.nextDeadline(deadline));
+	TEST_ASSERT_EQUALS(deadline, xpcc::Timestamp(550));
+}
+
+void
+ExecutorTest::testEventOrTimeout()
+{
+	xpcc::Executor executor;
+	xpcc::EventFlag flag;
+	TimeoutTask task(&flag);
+
+	executor.add(task);
+	executor.update();
+
+	// the event ends the wait before the timeout
+	TestingClock::time = 50;
+	flag.signal();
+	TEST_ASSERT_EQUALS(executor.update(), 1U);
+	TEST_ASSERT_EQUALS(task.events, 1U);
+	TEST_ASSERT_EQUALS(task.expired, 0U);
+
+	// the old deadline was removed
+	xpcc::Timestamp deadline;
+	TEST_ASSERT_TRUE(executor.nextDeadline(deadline));
+	TEST_ASSERT_EQUALS(deadline, xpcc::Timestamp(150));
+
+	TestingClock::time = 100;
+	TEST_ASSERT_EQUALS(executor.update(), 0U);
+
+	// the timeout ends the wait without the event
+	TestingClock::time = 150;
+	TEST_ASSERT_EQUALS(executor.update(), 1U);
+	TEST_ASSERT_EQUALS(task.events, 1U);
+	TEST_ASSERT_EQUALS(task.expired, 1U);
+
+	// the task still waits for the event
+	flag.signal();
+	TEST_ASSERT_EQUALS(executor.update(), 1U);
+	TEST_ASSERT_EQUALS(task.events, 2U);
+	TEST_ASSERT_EQUALS(task.calls, 4U);
+}
+
+void
+ExecutorTest::testOnlyReadyTasksAreResumed()
+{
+	xpcc::Executor executor;
+	xpcc::EventFlag flags[20];
+	FlagTask *tasks[20];
+
+	for (uint8_t i = 0; i < 20; ++i)
+	{
+		tasks[i] = new FlagTask(flags[i]);
+		executor.add(*tasks[i]);
+	}
+	TEST_ASSERT_EQUALS(executor.update(), 20U);
+
+	for (uint8_t i = 0; i < 10; ++i) {
+		TEST_ASSERT_EQUALS(executor.update(), 0U);
+	}
+
+	flags[3].signal();
+	flags[17].signal();
+	TEST_ASSERT_EQUALS(executor.update(), 2U);
+
+	uint16_t calls = 0;
+	for (uint8_t i = 0; i < 20; ++i) {
+		calls += tasks[i]->calls;
+	}
+	TEST_ASSERT_EQUALS(calls, 22U);
+	TEST_ASSERT_EQUALS(tasks[3]->events, 1U);
+	TEST_ASSERT_EQUALS(tasks[17]->events, 1U);
+
+	// deleting a task removes it from the executor
+	for (uint8_t i = 0; i < 20; ++i) {
+		delete tasks[i];
+	}
+	flags[5].signal();
+	TEST_ASSERT_EQUALS(executor.update(), 0U);
+}
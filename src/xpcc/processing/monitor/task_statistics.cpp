@@ -0,0 +1,136 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/architecture/driver/atomic/lock.hpp>
+
+#include "task_statistics.hpp"
+
+xpcc::TaskStatistics *xpcc::TaskStatistics::first = 0;
+xpcc::TaskStatistics::DeadlineMissHandler xpcc::TaskStatistics::deadlineMissHandler = 0;
+
+// ----------------------------------------------------------------------------
+xpcc::TaskStatistics::TaskStatistics(const char *name) :
+	name(name), next(0)
+{
+	reset();
+
+	atomic::Lock lock;
+	TaskStatistics **link = &first;
+	while (*link != 0) {
+		link = &(*link)->next;
+	}
+	*link = this;
+}
+
+xpcc::TaskStatistics::~TaskStatistics()
+{
+	atomic::Lock lock;
+
+	for (TaskStatistics **link = &first; *link != 0; link = &(*link)->next)
+	{
+		if (*link == this)
+		{
+			*link = next;
+			break;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+void
+xpcc::TaskStatistics::recordStart(Time jitter)
+{
+	atomic::Lock lock;
+
+	runs++;
+	lastJitter = jitter;
+	if (jitter > maximumJitter) {
+		maximumJitter = jitter;
+	}
+}
+
+void
+xpcc::TaskStatistics::recordRuntime(Time runtime)
+{
+	atomic::Lock lock;
+
+	measurements++;
+	totalTime += runtime;
+	if (runtime > worstCaseTime) {
+		worstCaseTime = runtime;
+	}
+}
+
+void
+xpcc::TaskStatistics::recordMiss(uint32_t missed)
+{
+	{
+		atomic::Lock lock;
+		overruns += missed;
+	}
+
+	if (deadlineMissHandler != 0) {
+		deadlineMissHandler(*this, missed);
+	}
+}
+
+void
+xpcc::TaskStatistics::reset()
+{
+	atomic::Lock lock;
+
+	runs = 0;
+	overruns = 0;
+	measurements = 0;
+	totalTime = 0;
+	worstCaseTime = 0;
+	maximumJitter = 0;
+	lastJitter = 0;
+}
+
+xpcc::TaskStatistics::Time
+xpcc::TaskStatistics::getAverageTime() const
+{
+	atomic::Lock lock;
+
+	if (measurements == 0) {
+		return 0;
+	}
+	return Time(totalTime / measurements);
+}
+
+// ----------------------------------------------------------------------------
+void
+xpcc::TaskStatistics::setDeadlineMissHandler(DeadlineMissHandler handler)
+{
+	atomic::Lock lock;
+	deadlineMissHandler = handler;
+}
+
+xpcc::TaskStatistics::Time
+xpcc::TaskStatistics::fromMilliseconds(uint32_t ms)
+{
+	const uint64_t ticks = (uint64_t(ms) * Counter::getFrequency()) / 1000;
+	return (ticks > Counter::Mask) ? Time(Counter::Mask) : Time(ticks);
+}
+
+xpcc::TaskStatistics::Time
+xpcc::TaskStatistics::fromMicroseconds(uint32_t us)
+{
+	const uint64_t ticks = (uint64_t(us) * Counter::getFrequency()) / 1000000;
+	return (ticks > Counter::Mask) ? Time(Counter::Mask) : Time(ticks);
+}
+
+void
+xpcc::TaskStatistics::resetAll()
+{
+	for (TaskStatistics *statistics = first; statistics != 0; statistics = statistics->next) {
+		statistics->reset();
+	}
+}
@@ -0,0 +1,208 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_TASK_STATISTICS_HPP
+#define XPCC_TASK_STATISTICS_HPP
+
+#include <stdint.h>
+
+#include <xpcc/architecture/utils.hpp>
+#include <xpcc/debug/profiler/counter.hpp>
+
+namespace xpcc
+{
+
+/**
+ * Execution time and deadline statistics of a periodic task
+ *
+ * Attach an instance to a task of the xpcc::Scheduler or to a
+ * xpcc::GenericPeriodicTimer to find out which task overruns and starves
+ * the others, and to size the task periods from real data:
+ *
+ * @code
+ * xpcc::TaskStatistics controlStatistics("control");
+ * scheduler.scheduleTask(controlTask, 1, 200, &controlStatistics);
+ *
+ * xpcc::TaskStatistics displayStatistics("display");
+ * xpcc::PeriodicTimer displayTimer(100);
+ * displayTimer.setStatistics(&displayStatistics);
+ * ...
+ * if (displayTimer.execute())
+ * {
+ *     // optional, measures the runtime of the handler
+ *     xpcc::TaskStatistics::Run run(displayStatistics);
+ *     display.update();
+ * }
+ * @endcode
+ *
+ * Recorded are:
+ * - the number of runs,
+ * - the worst case and average runtime,
+ * - the start jitter, which is the time from the release of the task
+ *   (end of its period) until it was started,
+ * - the number of overruns, which are periods that ended before the task
+ *   could run, because it was still waiting or running.
+ *
+ * All times are measured in ticks of xpcc::profiler::Counter, use
+ * xpcc::profiler::Counter::toNanoseconds() to convert them. The runtime
+ * is the time from start to end of the task, including the time the
+ * task was interrupted or preempted.
+ *
+ * Every overrun calls the global deadline miss handler. All instances
+ * are kept in a list to enumerate them with getFirst() and getNext().
+ *
+ * @ingroup	processing
+ */
+class TaskStatistics
+{
+public:
+	typedef profiler::Counter Counter;
+	typedef Counter::Type Time;
+
+	/// Called with the number of missed periods, possibly from an interrupt
+	typedef void (*DeadlineMissHandler)(TaskStatistics& statistics, uint32_t missed);
+
+	/// Measures the runtime from its construction to its destruction
+	class Run
+	{
+	public:
+		xpcc_always_inline
+		Run(TaskStatistics& statistics) :
+			statistics(statistics), start(Counter::now())
+		{
+		}
+
+		xpcc_always_inline
+		~Run()
+		{
+			statistics.recordRuntime(Counter::elapsed(start));
+		}
+
+	private:
+		TaskStatistics& statistics;
+		const Time start;
+	};
+
+public:
+	TaskStatistics(const char *name = 0);
+
+	~TaskStatistics();
+
+	/// Record the start of the task, `jitter` ticks after its release
+	void
+	recordStart(Time jitter);
+
+	/// Record the runtime of the task
+	void
+	recordRuntime(Time runtime);
+
+	/// Record that `missed` periods ended before the task could run
+	void
+	recordMiss(uint32_t missed = 1);
+
+	void
+	reset();
+
+public:
+	inline const char *
+	getName() const
+	{
+		return name;
+	}
+
+	inline uint32_t
+	getRuns() const
+	{
+		return runs;
+	}
+
+	inline uint32_t
+	getOverruns() const
+	{
+		return overruns;
+	}
+
+	/// Worst case execution time in ticks
+	inline Time
+	getWorstCaseTime() const
+	{
+		return worstCaseTime;
+	}
+
+	/// Average execution time in ticks
+	Time
+	getAverageTime() const;
+
+	/// Maximum start jitter in ticks
+	inline Time
+	getMaximumJitter() const
+	{
+		return maximumJitter;
+	}
+
+	/// Start jitter of the last run in ticks
+	inline Time
+	getLastJitter() const
+	{
+		return lastJitter;
+	}
+
+public:
+	static void
+	setDeadlineMissHandler(DeadlineMissHandler handler);
+
+	/// Convert a time of xpcc::Clock to ticks
+	static Time
+	fromMilliseconds(uint32_t ms);
+
+	/// Convert a time of xpcc::PreciseClock to ticks
+	static Time
+	fromMicroseconds(uint32_t us);
+
+	static inline TaskStatistics *
+	getFirst()
+	{
+		return first;
+	}
+
+	inline TaskStatistics *
+	getNext() const
+	{
+		return next;
+	}
+
+	/// Reset all statistics
+	static void
+	resetAll();
+
+private:
+	TaskStatistics(const TaskStatistics&);
+
+	TaskStatistics&
+	operator = (const TaskStatistics&);
+
+	const char *const name;
+	TaskStatistics *next;
+
+	uint32_t runs;
+	uint32_t overruns;
+	/// Number of recorded runtimes, used for the average
+	uint32_t measurements;
+	uint64_t totalTime;
+	Time worstCaseTime;
+	Time maximumJitter;
+	Time lastJitter;
+
+	static TaskStatistics *first;
+	static DeadlineMissHandler deadlineMissHandler;
+};
+
+}	// namespace xpcc
+
+#endif // XPCC_TASK_STATISTICS_HPP
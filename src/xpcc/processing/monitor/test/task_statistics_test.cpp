@@ -0,0 +1,149 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/processing/monitor/task_statistics.hpp>
+
+#include <string.h>
+
+#include "task_statistics_test.hpp"
+
+namespace
+{
+	xpcc::TaskStatistics *missedStatistics = 0;
+	uint32_t missedPeriods = 0;
+
+	void
+	handleDeadlineMiss(xpcc::TaskStatistics& statistics, uint32_t missed)
+	{
+		missedStatistics = &statistics;
+		missedPeriods += missed;
+	}
+
+	bool
+	isListed(const xpcc::TaskStatistics& statistics)
+	{
+		for (xpcc::TaskStatistics *item = xpcc::TaskStatistics::getFirst();
+				item != 0; item = item->getNext())
+		{
+			if (item == &statistics) {
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+// ----------------------------------------------------------------------------
+void
+TaskStatisticsTest::tearDown()
+{
+	xpcc::TaskStatistics::setDeadlineMissHandler(0);
+}
+
+void
+TaskStatisticsTest::testRecord()
+{
+	xpcc::TaskStatistics statistics("task");
+
+	TEST_ASSERT_EQUALS(statistics.getRuns(), 0U);
+	TEST_ASSERT_EQUALS(statistics.getAverageTime(), 0U);
+
+	statistics.recordStart(5);
+	statistics.recordRuntime(100);
+	statistics.recordStart(20);
+	statistics.recordRuntime(300);
+	statistics.recordStart(10);
+	statistics.recordRuntime(200);
+
+	TEST_ASSERT_EQUALS(statistics.getRuns(), 3U);
+	TEST_ASSERT_EQUALS(statistics.getWorstCaseTime(), 300U);
+	TEST_ASSERT_EQUALS(statistics.getAverageTime(), 200U);
+	TEST_ASSERT_EQUALS(statistics.getMaximumJitter(), 20U);
+	TEST_ASSERT_EQUALS(statistics.getLastJitter(), 10U);
+
+	statistics.recordMiss();
+	statistics.recordMiss(3);
+	TEST_ASSERT_EQUALS(statistics.getOverruns(), 4U);
+
+	// a run measures the runtime, but does not count as a start
+	xpcc::TaskStatistics measured;
+	{
+		xpcc::TaskStatistics::Run run(measured);
+	}
+	TEST_ASSERT_EQUALS(measured.getRuns(), 0U);
+	TEST_ASSERT_EQUALS(measured.getAverageTime(), measured.getWorstCaseTime());
+}
+
+void
+TaskStatisticsTest::testReset()
+{
+	xpcc::TaskStatistics statistics1;
+	xpcc::TaskStatistics statistics2;
+
+	statistics1.recordStart(5);
+	statistics1.recordRuntime(100);
+	statistics1.recordMiss();
+	statistics2.recordStart(5);
+
+	statistics1.reset();
+	TEST_ASSERT_EQUALS(statistics1.getRuns(), 0U);
+	TEST_ASSERT_EQUALS(statistics1.getOverruns(), 0U);
+	TEST_ASSERT_EQUALS(statistics1.getWorstCaseTime(), 0U);
+	TEST_ASSERT_EQUALS(statistics1.getMaximumJitter(), 0U);
+	TEST_ASSERT_EQUALS(statistics2.getRuns(), 1U);
+
+	xpcc::TaskStatistics::resetAll();
+	TEST_ASSERT_EQUALS(statistics2.getRuns(), 0U);
+}
+
+void
+TaskStatisticsTest::testDeadlineMissHandler()
+{
+	xpcc::TaskStatistics statistics;
+	missedStatistics = 0;
+	missedPeriods = 0;
+
+	statistics.recordMiss();
+	TEST_ASSERT_TRUE(missedStatistics == 0);
+
+	xpcc::TaskStatistics::setDeadlineMissHandler(handleDeadlineMiss);
+	statistics.recordMiss(2);
+	TEST_ASSERT_TRUE(missedStatistics == &statistics);
+	TEST_ASSERT_EQUALS(missedPeriods, 2U);
+	TEST_ASSERT_EQUALS(statistics.getOverruns(), 3U);
+}
+
+void
+TaskStatisticsTest::testEnumerate()
+{
+	xpcc::TaskStatistics control("control");
+	{
+		xpcc::TaskStatistics display("display");
+		TEST_ASSERT_TRUE(isListed(control));
+		TEST_ASSERT_TRUE(isListed(display));
+		TEST_ASSERT_TRUE(strcmp(display.getName(), "display") == 0);
+	}
+	// destroyed statistics are removed from the list
+	uint8_t count = 0;
+	for (xpcc::TaskStatistics *item = xpcc::TaskStatistics::getFirst();
+			item != 0; item = item->getNext())
+	{
+		count++;
+	}
+	TEST_ASSERT_EQUALS(count, 1U);
+}
+
+void
+TaskStatisticsTest::testConversion()
+{
+	TEST_ASSERT_EQUALS(xpcc::TaskStatistics::fromMilliseconds(0), 0U);
+	TEST_ASSERT_EQUALS(xpcc::TaskStatistics::fromMilliseconds(2),
+			xpcc::TaskStatistics::fromMicroseconds(2000));
+	TEST_ASSERT_TRUE(xpcc::TaskStatistics::fromMilliseconds(1) > 0U);
+}
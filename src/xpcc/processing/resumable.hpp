@@ -108,7 +108,14 @@
  *
  * For other examples take a look in the `examples` folder in the XPCC
  * root folder.
+ *
+ * If the compiler supports C++20 coroutines, `xpcc::co::Resumable` offers
+ * the same functionality without the limits of the macros: there is no
+ * limit of resume points and nesting levels and local variables keep
+ * their value. The coroutine frames are allocated from a static pool.
+ * See `examples/linux/resumable_benchmark` for a comparison.
  */
 
 #include "resumable/resumable.hpp"
 #include "resumable/nested_resumable.hpp"
+#include "resumable/coroutine.hpp"
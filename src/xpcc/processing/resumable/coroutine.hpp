@@ -0,0 +1,578 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_RESUMABLE_COROUTINE_HPP
+#define XPCC_RESUMABLE_COROUTINE_HPP
+
+/// @ingroup	resumable
+/// `1` if the compiler supports C++20 coroutines, `0` otherwise
+#if defined(__cpp_impl_coroutine) && (__cpp_impl_coroutine >= 201902L)
+#	define XPCC_RESUMABLE_COROUTINES 1
+#else
+#	define XPCC_RESUMABLE_COROUTINES 0
+#endif
+
+#if XPCC_RESUMABLE_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <cstddef>
+#include <stdint.h>
+
+#include "resumable.hpp"
+
+/// @ingroup	resumable
+/// Size of one frame of the default coroutine frame pool in bytes
+#ifndef XPCC_COROUTINE_FRAME_SIZE
+#	define XPCC_COROUTINE_FRAME_SIZE 128
+#endif
+
+/// @ingroup	resumable
+/// Number of frames in the default coroutine frame pool
+#ifndef XPCC_COROUTINE_FRAMES
+#	define XPCC_COROUTINE_FRAMES 8
+#endif
+
+namespace xpcc
+{
+
+namespace co
+{
+
+/**
+ * Statically allocated pool for coroutine frames
+ *
+ * The frames of xpcc::co::Resumable coroutines are allocated from this
+ * pool instead of the heap. All frames have the same size, allocation and
+ * release only flip a bit in the usage bitmap.
+ *
+ * The frame size of a coroutine is only known to the compiler, use
+ * getLargestRequest() to find the right `BlockSize` for your application.
+ *
+ * @warning	The pool is not interrupt-safe, create coroutines only from
+ * 			the main context.
+ *
+ * @tparam	BlockSize	size of one frame in bytes
+ * @tparam	Blocks		number of frames
+ *
+ * @ingroup	resumable
+ */
+template< std::size_t BlockSize, std::size_t Blocks >
+class StaticFramePool
+{
+	static constexpr std::size_t Alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+	static constexpr std::size_t Words = (Blocks + 31) / 32;
+
+	static_assert(Blocks > 0, "The pool must contain at least one frame!");
+	static_assert(BlockSize % Alignment == 0,
+			"The frame size must be a multiple of the default new alignment!");
+
+public:
+	static constexpr std::size_t FrameSize = BlockSize;
+	static constexpr std::size_t Frames = Blocks;
+
+	/// @return	a free frame or `nullptr` if the frame is too large or the pool is exhausted
+	static void *
+	allocate(std::size_t size)
+	{
+		if (size > largestRequest) {
+			largestRequest = size;
+		}
+
+		if (size <= BlockSize)
+		{
+			for (std::size_t word = 0; word < Words; ++word)
+			{
+				const uint32_t free = ~used[word];
+				if (free == 0) {
+					continue;
+				}
+
+				const std::size_t bit = __builtin_ctz(free);
+				const std::size_t index = word * 32 + bit;
+				if (index >= Blocks) {
+					break;
+				}
+
+				used[word] |= (uint32_t(1) << bit);
+				if (++usedFrames > highWaterMark) {
+					highWaterMark = usedFrames;
+				}
+				return memory[index];
+			}
+		}
+
+		failedAllocations++;
+		return nullptr;
+	}
+
+	static void
+	free(void *ptr)
+	{
+		const std::size_t index =
+				(static_cast<uint8_t *>(ptr) - &memory[0][0]) / BlockSize;
+
+		used[index / 32] &= ~(uint32_t(1) << (index % 32));
+		usedFrames--;
+	}
+
+	/// Number of frames currently in use
+	static inline std::size_t
+	getUsedFrames()
+	{
+		return usedFrames;
+	}
+
+	/// Maximum number of frames in use at the same time
+	static inline std::size_t
+	getHighWaterMark()
+	{
+		return highWaterMark;
+	}
+
+	/// Largest frame size requested by the compiler in bytes
+	static inline std::size_t
+	getLargestRequest()
+	{
+		return largestRequest;
+	}
+
+	static inline uint32_t
+	getFailedAllocations()
+	{
+		return failedAllocations;
+	}
+
+private:
+	alignas(Alignment) static inline uint8_t memory[Blocks][BlockSize];
+	static inline uint32_t used[Words];
+
+	static inline std::size_t usedFrames = 0;
+	static inline std::size_t highWaterMark = 0;
+	static inline std::size_t largestRequest = 0;
+	static inline uint32_t failedAllocations = 0;
+};
+
+/// @ingroup	resumable
+typedef StaticFramePool<XPCC_COROUTINE_FRAME_SIZE, XPCC_COROUTINE_FRAMES> DefaultFramePool;
+
+/// @cond
+namespace detail
+{
+
+struct PromiseBase
+{
+	/// Awaiting coroutine, resumed when this one has finished
+	std::coroutine_handle<> continuation;
+	/// Outermost coroutine of the call chain
+	PromiseBase *root = this;
+	/// Innermost coroutine of the call chain, only valid in the root
+	std::coroutine_handle<> leaf;
+
+	struct FinalAwaiter
+	{
+		bool
+		await_ready() noexcept
+		{
+			return false;
+		}
+
+		template< class Promise >
+		std::coroutine_handle<>
+		await_suspend(std::coroutine_handle<Promise> handle) noexcept
+		{
+			PromiseBase& promise = handle.promise();
+			if (promise.continuation)
+			{
+				// return to the caller like RF_CALL does
+				promise.root->leaf = promise.continuation;
+				return promise.continuation;
+			}
+			return std::noop_coroutine();
+		}
+
+		void
+		await_resume() noexcept
+		{
+		}
+	};
+
+	// coroutines start when they are run or awaited the first time
+	std::suspend_always
+	initial_suspend() noexcept
+	{
+		return {};
+	}
+
+	FinalAwaiter
+	final_suspend() noexcept
+	{
+		return {};
+	}
+
+	void
+	unhandled_exception()
+	{
+		std::terminate();
+	}
+};
+
+template< typename T >
+struct Promise : public PromiseBase
+{
+	T result;
+
+	void
+	return_value(T value)
+	{
+		result = value;
+	}
+
+	T
+	getResult()
+	{
+		return result;
+	}
+};
+
+template<>
+struct Promise<void> : public PromiseBase
+{
+	void
+	return_void()
+	{
+	}
+
+	void
+	getResult()
+	{
+	}
+};
+
+}	// namespace detail
+/// @endcond
+
+/**
+ * Coroutine based resumable function
+ *
+ * An alternative to the `RF_*` macros for compilers supporting C++20
+ * coroutines. The state of a coroutine lives in its frame, so there is no
+ * limit of resume points per function and no `Levels` argument limiting
+ * the nesting depth. The frames are allocated from a StaticFramePool, the
+ * number of coroutines alive at the same time is only limited by the
+ * size of the pool.
+ *
+ * @code
+ * xpcc::co::Resumable<bool>
+ * Sensor::readRegister(uint8_t reg)
+ * {
+ *     CO_WAIT_UNTIL(transaction.configureWriteRead(&reg, 1, buffer, 2));
+ *     CO_WAIT_UNTIL(I2cMaster::start(&transaction));
+ *     CO_WAIT_WHILE(transaction.isBusy());
+ *     co_return transaction.getState() != xpcc::I2c::TransactionState::Error;
+ * }
+ *
+ * xpcc::co::Resumable<bool>
+ * Sensor::initialize()
+ * {
+ *     if (not CO_CALL(readRegister(0x0f))) {
+ *         co_return false;
+ *     }
+ *     timeout.restart(10);
+ *     CO_WAIT_UNTIL(timeout.isExpired());
+ *     co_return true;
+ * }
+ *
+ * // from a protothread or the main loop
+ * auto init = sensor.initialize();
+ * while (init.run()) { ... }
+ * bool success = init.getResult();
+ * @endcode
+ *
+ * Porting code written with the macros is mostly mechanical: remove
+ * `RF_BEGIN()` and `RF_END()`, replace `RF_RETURN(x)` with `co_return x`
+ * and the other `RF_` macros with their `CO_` counterpart.
+ *
+ * In contrast to the macros, local variables keep their value over a
+ * yield and every call of a resumable function creates an independent
+ * instance, so the same function may run several times in parallel.
+ *
+ * If the pool is exhausted, the coroutine is not created and `getState()`
+ * returns xpcc::rf::NestingError. Awaiting such a coroutine returns the
+ * default value of `T`, like `RF_CALL` does when running out of nesting
+ * levels.
+ *
+ * @tparam	T		return type, must have a default constructor
+ * @tparam	Pool	frame allocator, see StaticFramePool
+ *
+ * @ingroup	resumable
+ */
+template< typename T = void, class Pool = DefaultFramePool >
+class Resumable
+{
+public:
+	struct promise_type : public detail::Promise<T>
+	{
+		static void *
+		operator new(std::size_t size) noexcept
+		{
+			return Pool::allocate(size);
+		}
+
+		static void
+		operator delete(void *ptr) noexcept
+		{
+			Pool::free(ptr);
+		}
+
+		static Resumable
+		get_return_object_on_allocation_failure() noexcept
+		{
+			return Resumable();
+		}
+
+		Resumable
+		get_return_object() noexcept
+		{
+			this->leaf = Handle::from_promise(*this);
+			return Resumable(Handle::from_promise(*this));
+		}
+	};
+
+	typedef std::coroutine_handle<promise_type> Handle;
+
+public:
+	Resumable(Resumable&& other) noexcept :
+		handle(other.handle)
+	{
+		other.handle = nullptr;
+	}
+
+	Resumable&
+	operator = (Resumable&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (handle) {
+				handle.destroy();
+			}
+			handle = other.handle;
+			other.handle = nullptr;
+		}
+		return *this;
+	}
+
+	~Resumable()
+	{
+		if (handle) {
+			handle.destroy();
+		}
+	}
+
+	/**
+	 * Resume the coroutine until it yields or finishes.
+	 *
+	 * @return	`true` while the coroutine is running, `false` when it has
+	 * 			finished or could not be created
+	 */
+	bool
+	run()
+	{
+		if (not handle or handle.done()) {
+			return false;
+		}
+		handle.promise().leaf.resume();
+		return not handle.done();
+	}
+
+	/**
+	 * Run the coroutine until it has finished and return its result.
+	 *
+	 * @warning	Use this with extreme caution, this can cause deadlocks!
+	 */
+	T
+	runBlocking()
+	{
+		while (run()) {
+		}
+		return getResult();
+	}
+
+	inline bool
+	isRunning() const
+	{
+		return (handle and not handle.done());
+	}
+
+	/// @return	xpcc::rf::Running, xpcc::rf::Stop or xpcc::rf::NestingError
+	///			if no frame could be allocated
+	inline uint_fast8_t
+	getState() const
+	{
+		if (not handle) {
+			return rf::NestingError;
+		}
+		return handle.done() ? rf::Stop : rf::Running;
+	}
+
+	/// @return	the result once the coroutine has finished, the default value of `T` before
+	inline T
+	getResult() const
+	{
+		if (handle) {
+			return handle.promise().getResult();
+		}
+		return T();
+	}
+
+public:
+	/// @cond
+	struct Awaiter
+	{
+		Handle handle;
+
+		bool
+		await_ready() noexcept
+		{
+			return (not handle or handle.done());
+		}
+
+		template< class Promise >
+		std::coroutine_handle<>
+		await_suspend(std::coroutine_handle<Promise> caller) noexcept
+		{
+			detail::PromiseBase& parent = caller.promise();
+			promise_type& child = handle.promise();
+
+			child.continuation = caller;
+			child.root = parent.root;
+			parent.root->leaf = handle;
+
+			// continue directly in the called coroutine
+			return handle;
+		}
+
+		T
+		await_resume()
+		{
+			if (handle) {
+				return handle.promise().getResult();
+			}
+			return T();
+		}
+	};
+
+	Awaiter
+	operator co_await () && noexcept
+	{
+		return Awaiter{handle};
+	}
+
+	Awaiter
+	operator co_await () & noexcept
+	{
+		return Awaiter{handle};
+	}
+	/// @endcond
+
+private:
+	Resumable() :
+		handle(nullptr)
+	{
+	}
+
+	explicit Resumable(Handle handle) :
+		handle(handle)
+	{
+	}
+
+	Resumable(const Resumable&) = delete;
+
+	Resumable&
+	operator = (const Resumable&) = delete;
+
+	Handle handle;
+};
+
+/// @cond
+struct YieldAwaiter
+{
+	bool
+	await_ready() noexcept
+	{
+		return false;
+	}
+
+	void
+	await_suspend(std::coroutine_handle<>) noexcept
+	{
+	}
+
+	void
+	await_resume() noexcept
+	{
+	}
+};
+/// @endcond
+
+/// Suspend the coroutine, it is continued in the next `run()`
+/// @ingroup	resumable
+inline YieldAwaiter
+yield()
+{
+	return {};
+}
+
+}	// namespace co
+
+}	// namespace xpcc
+
+/**
+ * Yield the coroutine, equivalent of `RF_YIELD()`.
+ *
+ * @ingroup	resumable
+ * @hideinitializer
+ */
+#define CO_YIELD() \
+	co_await ::xpcc::co::yield()
+
+/**
+ * Yield while the condition is true, equivalent of `RF_WAIT_WHILE()`.
+ *
+ * @ingroup	resumable
+ * @hideinitializer
+ */
+#define CO_WAIT_WHILE(condition) \
+	do { \
+		while (condition) { \
+			co_await ::xpcc::co::yield(); \
+		} \
+	} while(0)
+
+/**
+ * Yield until the condition is true, equivalent of `RF_WAIT_UNTIL()`.
+ *
+ * @ingroup	resumable
+ * @hideinitializer
+ */
+#define CO_WAIT_UNTIL(condition) \
+	CO_WAIT_WHILE(!(condition))
+
+/**
+ * Call a coroutine and return its result, equivalent of `RF_CALL()`.
+ *
+ * @ingroup	resumable
+ * @hideinitializer
+ */
+#define CO_CALL(resumable) \
+	(co_await (resumable))
+
+#endif	// XPCC_RESUMABLE_COROUTINES
+
+#endif	// XPCC_RESUMABLE_COROUTINE_HPP
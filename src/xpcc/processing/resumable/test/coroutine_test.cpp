@@ -0,0 +1,189 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/processing/resumable.hpp>
+#include "coroutine_test.hpp"
+
+#if XPCC_RESUMABLE_COROUTINES
+
+namespace
+{
+	typedef xpcc::co::StaticFramePool<256, 4> TestPool;
+
+	template< typename T = void >
+	using Resumable = xpcc::co::Resumable<T, TestPool>;
+
+	uint8_t state;
+
+	Resumable<>
+	yieldTwice()
+	{
+		state = 1;
+		CO_YIELD();
+		state = 2;
+		CO_YIELD();
+		state = 3;
+	}
+
+	Resumable<uint8_t>
+	waitFor(const volatile bool& condition, uint8_t result)
+	{
+		CO_WAIT_UNTIL(condition);
+		co_return result;
+	}
+
+	Resumable<uint16_t>
+	sumOf(const volatile bool& condition)
+	{
+		uint16_t sum = CO_CALL(waitFor(condition, 10));
+		sum += CO_CALL(waitFor(condition, 20));
+		co_return sum;
+	}
+
+	Resumable<uint16_t>
+	nested(const volatile bool& condition)
+	{
+		state = 1;
+		uint16_t sum = CO_CALL(sumOf(condition));
+		state = 2;
+		co_return sum + 1;
+	}
+
+	Resumable<uint32_t>
+	count(uint8_t steps)
+	{
+		uint32_t sum = 0;
+		for (uint8_t i = 1; i <= steps; ++i)
+		{
+			sum += i;
+			CO_YIELD();
+		}
+		co_return sum;
+	}
+}
+
+// ----------------------------------------------------------------------------
+void
+CoroutineTest::testYield()
+{
+	state = 0;
+	Resumable<> coroutine = yieldTwice();
+
+	// nothing is executed before the first run
+	TEST_ASSERT_EQUALS(state, 0);
+	TEST_ASSERT_EQUALS(coroutine.getState(), xpcc::rf::Running);
+
+	TEST_ASSERT_TRUE(coroutine.run());
+	TEST_ASSERT_EQUALS(state, 1);
+	TEST_ASSERT_TRUE(coroutine.run());
+	TEST_ASSERT_EQUALS(state, 2);
+	TEST_ASSERT_FALSE(coroutine.run());
+	TEST_ASSERT_EQUALS(state, 3);
+
+	TEST_ASSERT_FALSE(coroutine.isRunning());
+	TEST_ASSERT_EQUALS(coroutine.getState(), xpcc::rf::Stop);
+	TEST_ASSERT_FALSE(coroutine.run());
+}
+
+void
+CoroutineTest::testNesting()
+{
+	volatile bool condition = false;
+	state = 0;
+	Resumable<uint16_t> coroutine = nested(condition);
+
+	for (uint8_t i = 0; i < 5; ++i) {
+		TEST_ASSERT_TRUE(coroutine.run());
+	}
+	TEST_ASSERT_EQUALS(state, 1);
+	// one frame for each of nested, sumOf and waitFor
+	TEST_ASSERT_EQUALS(TestPool::getUsedFrames(), 3U);
+
+	condition = true;
+	TEST_ASSERT_FALSE(coroutine.run());
+	TEST_ASSERT_EQUALS(state, 2);
+	TEST_ASSERT_EQUALS(coroutine.getResult(), 31U);
+	TEST_ASSERT_EQUALS(TestPool::getUsedFrames(), 1U);
+
+	condition = false;
+	Resumable<uint16_t> blocking = sumOf(condition);
+	blocking.run();
+	condition = true;
+	TEST_ASSERT_EQUALS(blocking.runBlocking(), 30U);
+}
+
+void
+CoroutineTest::testLocalVariables()
+{
+	// two instances of the same function run independently
+	Resumable<uint32_t> first = count(3);
+	Resumable<uint32_t> second = count(5);
+
+	uint8_t steps = 0;
+	while (first.isRunning() or second.isRunning())
+	{
+		first.run();
+		second.run();
+		steps++;
+	}
+
+	TEST_ASSERT_EQUALS(steps, 6U);
+	TEST_ASSERT_EQUALS(first.getResult(), 6U);
+	TEST_ASSERT_EQUALS(second.getResult(), 15U);
+}
+
+void
+CoroutineTest::testFramePool()
+{
+	TEST_ASSERT_EQUALS(TestPool::getUsedFrames(), 0U);
+	{
+		Resumable<> coroutine = yieldTwice();
+		TEST_ASSERT_EQUALS(TestPool::getUsedFrames(), 1U);
+
+		// moving does not allocate a new frame
+		Resumable<> moved = static_cast<Resumable<>&&>(coroutine);
+		TEST_ASSERT_EQUALS(TestPool::getUsedFrames(), 1U);
+		moved.run();
+	}
+	// destroying a suspended coroutine releases its frame
+	TEST_ASSERT_EQUALS(TestPool::getUsedFrames(), 0U);
+
+	TEST_ASSERT_TRUE(TestPool::getLargestRequest() > 0U);
+	TEST_ASSERT_TRUE(TestPool::getLargestRequest() <= 256U);
+	TEST_ASSERT_TRUE(TestPool::getHighWaterMark() >= 3U);
+}
+
+void
+CoroutineTest::testPoolExhausted()
+{
+	Resumable<> coroutines[4] = {
+		yieldTwice(), yieldTwice(), yieldTwice(), yieldTwice()
+	};
+	TEST_ASSERT_EQUALS(TestPool::getUsedFrames(), 4U);
+
+	Resumable<uint32_t> failed = count(2);
+	TEST_ASSERT_EQUALS(failed.getState(), xpcc::rf::NestingError);
+	TEST_ASSERT_FALSE(failed.run());
+	TEST_ASSERT_EQUALS(failed.getResult(), 0U);
+	TEST_ASSERT_EQUALS(TestPool::getFailedAllocations(), 1U);
+
+	for (Resumable<>& coroutine : coroutines) {
+		coroutine.runBlocking();
+	}
+}
+
+#else
+
+void CoroutineTest::testYield() {}
+void CoroutineTest::testNesting() {}
+void CoroutineTest::testLocalVariables() {}
+void CoroutineTest::testFramePool() {}
+void CoroutineTest::testPoolExhausted() {}
+
+#endif
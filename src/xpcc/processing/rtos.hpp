@@ -33,3 +33,4 @@
 #include "rtos/mutex.hpp"
 #include "rtos/semaphore.hpp"
 #include "rtos/queue.hpp"
+#include "rtos/task_pool.hpp"
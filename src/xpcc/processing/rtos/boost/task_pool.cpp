@@ -0,0 +1,219 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include "../task_pool.hpp"
+
+namespace
+{
+	// pool and deque index of the calling thread, if it is a worker
+	thread_local xpcc::rtos::TaskPool* currentPool = 0;
+	thread_local std::size_t currentIndex = 0;
+}
+
+// ----------------------------------------------------------------------------
+xpcc::rtos::task_pool::StateBase::StateBase() :
+	ready(false)
+{
+}
+
+bool
+xpcc::rtos::task_pool::StateBase::isReady() const
+{
+	boost::lock_guard<boost::mutex> lock(mutex);
+	return ready;
+}
+
+void
+xpcc::rtos::task_pool::StateBase::wait() const
+{
+	boost::unique_lock<boost::mutex> lock(mutex);
+	while (not ready) {
+		condition.wait(lock);
+	}
+}
+
+void
+xpcc::rtos::task_pool::StateBase::setReady(std::exception_ptr exception)
+{
+	{
+		boost::lock_guard<boost::mutex> lock(mutex);
+		this->exception = exception;
+		ready = true;
+	}
+	condition.notify_all();
+}
+
+void
+xpcc::rtos::task_pool::StateBase::rethrow() const
+{
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+}
+
+// ----------------------------------------------------------------------------
+xpcc::rtos::TaskPool::TaskPool(std::size_t count) :
+	pending(0), next(0), stopping(false)
+{
+	if (count == 0) {
+		count = boost::thread::hardware_concurrency();
+	}
+	if (count == 0) {
+		count = 1;
+	}
+
+	workers.reserve(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		workers.push_back(new Worker());
+	}
+
+	// start the threads only after all deques exist, they steal from
+	// each other right away
+	threads.reserve(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		threads.push_back(new boost::thread([this, i]() { run(i); }));
+	}
+}
+
+xpcc::rtos::TaskPool::~TaskPool()
+{
+	{
+		boost::lock_guard<boost::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+	sleepCondition.notify_all();
+
+	for (std::size_t i = 0; i < threads.size(); ++i)
+	{
+		threads[i]->join();
+		delete threads[i];
+	}
+	for (std::size_t i = 0; i < workers.size(); ++i) {
+		delete workers[i];
+	}
+}
+
+// ----------------------------------------------------------------------------
+bool
+xpcc::rtos::TaskPool::runPendingTask()
+{
+	task_pool::Task* task;
+	if (currentPool == this)
+	{
+		task = take(currentIndex);
+		if (task == 0) {
+			task = steal(currentIndex + 1, currentIndex);
+		}
+	}
+	else {
+		task = steal(0, workers.size());
+	}
+
+	if (task == 0) {
+		return false;
+	}
+
+	task->run();
+	delete task;
+	return true;
+}
+
+bool
+xpcc::rtos::TaskPool::isWorkerThread() const
+{
+	return (currentPool == this);
+}
+
+// ----------------------------------------------------------------------------
+void
+xpcc::rtos::TaskPool::enqueue(task_pool::Task* task)
+{
+	std::size_t index;
+	if (currentPool == this) {
+		index = currentIndex;
+	}
+	else {
+		index = next.fetch_add(1, std::memory_order_relaxed) % workers.size();
+	}
+
+	// counted before it becomes visible, so `pending` never underflows
+	pending.fetch_add(1);
+	{
+		boost::lock_guard<boost::mutex> lock(workers[index]->mutex);
+		workers[index]->tasks.push_back(task);
+	}
+
+	{
+		boost::lock_guard<boost::mutex> lock(sleepMutex);
+	}
+	sleepCondition.notify_one();
+}
+
+xpcc::rtos::task_pool::Task*
+xpcc::rtos::TaskPool::take(std::size_t index)
+{
+	Worker& worker = *workers[index];
+
+	boost::lock_guard<boost::mutex> lock(worker.mutex);
+	if (worker.tasks.empty()) {
+		return 0;
+	}
+
+	task_pool::Task* task = worker.tasks.back();
+	worker.tasks.pop_back();
+	pending.fetch_sub(1);
+	return task;
+}
+
+xpcc::rtos::task_pool::Task*
+xpcc::rtos::TaskPool::steal(std::size_t start, std::size_t skip)
+{
+	const std::size_t count = workers.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const std::size_t index = (start + i) % count;
+		if (index == skip) {
+			continue;
+		}
+
+		Worker& worker = *workers[index];
+		boost::lock_guard<boost::mutex> lock(worker.mutex);
+		if (not worker.tasks.empty())
+		{
+			task_pool::Task* task = worker.tasks.front();
+			worker.tasks.pop_front();
+			pending.fetch_sub(1);
+			return task;
+		}
+	}
+	return 0;
+}
+
+// ----------------------------------------------------------------------------
+void
+xpcc::rtos::TaskPool::run(std::size_t index)
+{
+	currentPool = this;
+	currentIndex = index;
+
+	while (true)
+	{
+		if (runPendingTask()) {
+			continue;
+		}
+
+		boost::unique_lock<boost::mutex> lock(sleepMutex);
+		while (pending.load() == 0 and not stopping) {
+			sleepCondition.wait(lock);
+		}
+		if (pending.load() == 0 and stopping) {
+			break;
+		}
+	}
+}
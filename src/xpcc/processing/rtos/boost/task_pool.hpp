@@ -0,0 +1,355 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_BOOST__TASK_POOL_HPP
+#define XPCC_BOOST__TASK_POOL_HPP
+
+#ifndef XPCC_RTOS__TASK_POOL_HPP
+#	error "Don't include this file directly, use <xpcc/processing/rtos/task_pool.hpp>"
+#endif
+
+#include <stdint.h>
+#include <cstddef>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <type_traits>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace xpcc
+{
+	namespace rtos
+	{
+		// forward declaration
+		class TaskPool;
+
+		/// @cond
+		namespace task_pool
+		{
+			class Task
+			{
+			public:
+				virtual
+				~Task()
+				{
+				}
+
+				virtual void
+				run() = 0;
+			};
+
+			class StateBase
+			{
+			public:
+				StateBase();
+
+				bool
+				isReady() const;
+
+				void
+				wait() const;
+
+			protected:
+				void
+				setReady(std::exception_ptr exception);
+
+				void
+				rethrow() const;
+
+			private:
+				mutable boost::mutex mutex;
+				mutable boost::condition_variable condition;
+				bool ready;
+				std::exception_ptr exception;
+			};
+
+			template <typename T>
+			class State : public StateBase
+			{
+			public:
+				template <typename Function>
+				void
+				execute(Function& function);
+
+				T
+				get() const;
+
+			private:
+				boost::optional<T> value;
+			};
+
+			template <>
+			class State<void> : public StateBase
+			{
+			public:
+				template <typename Function>
+				void
+				execute(Function& function);
+
+				void
+				get() const;
+			};
+
+			template <typename T, typename Function>
+			class FunctionTask : public Task
+			{
+			public:
+				FunctionTask(const Function& function,
+						const boost::shared_ptr< State<T> >& state) :
+					function(function), state(state)
+				{
+				}
+
+				virtual void
+				run()
+				{
+					state->execute(function);
+				}
+
+			private:
+				Function function;
+				boost::shared_ptr< State<T> > state;
+			};
+		}
+		/// @endcond
+
+		/**
+		 * Result of a task submitted to a TaskPool.
+		 *
+		 * Futures are cheap to copy, all copies refer to the same result.
+		 * Waiting for a future from a thread that belongs to the pool does
+		 * not block that worker: it executes other pending tasks until the
+		 * result is available. Nested parallelism (a task that submits
+		 * tasks and waits for them) therefore can't deadlock the pool.
+		 *
+		 * @ingroup	boost_rtos
+		 */
+		template <typename T>
+		class Future
+		{
+		public:
+			/// Creates an invalid future not associated with any task
+			Future() :
+				pool(0), state()
+			{
+			}
+
+			/// `true` if the future refers to a submitted task
+			inline bool
+			isValid() const
+			{
+				return (state.get() != 0);
+			}
+
+			/// `true` if the task has finished
+			inline bool
+			isReady() const
+			{
+				return state->isReady();
+			}
+
+			/// Wait until the task has finished
+			void
+			wait() const;
+
+			/**
+			 * Wait for the task and return its result.
+			 *
+			 * If the task has thrown an exception, it is rethrown here.
+			 * May be called multiple times.
+			 */
+			T
+			get() const;
+
+		private:
+			friend class TaskPool;
+
+			Future(TaskPool* pool,
+					const boost::shared_ptr< task_pool::State<T> >& state) :
+				pool(pool), state(state)
+			{
+			}
+
+			TaskPool* pool;
+			boost::shared_ptr< task_pool::State<T> > state;
+		};
+
+		/**
+		 * Work-stealing task pool.
+		 *
+		 * Spreads short, independent pieces of work over a fixed number of
+		 * worker threads. Every worker owns a deque of tasks: it pushes and
+		 * pops work at the back (LIFO, cache friendly), while idle workers
+		 * steal from the front of the other deques (FIFO, which takes the
+		 * largest chunks of recursively split work). Tasks submitted from
+		 * outside the pool are distributed round-robin.
+		 *
+		 * @code
+		 * xpcc::rtos::TaskPool pool;
+		 *
+		 * xpcc::rtos::Future<float> area = pool.submit(
+		 *         [&polygon]() { return polygon.getArea(); });
+		 *
+		 * xpcc::rtos::parallelFor(pool, 0, int(matrices.size()),
+		 *         [&matrices](int i) { matrices[i] = matrices[i].inverted(); });
+		 *
+		 * float total = area.get();
+		 * @endcode
+		 *
+		 * The deques are guarded by a mutex each, so workers only contend
+		 * when stealing from each other. This keeps the implementation
+		 * simple, tasks should therefore contain at least a few microseconds
+		 * of work. Use the `grain` argument of parallelFor() and
+		 * parallelReduce() to control this.
+		 *
+		 * @warning	Tasks may not be submitted to a pool that is being
+		 * 			destroyed. The destructor runs all pending tasks before
+		 * 			joining the workers.
+		 *
+		 * @ingroup	boost_rtos
+		 */
+		class TaskPool
+		{
+		public:
+			/**
+			 * Create and start the worker threads.
+			 *
+			 * @param	workers		Number of worker threads, `0` uses one
+			 * 						thread per hardware thread.
+			 */
+			explicit
+			TaskPool(std::size_t workers = 0);
+
+			/// Execute all pending tasks and stop the workers
+			~TaskPool();
+
+			inline std::size_t
+			getWorkerCount() const
+			{
+				return workers.size();
+			}
+
+			/**
+			 * Submit a callable without arguments for execution.
+			 *
+			 * The callable is copied into the task.
+			 */
+			template <typename Function>
+			Future< typename std::result_of<Function()>::type >
+			submit(const Function& function);
+
+			/**
+			 * Execute a single pending task in the calling thread.
+			 *
+			 * Workers take tasks from their own deque first, every other
+			 * thread steals from the workers.
+			 *
+			 * @return	`false` if no task was available
+			 */
+			bool
+			runPendingTask();
+
+			/// `true` if the calling thread is a worker of this pool
+			bool
+			isWorkerThread() const;
+
+		private:
+			struct Worker
+			{
+				boost::mutex mutex;
+				std::deque<task_pool::Task*> tasks;
+			};
+
+			// disable copy constructor
+			TaskPool(const TaskPool&);
+
+			// disable assignment operator
+			TaskPool &
+			operator = (const TaskPool&);
+
+			void
+			enqueue(task_pool::Task* task);
+
+			task_pool::Task*
+			take(std::size_t index);
+
+			task_pool::Task*
+			steal(std::size_t start, std::size_t skip);
+
+			void
+			run(std::size_t index);
+
+			std::vector<Worker*> workers;
+			std::vector<boost::thread*> threads;
+
+			std::atomic<std::size_t> pending;
+			std::atomic<std::size_t> next;
+
+			// orders updates of `pending` against workers going to
+			// sleep, so that no wake-up is lost
+			boost::mutex sleepMutex;
+			boost::condition_variable sleepCondition;
+			bool stopping;
+		};
+
+		/**
+		 * Call `function(i)` for every `i` in [begin, end) in parallel.
+		 *
+		 * The range is split in halves recursively until a part contains at
+		 * most `grain` indices, idle workers steal the larger upper halves.
+		 * Returns after all calls have finished. The calling thread takes
+		 * part in the work.
+		 *
+		 * @ingroup	boost_rtos
+		 */
+		template <typename Index, typename Function>
+		void
+		parallelFor(TaskPool& pool, Index begin, Index end, Index grain,
+				const Function& function);
+
+		/// Uses a grain size that yields about eight parts per worker
+		template <typename Index, typename Function>
+		void
+		parallelFor(TaskPool& pool, Index begin, Index end,
+				const Function& function);
+
+		/**
+		 * Combine `map(i)` for every `i` in [begin, end) with `reduce`.
+		 *
+		 * The range is split like in parallelFor(), every part is folded
+		 * sequentially starting with `identity` and the partial results
+		 * are combined with `reduce(lower, upper)`. The order of the
+		 * operands is kept, so `reduce` has to be associative but not
+		 * commutative.
+		 *
+		 * @code
+		 * float length = xpcc::rtos::parallelReduce(pool,
+		 *         std::size_t(0), points.size() - 1, std::size_t(256), 0.f,
+		 *         [&points](std::size_t i) { return (points[i+1] - points[i]).getLength(); },
+		 *         [](float a, float b) { return a + b; });
+		 * @endcode
+		 *
+		 * @ingroup	boost_rtos
+		 */
+		template <typename Index, typename T, typename Map, typename Reduce>
+		T
+		parallelReduce(TaskPool& pool, Index begin, Index end, Index grain,
+				const T& identity, const Map& map, const Reduce& reduce);
+	}
+}
+
+#include "task_pool_impl.hpp"
+
+#endif // XPCC_BOOST__TASK_POOL_HPP
@@ -0,0 +1,181 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_BOOST__TASK_POOL_HPP
+#	error "Don't include this file directly, use <xpcc/processing/rtos/task_pool.hpp>"
+#endif
+
+// ----------------------------------------------------------------------------
+template <typename T>
+template <typename Function>
+void
+xpcc::rtos::task_pool::State<T>::execute(Function& function)
+{
+	try {
+		value = function();
+	}
+	catch (...) {
+		setReady(std::current_exception());
+		return;
+	}
+	setReady(std::exception_ptr());
+}
+
+template <typename T>
+T
+xpcc::rtos::task_pool::State<T>::get() const
+{
+	rethrow();
+	return *value;
+}
+
+template <typename Function>
+void
+xpcc::rtos::task_pool::State<void>::execute(Function& function)
+{
+	try {
+		function();
+	}
+	catch (...) {
+		setReady(std::current_exception());
+		return;
+	}
+	setReady(std::exception_ptr());
+}
+
+inline void
+xpcc::rtos::task_pool::State<void>::get() const
+{
+	rethrow();
+}
+
+// ----------------------------------------------------------------------------
+template <typename T>
+void
+xpcc::rtos::Future<T>::wait() const
+{
+	// help the pool instead of blocking a worker
+	while (not state->isReady())
+	{
+		if (not pool->runPendingTask()) {
+			state->wait();
+		}
+	}
+}
+
+template <typename T>
+T
+xpcc::rtos::Future<T>::get() const
+{
+	wait();
+	return state->get();
+}
+
+// ----------------------------------------------------------------------------
+template <typename Function>
+xpcc::rtos::Future< typename std::result_of<Function()>::type >
+xpcc::rtos::TaskPool::submit(const Function& function)
+{
+	typedef typename std::result_of<Function()>::type Result;
+
+	boost::shared_ptr< task_pool::State<Result> > state(
+			new task_pool::State<Result>());
+	enqueue(new task_pool::FunctionTask<Result, Function>(function, state));
+
+	return Future<Result>(this, state);
+}
+
+// ----------------------------------------------------------------------------
+template <typename Index, typename Function>
+void
+xpcc::rtos::parallelFor(TaskPool& pool, Index begin, Index end, Index grain,
+		const Function& function)
+{
+	if (not (begin < end)) {
+		return;
+	}
+	if (grain < Index(1)) {
+		grain = 1;
+	}
+
+	if (end - begin <= grain)
+	{
+		for (Index i = begin; i < end; ++i) {
+			function(i);
+		}
+		return;
+	}
+
+	const Index middle = begin + (end - begin) / 2;
+	Future<void> upper = pool.submit(
+		[&pool, middle, end, grain, &function]() {
+			parallelFor(pool, middle, end, grain, function);
+		});
+
+	try {
+		parallelFor(pool, begin, middle, grain, function);
+	}
+	catch (...) {
+		// the upper half still references `function`
+		upper.wait();
+		throw;
+	}
+	upper.get();
+}
+
+template <typename Index, typename Function>
+void
+xpcc::rtos::parallelFor(TaskPool& pool, Index begin, Index end,
+		const Function& function)
+{
+	Index grain = 1;
+	if (begin < end) {
+		grain = (end - begin) / Index(pool.getWorkerCount() * 8);
+	}
+	parallelFor(pool, begin, end, grain, function);
+}
+
+// ----------------------------------------------------------------------------
+template <typename Index, typename T, typename Map, typename Reduce>
+T
+xpcc::rtos::parallelReduce(TaskPool& pool, Index begin, Index end, Index grain,
+		const T& identity, const Map& map, const Reduce& reduce)
+{
+	if (not (begin < end)) {
+		return identity;
+	}
+	if (grain < Index(1)) {
+		grain = 1;
+	}
+
+	if (end - begin <= grain)
+	{
+		T result = identity;
+		for (Index i = begin; i < end; ++i) {
+			result = reduce(result, map(i));
+		}
+		return result;
+	}
+
+	const Index middle = begin + (end - begin) / 2;
+	Future<T> upper = pool.submit(
+		[&pool, middle, end, grain, &identity, &map, &reduce]() {
+			return parallelReduce(pool, middle, end, grain, identity, map, reduce);
+		});
+
+	T lower(identity);
+	try {
+		lower = parallelReduce(pool, begin, middle, grain, identity, map, reduce);
+	}
+	catch (...) {
+		upper.wait();
+		throw;
+	}
+	return reduce(lower, upper.get());
+}
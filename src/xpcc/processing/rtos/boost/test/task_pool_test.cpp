@@ -0,0 +1,152 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <xpcc/processing/rtos/task_pool.hpp>
+
+#include "task_pool_test.hpp"
+
+using xpcc::rtos::Future;
+using xpcc::rtos::TaskPool;
+
+namespace
+{
+	int
+	fibonacci(TaskPool& pool, int n)
+	{
+		if (n < 2) {
+			return n;
+		}
+		Future<int> a = pool.submit([&pool, n]() { return fibonacci(pool, n - 1); });
+		int b = fibonacci(pool, n - 2);
+		return a.get() + b;
+	}
+}
+
+// ----------------------------------------------------------------------------
+void
+TaskPoolTest::testSubmit()
+{
+	TaskPool pool(2);
+	TEST_ASSERT_EQUALS(pool.getWorkerCount(), 2U);
+	TEST_ASSERT_FALSE(pool.isWorkerThread());
+
+	Future<int> invalid;
+	TEST_ASSERT_FALSE(invalid.isValid());
+
+	std::vector< Future<int> > results;
+	for (int i = 0; i < 100; ++i) {
+		results.push_back(pool.submit([i]() { return i * i; }));
+	}
+
+	std::atomic<int> calls(0);
+	Future<void> done = pool.submit([&calls]() { calls++; });
+
+	for (int i = 0; i < 100; ++i)
+	{
+		TEST_ASSERT_TRUE(results[i].isValid());
+		TEST_ASSERT_EQUALS(results[i].get(), i * i);
+		TEST_ASSERT_TRUE(results[i].isReady());
+	}
+	done.get();
+	TEST_ASSERT_EQUALS(calls.load(), 1);
+
+	// the result can be read several times
+	TEST_ASSERT_EQUALS(results[7].get(), 49);
+}
+
+void
+TaskPoolTest::testException()
+{
+	TaskPool pool(2);
+
+	Future<int> result = pool.submit([]() -> int { throw 42; });
+
+	int caught = 0;
+	try {
+		result.get();
+	}
+	catch (int e) {
+		caught = e;
+	}
+	TEST_ASSERT_EQUALS(caught, 42);
+}
+
+void
+TaskPoolTest::testNested()
+{
+	// waiting workers execute other tasks, so even a single worker
+	// must not deadlock on recursively spawned tasks
+	TaskPool single(1);
+	TEST_ASSERT_EQUALS(fibonacci(single, 15), 610);
+
+	TaskPool pool(4);
+	Future<int> result = pool.submit([&pool]() { return fibonacci(pool, 18); });
+	TEST_ASSERT_EQUALS(result.get(), 2584);
+}
+
+void
+TaskPoolTest::testParallelFor()
+{
+	TaskPool pool(4);
+
+	std::vector< std::atomic<int> > visits(1000);
+	for (std::size_t i = 0; i < visits.size(); ++i) {
+		visits[i] = 0;
+	}
+
+	xpcc::rtos::parallelFor(pool, 0, 1000, 7, [&visits](int i) { visits[i]++; });
+
+	bool once = true;
+	for (std::size_t i = 0; i < visits.size(); ++i) {
+		once = once and (visits[i] == 1);
+	}
+	TEST_ASSERT_TRUE(once);
+
+	// automatic grain size
+	xpcc::rtos::parallelFor(pool, std::size_t(0), visits.size(),
+			[&visits](std::size_t i) { visits[i]++; });
+
+	bool twice = true;
+	for (std::size_t i = 0; i < visits.size(); ++i) {
+		twice = twice and (visits[i] == 2);
+	}
+	TEST_ASSERT_TRUE(twice);
+
+	// empty ranges do nothing
+	std::atomic<int> calls(0);
+	xpcc::rtos::parallelFor(pool, 5, 5, 1, [&calls](int) { calls++; });
+	xpcc::rtos::parallelFor(pool, 5, 2, [&calls](int) { calls++; });
+	TEST_ASSERT_EQUALS(calls.load(), 0);
+}
+
+void
+TaskPoolTest::testParallelReduce()
+{
+	TaskPool pool(3);
+
+	uint64_t sum = xpcc::rtos::parallelReduce(pool, 0, 10000, 64, uint64_t(0),
+			[](int i) { return uint64_t(i); },
+			[](uint64_t a, uint64_t b) { return a + b; });
+	TEST_ASSERT_EQUALS(sum, uint64_t(49995000));
+
+	// the order of the operands is kept
+	std::string text = xpcc::rtos::parallelReduce(pool, 0, 26, 2, std::string(),
+			[](int i) { return std::string(1, char('a' + i)); },
+			[](const std::string& a, const std::string& b) { return a + b; });
+	TEST_ASSERT_TRUE(text == "abcdefghijklmnopqrstuvwxyz");
+
+	int empty = xpcc::rtos::parallelReduce(pool, 0, 0, 1, -1,
+			[](int i) { return i; },
+			[](int a, int b) { return a + b; });
+	TEST_ASSERT_EQUALS(empty, -1);
+}
@@ -0,0 +1,19 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_RTOS__TASK_POOL_HPP
+#define XPCC_RTOS__TASK_POOL_HPP
+
+#include <xpcc/architecture/utils.hpp>
+
+#ifdef XPCC__OS_HOSTED
+#	include "boost/task_pool.hpp"
+#endif
+
+#endif // XPCC_RTOS__TASK_POOL_HPP
@@ -0,0 +1,158 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include "delta_scheduler.hpp"
+
+const int8_t xpcc::DeltaScheduler::highestBit[16] =
+{
+	-1, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3
+};
+
+// ----------------------------------------------------------------------------
+xpcc::DeltaScheduler::DeltaScheduler() :
+	dueList(0), readyMask(0), currentPriority(-1)
+{
+	for (uint_fast8_t i = 0; i < PriorityLevels; ++i)
+	{
+		readyHead[i] = 0;
+		readyTail[i] = 0;
+	}
+}
+
+xpcc::DeltaScheduler::~DeltaScheduler()
+{
+	while (dueList != 0)
+	{
+		TaskListItem *item = dueList;
+		dueList = item->nextDue;
+		delete item;
+	}
+}
+
+// ----------------------------------------------------------------------------
+bool
+xpcc::DeltaScheduler::scheduleTask(Task& task,
+		uint16_t period,
+		Priority priority)
+{
+	if (period == 0) {
+		return false;
+	}
+
+	xpcc::atomic::Lock lock;
+
+	for (TaskListItem *item = dueList; item != 0; item = item->nextDue)
+	{
+		if (&item->task == &task) {
+			return false;
+		}
+	}
+
+	insertDue(new TaskListItem(task, period, priority >> 4), period);
+	return true;
+}
+
+bool
+xpcc::DeltaScheduler::removeTask(const Task& task)
+{
+	xpcc::atomic::Lock lock;
+
+	TaskListItem *item = removeDue(task);
+	if (item == 0) {
+		return false;
+	}
+
+	if (item->ready) {
+		removeReady(item);
+	}
+	delete item;
+
+	return true;
+}
+
+bool
+xpcc::DeltaScheduler::rescheduleTask(const Task& task, uint16_t period)
+{
+	if (period == 0) {
+		return false;
+	}
+
+	xpcc::atomic::Lock lock;
+
+	TaskListItem *item = removeDue(task);
+	if (item == 0) {
+		return false;
+	}
+
+	item->period = period;
+	insertDue(item, period);
+
+	return true;
+}
+
+void
+xpcc::DeltaScheduler::schedule()
+{
+	this->scheduleInterupt();
+}
+
+// ----------------------------------------------------------------------------
+xpcc::DeltaScheduler::TaskListItem *
+xpcc::DeltaScheduler::removeDue(const Task& task)
+{
+	TaskListItem **link = &dueList;
+	while (*link != 0)
+	{
+		TaskListItem *item = *link;
+		if (&item->task == &task)
+		{
+			// the successor inherits the remaining ticks
+			if (item->nextDue != 0) {
+				item->nextDue->delta += item->delta;
+			}
+			*link = item->nextDue;
+			return item;
+		}
+		link = &item->nextDue;
+	}
+	return 0;
+}
+
+void
+xpcc::DeltaScheduler::removeReady(TaskListItem *item)
+{
+	const uint8_t priority = item->priority;
+
+	TaskListItem *previous = 0;
+	TaskListItem *list = readyHead[priority];
+	while (list != 0)
+	{
+		if (list == item)
+		{
+			if (previous == 0) {
+				readyHead[priority] = item->nextReady;
+			}
+			else {
+				previous->nextReady = item->nextReady;
+			}
+
+			if (readyTail[priority] == item) {
+				readyTail[priority] = previous;
+			}
+			break;
+		}
+		previous = list;
+		list = list->nextReady;
+	}
+
+	if (readyHead[priority] == 0) {
+		readyMask &= ~(1 << priority);
+	}
+	item->ready = false;
+}
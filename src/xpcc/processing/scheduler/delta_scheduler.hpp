@@ -0,0 +1,170 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC__DELTA_SCHEDULER_HPP
+#define XPCC__DELTA_SCHEDULER_HPP
+
+#include <stdint.h>
+
+#include "scheduler.hpp"
+
+namespace xpcc
+{
+	/**
+	 * \ingroup	processing
+	 * \brief	%Scheduler which only touches the tasks that are due
+	 *
+	 * Drop-in replacement for xpcc::Scheduler for a large number of tasks.
+	 *
+	 * xpcc::Scheduler decrements the counter of every task on every tick
+	 * and inserts ready tasks into a priority sorted list. This scheduler
+	 * keeps the tasks in a delta list instead: every entry stores the number
+	 * of ticks relative to its predecessor, so a tick only decrements the
+	 * first entry and removes the entries which became due.
+	 *
+	 * Ready tasks are queued per priority level, a bitmap of the non-empty
+	 * levels is used to find the task with the highest priority in
+	 * constant time. The priorities 0 to 255 of xpcc::Scheduler are mapped
+	 * onto 16 levels, i.e. priorities which only differ in the lower four
+	 * bits are equal. Tasks with the same level are executed in the
+	 * order in which they became ready.
+	 *
+	 * Tasks can be removed or rescheduled at any time, also from within
+	 * another task.
+	 *
+	 * \code
+	 * xpcc::DeltaScheduler scheduler;
+	 *
+	 * scheduler.scheduleTask(controlTask, 1, 200);	// every tick
+	 * scheduler.scheduleTask(sensorTask, 10, 150);
+	 * scheduler.scheduleTask(displayTask, 100);
+	 *
+	 * // 1 kHz timer interrupt
+	 * XPCC_ISR(TIMER0_COMPA)
+	 * {
+	 *     scheduler.scheduleInterupt();
+	 * }
+	 * \endcode
+	 *
+	 * \see		xpcc::Scheduler
+	 */
+	class DeltaScheduler
+	{
+	public:
+		typedef uint8_t Priority;
+		typedef Scheduler::Task Task;
+
+		/// Number of priority levels, a level contains 16 priorities
+		static constexpr uint8_t PriorityLevels = 16;
+
+	public:
+		DeltaScheduler();
+
+		~DeltaScheduler();
+
+		/**
+		 * Add a task.
+		 *
+		 * \param	period		Time between two executions in ticks,
+		 * 						the first execution is after one period.
+		 * \param	priority	Higher values are executed first, see above
+		 *
+		 * \return	`false` if the period is invalid or if the task was
+		 * 			already added.
+		 */
+		bool
+		scheduleTask(Task& task,
+					 uint16_t period,
+					 Priority priority = 127);
+
+		/**
+		 * Remove a task.
+		 *
+		 * If the task is currently executed it is finished but not called
+		 * again.
+		 *
+		 * \return	`false` if the task was not found
+		 */
+		bool
+		removeTask(const Task& task);
+
+		/**
+		 * Change the period of a task.
+		 *
+		 * The next execution happens one new period from now.
+		 *
+		 * \return	`false` if the task was not found or the period is zero
+		 */
+		bool
+		rescheduleTask(const Task& task, uint16_t period);
+
+		void
+		schedule();
+
+		xpcc_always_inline void
+		scheduleInterupt();
+
+	private:
+		struct TaskListItem
+		{
+			TaskListItem(Task& task,
+						 uint16_t period,
+						 uint8_t priority) :
+				nextDue(0), nextReady(0), task(task),
+				period(period), delta(0), priority(priority),
+				ready(false)
+			{
+			}
+
+			TaskListItem *nextDue;
+			TaskListItem *nextReady;
+
+			Task& task;
+			uint16_t period;
+
+			/// Ticks until this task is due, relative to the previous entry
+			uint16_t delta;
+			uint8_t priority;	///< level, not the priority of scheduleTask()
+			bool ready;
+		};
+
+		/// Insert into the delta list, due in `time` ticks
+		xpcc_always_inline void
+		insertDue(TaskListItem *item, uint16_t time);
+
+		/// Remove from the delta list, returns `0` if the task was not found
+		TaskListItem *
+		removeDue(const Task& task);
+
+		xpcc_always_inline void
+		pushReady(TaskListItem *item);
+
+		void
+		removeReady(TaskListItem *item);
+
+		/// Highest priority level with a ready task, `-1` if none
+		static xpcc_always_inline int8_t
+		getHighestReadyPriority(uint16_t mask);
+
+	private:
+		TaskListItem *dueList;
+
+		TaskListItem *readyHead[PriorityLevels];
+		TaskListItem *readyTail[PriorityLevels];
+		uint16_t readyMask;
+
+		int8_t currentPriority;
+
+		static const int8_t highestBit[16];
+	};
+}
+
+#include "delta_scheduler_impl.hpp"
+
+#endif // XPCC__DELTA_SCHEDULER_HPP
@@ -0,0 +1,115 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC__DELTA_SCHEDULER_HPP
+	#error	"Don't include this file directly, use 'delta_scheduler.hpp' instead!"
+#endif
+
+inline int8_t
+xpcc::DeltaScheduler::getHighestReadyPriority(uint16_t mask)
+{
+	if (mask & 0xff00)
+	{
+		if (mask & 0xf000) {
+			return 12 + highestBit[mask >> 12];
+		}
+		return 8 + highestBit[(mask >> 8) & 0x0f];
+	}
+	if (mask & 0x00f0) {
+		return 4 + highestBit[(mask >> 4) & 0x0f];
+	}
+	return highestBit[mask & 0x0f];
+}
+
+inline void
+xpcc::DeltaScheduler::insertDue(TaskListItem *item, uint16_t time)
+{
+	// tasks with the same due time stay in the order they were added
+	TaskListItem **link = &dueList;
+	while ((*link != 0) && ((*link)->delta <= time))
+	{
+		time -= (*link)->delta;
+		link = &(*link)->nextDue;
+	}
+
+	item->delta = time;
+	item->nextDue = *link;
+	if (*link != 0) {
+		(*link)->delta -= time;
+	}
+	*link = item;
+}
+
+inline void
+xpcc::DeltaScheduler::pushReady(TaskListItem *item)
+{
+	const uint8_t priority = item->priority;
+
+	item->nextReady = 0;
+	item->ready = true;
+	if (readyHead[priority] == 0) {
+		readyHead[priority] = item;
+	}
+	else {
+		readyTail[priority]->nextReady = item;
+	}
+	readyTail[priority] = item;
+	readyMask |= (1 << priority);
+}
+
+// ----------------------------------------------------------------------------
+inline void
+xpcc::DeltaScheduler::scheduleInterupt()
+{
+	// only the first entry of the delta list has to be updated
+	if (dueList != 0)
+	{
+		dueList->delta--;
+		while ((dueList != 0) && (dueList->delta == 0))
+		{
+			TaskListItem *item = dueList;
+			dueList = item->nextDue;
+
+			// a task which is still waiting for its execution is not
+			// queued a second time
+			if (!item->ready) {
+				pushReady(item);
+			}
+			insertDue(item, item->period);
+		}
+	}
+
+	// now execute the tasks which are ready
+	int8_t priority;
+	while ((priority = getHighestReadyPriority(
+				xpcc::accessor::asVolatile(readyMask))) > currentPriority)
+	{
+		TaskListItem *item = readyHead[priority];
+		readyHead[priority] = item->nextReady;
+		if (readyHead[priority] == 0) {
+			readyMask &= ~(1 << priority);
+		}
+		item->ready = false;
+
+		// The item may be removed while the task is running, therefore
+		// only the task itself is used from here on.
+		Task& task = item->task;
+
+		const int8_t previousPriority = currentPriority;
+		currentPriority = priority;
+		{
+			xpcc::atomic::Unlock unlock;
+
+			// the actual execution of the task happens with interrupts
+			// enabled
+			task.run();
+		}
+		currentPriority = previousPriority;
+	}
+}
@@ -36,6 +36,7 @@
 #include <xpcc/architecture/utils.hpp>
 #include <xpcc/architecture/driver/accessor.hpp>
 #include <xpcc/architecture/driver/atomic/lock.hpp>		// for Scheduler::scheduleInterrupt()
+#include <xpcc/processing/monitor/task_statistics.hpp>
 
 namespace xpcc
 {
@@ -50,8 +51,15 @@ namespace xpcc
 	 *
 	 * \image	html	scheduler.png
 	 *
+	 * Pass a xpcc::TaskStatistics object to scheduleTask() to record the
+	 * runtime, start jitter and overruns of a task. A task overruns if
+	 * its period ends while it is still waiting to be executed, this
+	 * period is then skipped instead of executing the task twice.
+	 *
 	 * \warning	Works for ATmega, but currently not for the ATxmega!
 	 *
+	 * \see		xpcc::DeltaScheduler for a large number of tasks
+	 *
 	 * \author	Fabian Greif
 	 * \todo	Check that this implementation works from inside an interrupt
 	 */
@@ -73,10 +81,15 @@ namespace xpcc
 	public:
 		Scheduler();
 
+		/**
+		 * \param	statistics	records runtime and overruns of the task,
+		 * 						may be `0`
+		 */
 		void
 		scheduleTask(Task& task,
 					 uint16_t period,
-					 Priority priority = 127);
+					 Priority priority = 127,
+					 TaskStatistics *statistics = 0);
 
 		// TODO	Implement this function
 		/*bool
@@ -93,10 +106,11 @@ namespace xpcc
 		{
 			TaskListItem(Task& task,
 						 uint16_t period,
-						 Priority priority) :
+						 Priority priority,
+						 TaskStatistics *statistics) :
 				nextTask(0), nextReady(0), task(task),
 				period(period), time(period), priority(priority),
-				state(WAITING)
+				state(WAITING), statistics(statistics), releaseTime(0)
 			{
 			}
 
@@ -114,6 +128,9 @@ namespace xpcc
 				WAITING
 			} state;
 			/// @endcond
+
+			TaskStatistics *statistics;
+			TaskStatistics::Time releaseTime;
 		};
 
 		TaskListItem *taskList;
@@ -63,6 +63,21 @@ xpcc::Scheduler::scheduleInterupt()
 		if (item->time == 0) {
 			item->time = item->period;
 			
+			if (item->state != TaskListItem::WAITING)
+			{
+				// the task did not finish within its period
+				if (item->statistics != 0) {
+					item->statistics->recordMiss();
+				}
+				if (item->state == TaskListItem::READY) {
+					// already in the ready list, skip this period
+					continue;
+				}
+			}
+			if (item->statistics != 0) {
+				item->releaseTime = TaskStatistics::Counter::now();
+			}
+			
 			// add to ready list
 			if ((readyList == 0) ||
 				(readyList->priority < item->priority))
@@ -102,9 +117,21 @@ xpcc::Scheduler::scheduleInterupt()
 			
 			// the actual execution of the task happens with interrupts
 			// enabled
-			item->task.run();
+			TaskStatistics *statistics = item->statistics;
+			if (statistics != 0)
+			{
+				statistics->recordStart(TaskStatistics::Counter::elapsed(item->releaseTime));
+				TaskStatistics::Run run(*statistics);
+				item->task.run();
+			}
+			else {
+				item->task.run();
+			}
 		}
 		currentPriority = 0;
-		item->state = TaskListItem::WAITING;
+		if (item->state == TaskListItem::RUNNING) {
+			// otherwise released again while running
+			item->state = TaskListItem::WAITING;
+		}
 	}
 }
@@ -0,0 +1,221 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/processing/scheduler/delta_scheduler.hpp>
+
+#include "delta_scheduler_test.hpp"
+
+// ----------------------------------------------------------------------------
+namespace
+{
+	unsigned int count = 1;
+
+	class TestTask : public xpcc::Scheduler::Task
+	{
+	public:
+		TestTask() :
+			order(0), calls(0)
+		{
+		}
+
+		virtual void
+		run()
+		{
+			order = count;
+			count++;
+			calls++;
+		}
+
+		uint8_t order;
+		uint8_t calls;
+	};
+
+	class RemovingTask : public xpcc::Scheduler::Task
+	{
+	public:
+		RemovingTask(xpcc::DeltaScheduler& scheduler) :
+			scheduler(scheduler), calls(0)
+		{
+		}
+
+		virtual void
+		run()
+		{
+			calls++;
+			scheduler.removeTask(*this);
+		}
+
+		xpcc::DeltaScheduler& scheduler;
+		uint8_t calls;
+	};
+}
+
+// ----------------------------------------------------------------------------
+void
+DeltaSchedulerTest::testPriority()
+{
+	xpcc::DeltaScheduler scheduler;
+
+	TestTask task1;
+	TestTask task2;
+	TestTask task3;
+	TestTask task4;
+	TestTask task5;
+
+	count = 1;
+	TEST_ASSERT_TRUE(scheduler.scheduleTask(task1, 3, 20));
+	TEST_ASSERT_TRUE(scheduler.scheduleTask(task2, 3));
+	TEST_ASSERT_TRUE(scheduler.scheduleTask(task3, 3, 160));
+	TEST_ASSERT_TRUE(scheduler.scheduleTask(task4, 3, 255));
+	TEST_ASSERT_TRUE(scheduler.scheduleTask(task5, 3, 16));
+
+	scheduler.schedule();
+	scheduler.schedule();
+
+	TEST_ASSERT_EQUALS(task1.order, 0);
+	TEST_ASSERT_EQUALS(task4.order, 0);
+
+	scheduler.schedule();
+
+	TEST_ASSERT_EQUALS(task4.order, 1);
+	TEST_ASSERT_EQUALS(task3.order, 2);
+	TEST_ASSERT_EQUALS(task2.order, 3);
+	// same priority level => order in which the tasks were added
+	TEST_ASSERT_EQUALS(task1.order, 4);
+	TEST_ASSERT_EQUALS(task5.order, 5);
+
+	count = 1;
+	scheduler.schedule();
+	scheduler.schedule();
+	TEST_ASSERT_EQUALS(count, 1U);
+
+	scheduler.schedule();
+
+	TEST_ASSERT_EQUALS(task4.order, 1);
+	TEST_ASSERT_EQUALS(task3.order, 2);
+	TEST_ASSERT_EQUALS(task2.order, 3);
+	TEST_ASSERT_EQUALS(task1.order, 4);
+	TEST_ASSERT_EQUALS(task5.order, 5);
+}
+
+void
+DeltaSchedulerTest::testPeriods()
+{
+	xpcc::DeltaScheduler scheduler;
+
+	TestTask task1;
+	TestTask task2;
+	TestTask task3;
+	TestTask task4;
+
+	scheduler.scheduleTask(task1, 1);
+	scheduler.scheduleTask(task2, 7);
+	scheduler.scheduleTask(task3, 10);
+	scheduler.scheduleTask(task4, 25);
+
+	for (uint8_t i = 0; i < 100; ++i) {
+		scheduler.schedule();
+	}
+
+	TEST_ASSERT_EQUALS(task1.calls, 100);
+	TEST_ASSERT_EQUALS(task2.calls, 14);
+	TEST_ASSERT_EQUALS(task3.calls, 10);
+	TEST_ASSERT_EQUALS(task4.calls, 4);
+}
+
+void
+DeltaSchedulerTest::testRemove()
+{
+	xpcc::DeltaScheduler scheduler;
+
+	TestTask task1;
+	TestTask task2;
+	TestTask task3;
+	RemovingTask task4(scheduler);
+
+	scheduler.scheduleTask(task1, 2);
+	scheduler.scheduleTask(task2, 5);
+	scheduler.scheduleTask(task3, 7);
+	scheduler.scheduleTask(task4, 3);
+
+	TEST_ASSERT_TRUE(scheduler.removeTask(task2));
+	TEST_ASSERT_FALSE(scheduler.removeTask(task2));
+
+	for (uint8_t i = 0; i < 14; ++i) {
+		scheduler.schedule();
+	}
+
+	TEST_ASSERT_EQUALS(task1.calls, 7);
+	TEST_ASSERT_EQUALS(task2.calls, 0);
+	// the successor of the removed task must keep its due time
+	TEST_ASSERT_EQUALS(task3.calls, 2);
+	// removed itself during the first execution
+	TEST_ASSERT_EQUALS(task4.calls, 1);
+	TEST_ASSERT_FALSE(scheduler.removeTask(task4));
+
+	// task can be added again after it was removed
+	TEST_ASSERT_TRUE(scheduler.scheduleTask(task2, 1));
+	scheduler.schedule();
+	TEST_ASSERT_EQUALS(task2.calls, 1);
+}
+
+void
+DeltaSchedulerTest::testReschedule()
+{
+	xpcc::DeltaScheduler scheduler;
+
+	TestTask task1;
+	TestTask task2;
+
+	scheduler.scheduleTask(task1, 10);
+	scheduler.scheduleTask(task2, 4);
+
+	for (uint8_t i = 0; i < 5; ++i) {
+		scheduler.schedule();
+	}
+	TEST_ASSERT_EQUALS(task1.calls, 0);
+	TEST_ASSERT_EQUALS(task2.calls, 1);
+
+	// next execution two ticks from now
+	TEST_ASSERT_TRUE(scheduler.rescheduleTask(task1, 2));
+
+	scheduler.schedule();
+	TEST_ASSERT_EQUALS(task1.calls, 0);
+	scheduler.schedule();
+	TEST_ASSERT_EQUALS(task1.calls, 1);
+
+	// task2 was not affected
+	TEST_ASSERT_EQUALS(task2.calls, 1);
+	scheduler.schedule();
+	TEST_ASSERT_EQUALS(task2.calls, 2);
+
+	for (uint8_t i = 0; i < 10; ++i) {
+		scheduler.schedule();
+	}
+	TEST_ASSERT_EQUALS(task1.calls, 6);
+}
+
+void
+DeltaSchedulerTest::testInvalid()
+{
+	xpcc::DeltaScheduler scheduler;
+
+	TestTask task;
+
+	TEST_ASSERT_FALSE(scheduler.scheduleTask(task, 0));
+	TEST_ASSERT_FALSE(scheduler.rescheduleTask(task, 10));
+
+	TEST_ASSERT_TRUE(scheduler.scheduleTask(task, 10));
+	TEST_ASSERT_FALSE(scheduler.scheduleTask(task, 5));
+	TEST_ASSERT_FALSE(scheduler.rescheduleTask(task, 0));
+
+	// nothing to do, must not crash
+	xpcc::DeltaScheduler empty;
+	empty.schedule();
+}
@@ -107,3 +107,56 @@ SchedulerTest::testScheduler()
 	TEST_ASSERT_EQUALS(task3.order, 3);
 	TEST_ASSERT_EQUALS(task4.order, 1);
 }
+
+// ----------------------------------------------------------------------------
+
+class OverrunningTask : public xpcc::Scheduler::Task
+{
+public:
+	OverrunningTask(xpcc::Scheduler& scheduler) :
+		scheduler(scheduler), runs(0)
+	{
+	}
+	
+	virtual void
+	run()
+	{
+		runs++;
+		if (runs == 1)
+		{
+			// the first run takes longer than two periods
+			scheduler.schedule();
+			scheduler.schedule();
+		}
+	}
+	
+	xpcc::Scheduler& scheduler;
+	uint8_t runs;
+};
+
+void
+SchedulerTest::testStatistics()
+{
+	xpcc::Scheduler scheduler;
+	xpcc::TaskStatistics statistics;
+	xpcc::TaskStatistics overrunStatistics;
+	
+	TestTask task;
+	OverrunningTask overrunningTask(scheduler);
+	
+	scheduler.scheduleTask(task, 2, 10, &statistics);
+	scheduler.scheduleTask(overrunningTask, 1, 100, &overrunStatistics);
+	
+	for (uint8_t i = 0; i < 4; ++i) {
+		scheduler.schedule();
+	}
+	
+	// the missed period is executed once after the first run
+	TEST_ASSERT_EQUALS(overrunningTask.runs, 5);
+	TEST_ASSERT_EQUALS(overrunStatistics.getRuns(), 5U);
+	TEST_ASSERT_EQUALS(overrunStatistics.getOverruns(), 2U);
+	TEST_ASSERT_TRUE(overrunStatistics.getWorstCaseTime() >= overrunStatistics.getAverageTime());
+	
+	TEST_ASSERT_EQUALS(statistics.getRuns(), 3U);
+	TEST_ASSERT_EQUALS(statistics.getOverruns(), 0U);
+}
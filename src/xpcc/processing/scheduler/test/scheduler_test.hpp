@@ -35,4 +35,7 @@ class SchedulerTest : public unittest::TestSuite
 public:
 	void
 	testScheduler();
+	
+	void
+	testStatistics();
 };
@@ -11,6 +11,7 @@
 #define XPCC_PERIODIC_TIMER_HPP
 
 #include "timeout.hpp"
+#include <xpcc/processing/monitor/task_statistics.hpp>
 
 namespace xpcc
 {
@@ -25,6 +26,21 @@ PeriodicTimerState : uint8_t
 	Armed  = 0b100,
 };
 
+/// Handling of periods missed while `execute()` was not called
+/// @ingroup	software_timer
+enum class
+PeriodicTimerPolicy : uint8_t
+{
+	/// Return `true` once, missed periods are discarded
+	Skip = 0,
+	/// Return `true` once for every period, missed periods are handled
+	/// by the following calls to `execute()`
+	CatchUp = 1,
+	/// Return `true` once, `getElapsedPeriods()` tells how many periods
+	/// have to be processed
+	Batch = 2,
+};
+
 /**
  * Generic software timeout class for variable timebase and timestamp width.
  *
@@ -72,8 +88,36 @@ Remaining:     +    |0|   +   |     -     |0|  +  | -|  + |0| +| -  |0|+| 0
  * Instead, `execute()` returns `true` once and then reschedules itself
  * for the next period, without any period skewing.
  *
+ * This behavior can be changed with a PeriodicTimerPolicy:
+ *
+ * - `Skip` (default) discards the missed periods as described above.
+ * - `CatchUp` returns `true` on as many consecutive calls as periods have
+ *   elapsed, so that no execution is lost.
+ * - `Batch` returns `true` once and leaves it to the caller to process all
+ *   elapsed periods at once, e.g. to integrate a control loop over the
+ *   correct time span:
+ *
+ * @code
+ * xpcc::PeriodicTimer timer(10, xpcc::PeriodicTimerPolicy::Batch);
+ *
+ * if (timer.execute())
+ * {
+ *     filter.update(sample, timer.getElapsedPeriods() * 10);
+ * }
+ * @endcode
+ *
+ * With every policy the timer is re-armed relative to the original
+ * schedule, never relative to the time `execute()` was called, so the
+ * expirations stay at integer multiples of the period.
+ * `getElapsedPeriods()` returns the number of periods covered by the last
+ * call which returned `true`, independent of the policy.
+ *
  * @warning	Never use this class when a precise timebase is needed!
  *
+ * Attach a xpcc::TaskStatistics object with `setStatistics()` to record
+ * how late `execute()` was called after the expiration (start jitter) and
+ * how many periods were skipped (overruns).
+ *
  * Notice, that the `PeriodicTimerState::Expired` is reset to
  * `PeriodicTimerState::Armed` only after `execute()` has returned `true`.
  * This is different to the behavior of GenericTimeout, where calls to
@@ -99,7 +143,8 @@ class GenericPeriodicTimer
 {
 public:
 	/// Create and start the timer
-	GenericPeriodicTimer(const TimestampType period);
+	GenericPeriodicTimer(const TimestampType period,
+			PeriodicTimerPolicy policy = PeriodicTimerPolicy::Skip);
 
 	/// Restart the timer with the current period.
 	inline void
@@ -114,10 +159,23 @@ public:
 	stop();
 
 
-	/// @return `true` exactly once during each period
+	/// @return `true` exactly once during each period, or once for each
+	/// elapsed period with PeriodicTimerPolicy::CatchUp
 	bool
 	execute();
 
+	/// @return the number of periods handled by the last call to `execute()`
+	/// which returned `true`, `0` after (re-)starting the timer
+	inline uint32_t
+	getElapsedPeriods() const;
+
+
+	inline void
+	setPolicy(PeriodicTimerPolicy policy);
+
+	inline PeriodicTimerPolicy
+	getPolicy() const;
+
 
 	/// @return the time until (positive time) or since (negative time) expiration, or 0 if stopped
 	inline typename TimestampType::SignedType
@@ -132,9 +190,31 @@ public:
 	inline bool
 	isStopped() const;
 
+
+	/// Record start jitter and skipped periods, `0` to disable
+	inline void
+	setStatistics(TaskStatistics *statistics);
+
+	inline TaskStatistics *
+	getStatistics() const;
+
+private:
+	static inline TaskStatistics::Time
+	toTicks(typename TimestampType::Type time, const void *);
+
+	static inline TaskStatistics::Time
+	toTicks(typename TimestampType::Type time, const PreciseClock *);
+
 private:
 	TimestampType period;
 	GenericTimeout<Clock, TimestampType> timeout;
+	TaskStatistics *statistics;
+	uint32_t elapsedPeriods;
+	PeriodicTimerPolicy policy;
+
+	template< class C, class T, std::size_t N >
+	friend class
+	GenericTimerRegistry;
 };
 
 /**
@@ -157,6 +237,10 @@ using ShortPeriodicTimer = GenericPeriodicTimer< ::xpcc::Clock, ShortTimestamp>;
 /// @ingroup	software_timer
 using PeriodicTimer      = GenericPeriodicTimer< ::xpcc::Clock, Timestamp>;
 
+/// Periodic software timer for up to 35 minutes with microsecond resolution.
+/// @ingroup	software_timer
+using PrecisePeriodicTimer = GenericPeriodicTimer< ::xpcc::PreciseClock, PreciseTimestamp>;
+
 }	// namespace
 
 #include "periodic_timer_impl.hpp"
@@ -12,8 +12,9 @@
 #endif
 
 template< class Clock , typename TimestampType >
-xpcc::GenericPeriodicTimer<Clock, TimestampType>::GenericPeriodicTimer(const TimestampType period) :
-	period(period), timeout(period)
+xpcc::GenericPeriodicTimer<Clock, TimestampType>::GenericPeriodicTimer(const TimestampType period,
+		PeriodicTimerPolicy policy) :
+	period(period), timeout(period), statistics(0), elapsedPeriods(0), policy(policy)
 {
 }
 
@@ -22,6 +23,7 @@ void
 xpcc::GenericPeriodicTimer<Clock, TimestampType>::restart()
 {
 	timeout.restart(period);
+	elapsedPeriods = 0;
 }
 
 template< class Clock , typename TimestampType >
@@ -59,20 +61,56 @@ xpcc::GenericPeriodicTimer<Clock, TimestampType>::execute()
 {
 	if (timeout.execute())
 	{
-		TimestampType now = Clock::template now<TimestampType>();
+		const TimestampType now = Clock::template now<TimestampType>();
+		const TimestampType expiration = timeout.endTime;
+		uint32_t periods = 1;
 
-		do
+		if (policy != PeriodicTimerPolicy::CatchUp and period.getTime() != 0)
 		{
-			timeout.endTime = timeout.endTime + period;
+			// all periods which have expired until now, the next expiration
+			// stays in phase with the original schedule
+			periods += (now - expiration).getTime() / period.getTime();
 		}
-		while(timeout.endTime <= now);
 
+		timeout.endTime = expiration + TimestampType(
+				typename TimestampType::Type(period.getTime() * periods));
 		timeout.state = timeout.ARMED;
+		elapsedPeriods = periods;
+
+		if (statistics != 0)
+		{
+			statistics->recordStart(toTicks((now - expiration).getTime(),
+					static_cast<const Clock *>(0)));
+			if (periods > 1 and policy == PeriodicTimerPolicy::Skip) {
+				statistics->recordMiss(periods - 1);
+			}
+		}
 		return true;
 	}
 	return false;
 }
 
+template< class Clock, class TimestampType >
+uint32_t
+xpcc::GenericPeriodicTimer<Clock, TimestampType>::getElapsedPeriods() const
+{
+	return elapsedPeriods;
+}
+
+template< class Clock, class TimestampType >
+void
+xpcc::GenericPeriodicTimer<Clock, TimestampType>::setPolicy(PeriodicTimerPolicy policy)
+{
+	this->policy = policy;
+}
+
+template< class Clock, class TimestampType >
+xpcc::PeriodicTimerPolicy
+xpcc::GenericPeriodicTimer<Clock, TimestampType>::getPolicy() const
+{
+	return policy;
+}
+
 template< class Clock, class TimestampType >
 typename TimestampType::SignedType
 xpcc::GenericPeriodicTimer<Clock, TimestampType>::remaining() const
@@ -80,3 +118,30 @@ xpcc::GenericPeriodicTimer<Clock, TimestampType>::remaining() const
 	return timeout.remaining();
 }
 
+template< class Clock, class TimestampType >
+void
+xpcc::GenericPeriodicTimer<Clock, TimestampType>::setStatistics(TaskStatistics *statistics)
+{
+	this->statistics = statistics;
+}
+
+template< class Clock, class TimestampType >
+xpcc::TaskStatistics *
+xpcc::GenericPeriodicTimer<Clock, TimestampType>::getStatistics() const
+{
+	return statistics;
+}
+
+template< class Clock, class TimestampType >
+xpcc::TaskStatistics::Time
+xpcc::GenericPeriodicTimer<Clock, TimestampType>::toTicks(typename TimestampType::Type time, const void *)
+{
+	return TaskStatistics::fromMilliseconds(time);
+}
+
+template< class Clock, class TimestampType >
+xpcc::TaskStatistics::Time
+xpcc::GenericPeriodicTimer<Clock, TimestampType>::toTicks(typename TimestampType::Type time, const PreciseClock *)
+{
+	return TaskStatistics::fromMicroseconds(time);
+}
@@ -222,3 +222,113 @@ PeriodicTimerTest::testRestart()
 	TEST_ASSERT_TRUE(timer.execute());
 	TEST_ASSERT_FALSE(timer.execute());
 }
+
+void
+PeriodicTimerTest::testStatistics()
+{
+	xpcc::GenericPeriodicTimer<xpcc::ClockDummy, xpcc::Timestamp> timer(10);
+	xpcc::TaskStatistics statistics;
+
+	TEST_ASSERT_TRUE(timer.getStatistics() == 0);
+	timer.setStatistics(&statistics);
+	TEST_ASSERT_TRUE(timer.getStatistics() == &statistics);
+
+	xpcc::ClockDummy::setTime(10);
+	TEST_ASSERT_TRUE(timer.execute());
+	TEST_ASSERT_EQUALS(statistics.getRuns(), 1U);
+	TEST_ASSERT_EQUALS(statistics.getOverruns(), 0U);
+	TEST_ASSERT_EQUALS(statistics.getLastJitter(), 0U);
+
+	// called 3ms late
+	xpcc::ClockDummy::setTime(23);
+	TEST_ASSERT_TRUE(timer.execute());
+	TEST_ASSERT_EQUALS(statistics.getRuns(), 2U);
+	TEST_ASSERT_EQUALS(statistics.getOverruns(), 0U);
+	TEST_ASSERT_EQUALS(statistics.getLastJitter(), xpcc::TaskStatistics::fromMilliseconds(3));
+
+	// the periods ending at 40 and 50 are skipped
+	xpcc::ClockDummy::setTime(55);
+	TEST_ASSERT_TRUE(timer.execute());
+	TEST_ASSERT_EQUALS(statistics.getRuns(), 3U);
+	TEST_ASSERT_EQUALS(statistics.getOverruns(), 2U);
+	TEST_ASSERT_EQUALS(statistics.getMaximumJitter(), xpcc::TaskStatistics::fromMilliseconds(25));
+	TEST_ASSERT_FALSE(timer.execute());
+
+	timer.setStatistics(0);
+	xpcc::ClockDummy::setTime(100);
+	TEST_ASSERT_TRUE(timer.execute());
+	TEST_ASSERT_EQUALS(statistics.getRuns(), 3U);
+}
+
+void
+PeriodicTimerTest::testPolicies()
+{
+	xpcc::GenericPeriodicTimer<xpcc::ClockDummy, xpcc::ShortTimestamp> skip(10);
+	xpcc::GenericPeriodicTimer<xpcc::ClockDummy, xpcc::Timestamp> catchUp(10,
+			xpcc::PeriodicTimerPolicy::CatchUp);
+	xpcc::GenericPeriodicTimer<xpcc::ClockDummy, xpcc::Timestamp> batch(10,
+			xpcc::PeriodicTimerPolicy::Batch);
+
+	TEST_ASSERT_TRUE(skip.getPolicy() == xpcc::PeriodicTimerPolicy::Skip);
+	TEST_ASSERT_TRUE(catchUp.getPolicy() == xpcc::PeriodicTimerPolicy::CatchUp);
+	TEST_ASSERT_EQUALS(batch.getElapsedPeriods(), 0U);
+
+	xpcc::ClockDummy::setTime(12);
+	TEST_ASSERT_TRUE(skip.execute());
+	TEST_ASSERT_TRUE(catchUp.execute());
+	TEST_ASSERT_TRUE(batch.execute());
+	TEST_ASSERT_EQUALS(skip.getElapsedPeriods(), 1U);
+	TEST_ASSERT_EQUALS(catchUp.getElapsedPeriods(), 1U);
+	TEST_ASSERT_EQUALS(batch.getElapsedPeriods(), 1U);
+
+	// the periods ending at 20, 30 and 40 are missed
+	xpcc::ClockDummy::setTime(47);
+	TEST_ASSERT_TRUE(skip.execute());
+	TEST_ASSERT_FALSE(skip.execute());
+	TEST_ASSERT_EQUALS(skip.getElapsedPeriods(), 3U);
+	TEST_ASSERT_EQUALS(skip.remaining(), 3l);
+
+	TEST_ASSERT_TRUE(batch.execute());
+	TEST_ASSERT_FALSE(batch.execute());
+	TEST_ASSERT_EQUALS(batch.getElapsedPeriods(), 3U);
+	TEST_ASSERT_EQUALS(batch.remaining(), 3l);
+
+	// every missed period is caught up, the schedule stays unchanged
+	TEST_ASSERT_TRUE(catchUp.execute());
+	TEST_ASSERT_EQUALS(catchUp.remaining(), -17l);
+	TEST_ASSERT_TRUE(catchUp.execute());
+	TEST_ASSERT_EQUALS(catchUp.remaining(), -7l);
+	TEST_ASSERT_TRUE(catchUp.execute());
+	TEST_ASSERT_EQUALS(catchUp.remaining(), 3l);
+	TEST_ASSERT_FALSE(catchUp.execute());
+	TEST_ASSERT_EQUALS(catchUp.getElapsedPeriods(), 1U);
+
+	// no drift over many late calls
+	for (int i = 5; i < 100; ++i)
+	{
+		xpcc::ClockDummy::setTime(i * 10 + 9);
+		TEST_ASSERT_TRUE(skip.execute());
+		TEST_ASSERT_TRUE(catchUp.execute());
+		TEST_ASSERT_TRUE(batch.execute());
+	}
+	TEST_ASSERT_EQUALS(skip.remaining(), 1l);
+	TEST_ASSERT_EQUALS(catchUp.remaining(), 1l);
+	TEST_ASSERT_EQUALS(batch.remaining(), 1l);
+
+	// missed periods are not counted as overruns, except when skipped
+	xpcc::TaskStatistics statistics;
+	batch.setStatistics(&statistics);
+	xpcc::ClockDummy::setTime(1050);
+	TEST_ASSERT_TRUE(batch.execute());
+	TEST_ASSERT_EQUALS(batch.getElapsedPeriods(), 6U);
+	TEST_ASSERT_EQUALS(statistics.getOverruns(), 0U);
+
+	batch.setPolicy(xpcc::PeriodicTimerPolicy::Skip);
+	xpcc::ClockDummy::setTime(1080);
+	TEST_ASSERT_TRUE(batch.execute());
+	TEST_ASSERT_EQUALS(batch.getElapsedPeriods(), 3U);
+	TEST_ASSERT_EQUALS(statistics.getOverruns(), 2U);
+
+	batch.restart();
+	TEST_ASSERT_EQUALS(batch.getElapsedPeriods(), 0U);
+}
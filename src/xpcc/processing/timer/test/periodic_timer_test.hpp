@@ -24,4 +24,10 @@ public:
 
 	void
 	testRestart();
+
+	void
+	testStatistics();
+
+	void
+	testPolicies();
 };
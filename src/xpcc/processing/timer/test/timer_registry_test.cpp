@@ -0,0 +1,170 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#include <xpcc/processing/timer.hpp>
+#include <xpcc/architecture/driver/clock_dummy.hpp>
+
+#ifdef XPCC__OS_HOSTED
+#	include <xpcc/architecture/driver/virtual_clock/virtual_clock.hpp>
+#endif
+
+#include "timer_registry_test.hpp"
+
+typedef xpcc::GenericTimeout<xpcc::ClockDummy, xpcc::Timestamp> Timeout;
+typedef xpcc::GenericTimeout<xpcc::ClockDummy, xpcc::ShortTimestamp> ShortTimeout;
+typedef xpcc::GenericPeriodicTimer<xpcc::ClockDummy, xpcc::Timestamp> PeriodicTimer;
+
+// ----------------------------------------------------------------------------
+void
+TimerRegistryTest::setUp()
+{
+	xpcc::ClockDummy::setTime(0);
+}
+
+void
+TimerRegistryTest::testJoinLeave()
+{
+	xpcc::GenericTimerRegistry<xpcc::ClockDummy, xpcc::Timestamp, 2> registry;
+	Timeout timeout1;
+	Timeout timeout2;
+	PeriodicTimer timer(10);
+
+	TEST_ASSERT_EQUALS(registry.getSize(), 0U);
+	TEST_ASSERT_EQUALS(registry.getMaxSize(), 2U);
+
+	TEST_ASSERT_TRUE(registry.join(timeout1));
+	TEST_ASSERT_FALSE(registry.join(timeout1));
+	TEST_ASSERT_TRUE(registry.join(timer));
+	TEST_ASSERT_FALSE(registry.join(timeout2));
+	TEST_ASSERT_EQUALS(registry.getSize(), 2U);
+
+	TEST_ASSERT_TRUE(registry.leave(timeout1));
+	TEST_ASSERT_FALSE(registry.leave(timeout1));
+	TEST_ASSERT_TRUE(registry.join(timeout2));
+
+	TEST_ASSERT_TRUE(registry.leave(timer));
+	TEST_ASSERT_TRUE(registry.leave(timeout2));
+	TEST_ASSERT_EQUALS(registry.getSize(), 0U);
+}
+
+void
+TimerRegistryTest::testNextDeadline()
+{
+	xpcc::GenericTimerRegistry<xpcc::ClockDummy, xpcc::Timestamp, 4> registry;
+	Timeout timeout1;
+	Timeout timeout2;
+	Timeout timeout3;
+
+	registry.join(timeout1);
+	registry.join(timeout2);
+	registry.join(timeout3);
+
+	xpcc::Timestamp deadline;
+	TEST_ASSERT_FALSE(registry.nextDeadline(deadline));
+
+	timeout1.restart(50);
+	timeout2.restart(20);
+	timeout3.restart(100);
+
+	TEST_ASSERT_TRUE(registry.nextDeadline(deadline));
+	TEST_ASSERT_EQUALS(deadline, xpcc::Timestamp(20));
+
+	// stopped timeouts are ignored
+	timeout2.stop();
+	TEST_ASSERT_TRUE(registry.nextDeadline(deadline));
+	TEST_ASSERT_EQUALS(deadline, xpcc::Timestamp(50));
+
+	// expired but not yet executed timeouts are still due
+	xpcc::ClockDummy::setTime(60);
+	TEST_ASSERT_TRUE(timeout1.isExpired());
+	TEST_ASSERT_TRUE(registry.nextDeadline(deadline));
+	TEST_ASSERT_EQUALS(deadline, xpcc::Timestamp(50));
+
+	TEST_ASSERT_TRUE(timeout1.execute());
+	TEST_ASSERT_TRUE(registry.nextDeadline(deadline));
+	TEST_ASSERT_EQUALS(deadline, xpcc::Timestamp(100));
+
+	timeout3.stop();
+	TEST_ASSERT_FALSE(registry.nextDeadline(deadline));
+}
+
+void
+TimerRegistryTest::testPeriodicTimer()
+{
+	xpcc::GenericTimerRegistry<xpcc::ClockDummy, xpcc::Timestamp, 4> registry;
+	PeriodicTimer timer(30);
+	Timeout timeout(45);
+
+	registry.join(timer);
+	registry.join(timeout);
+
+	xpcc::Timestamp deadline;
+	TEST_ASSERT_TRUE(registry.nextDeadline(deadline));
+	TEST_ASSERT_EQUALS(deadline, xpcc::Timestamp(30));
+
+	xpcc::ClockDummy::setTime(31);
+	TEST_ASSERT_TRUE(timer.execute());
+	TEST_ASSERT_TRUE(registry.nextDeadline(deadline));
+	TEST_ASSERT_EQUALS(deadline, xpcc::Timestamp(45));
+
+	xpcc::ClockDummy::setTime(46);
+	TEST_ASSERT_TRUE(timeout.execute());
+	TEST_ASSERT_TRUE(registry.nextDeadline(deadline));
+	TEST_ASSERT_EQUALS(deadline, xpcc::Timestamp(60));
+
+	// a timer which is already due must not sleep
+	xpcc::ClockDummy::setTime(70);
+	registry.sleep(1000);
+}
+
+void
+TimerRegistryTest::testTimeOverflow()
+{
+	xpcc::GenericTimerRegistry<xpcc::ClockDummy, xpcc::ShortTimestamp, 4> registry;
+
+	xpcc::ClockDummy::setTime(65500);
+	ShortTimeout timeout1(100);
+	ShortTimeout timeout2(20);
+
+	registry.join(timeout1);
+	registry.join(timeout2);
+
+	// deadline of timeout1 wraps around, but is still later
+	xpcc::ShortTimestamp deadline;
+	TEST_ASSERT_TRUE(registry.nextDeadline(deadline));
+	TEST_ASSERT_EQUALS(deadline, xpcc::ShortTimestamp(65520));
+
+	timeout2.stop();
+	TEST_ASSERT_TRUE(registry.nextDeadline(deadline));
+	TEST_ASSERT_EQUALS(deadline, xpcc::ShortTimestamp(64));
+}
+
+void
+TimerRegistryTest::testSleepMaximum()
+{
+#ifdef XPCC__OS_HOSTED
+	xpcc::GenericTimerRegistry<xpcc::ClockDummy, xpcc::ShortTimestamp, 2> registry;
+	xpcc::VirtualClock::enable(0);
+
+	// more than the signed range of the timestamp, sleeps as long as
+	// possible, the idle time advances the virtual clock
+	registry.sleep(xpcc::ShortTimestamp(50000));
+	TEST_ASSERT_EQUALS(xpcc::VirtualClock::now(), xpcc::Timestamp(32767));
+
+	registry.sleep(xpcc::ShortTimestamp(100));
+	TEST_ASSERT_EQUALS(xpcc::VirtualClock::now(), xpcc::Timestamp(32867));
+
+	xpcc::GenericTimerRegistry<xpcc::ClockDummy, xpcc::Timestamp, 2> longRegistry;
+	xpcc::VirtualClock::setTime(0);
+	longRegistry.sleep(xpcc::Timestamp(0xffffffff));
+	TEST_ASSERT_EQUALS(xpcc::VirtualClock::now(), xpcc::Timestamp(0x7fffffff));
+
+	xpcc::VirtualClock::disable();
+#endif
+}
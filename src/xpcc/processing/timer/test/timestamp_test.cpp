@@ -9,9 +9,14 @@
 
 #include <xpcc/processing/timer/timestamp.hpp>
 #include <xpcc/utils/arithmetic_traits.hpp>
+#include <xpcc/utils/template_metaprogramming.hpp>
 
 #include "timestamp_test.hpp"
 
+// milliseconds and microseconds must not be mixed
+static_assert(not xpcc::tmp::SameType<xpcc::Timestamp, xpcc::PreciseTimestamp>::value,
+		"Timestamp and PreciseTimestamp must be distinct types");
+
 // ----------------------------------------------------------------------------
 void
 TimestampTest::testConstructors()
@@ -10,7 +10,9 @@
 #ifndef XPCC_TIMEOUT_HPP
 #define XPCC_TIMEOUT_HPP
 
+#include <cstddef>
 #include <xpcc/architecture/driver/clock.hpp>
+#include <xpcc/architecture/driver/precise_clock.hpp>
 
 #include "timestamp.hpp"
 
@@ -31,6 +33,9 @@ TimeoutState : uint8_t
 template< class Clock, class TimestampType >
 class GenericPeriodicTimer;
 
+template< class Clock, class TimestampType, std::size_t N >
+class GenericTimerRegistry;
+
 /**
  * Generic software timeout class for variable timebase and timestamp width.
  *
@@ -165,6 +170,10 @@ private:
 
 	friend class
 	GenericPeriodicTimer<Clock, TimestampType>;
+
+	template< class C, class T, std::size_t N >
+	friend class
+	GenericTimerRegistry;
 };
 
 /**
@@ -186,6 +195,10 @@ using ShortTimeout = GenericTimeout< ::xpcc::Clock, ShortTimestamp>;
 /// @ingroup	software_timer
 using Timeout      = GenericTimeout< ::xpcc::Clock, Timestamp>;
 
+/// Software timeout for up to 35 minutes with microsecond resolution.
+/// @ingroup	software_timer
+using PreciseTimeout = GenericTimeout< ::xpcc::PreciseClock, PreciseTimestamp>;
+
 }	// namespace xpcc
 
 #include "timeout_impl.hpp"
@@ -0,0 +1,168 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_TIMER_REGISTRY_HPP
+#define XPCC_TIMER_REGISTRY_HPP
+
+#include <xpcc/architecture/driver/idle.hpp>
+#include <xpcc/utils/template_metaprogramming.hpp>
+
+#include "timeout.hpp"
+#include "periodic_timer.hpp"
+
+namespace xpcc
+{
+
+/**
+ * Registry of timers to find the next deadline.
+ *
+ * Timeouts and periodic timers are polled independently, so a main loop
+ * can't know how long it may sleep. Timers which join a registry can be
+ * asked for the earliest deadline instead, which allows the main loop to
+ * sleep until then:
+ *
+ * @code
+ * xpcc::Timeout timeout;
+ * xpcc::PeriodicTimer timer(100);
+ *
+ * xpcc::TimerRegistry<4> registry;
+ * registry.join(timeout);
+ * registry.join(timer);
+ *
+ * while (true)
+ * {
+ *     if (timer.execute()) {
+ *         ...
+ *     }
+ *     // sleeps at most 1s or until the next timer is due
+ *     registry.sleep(1000);
+ * }
+ * @endcode
+ *
+ * Joining is optional, timers which are not part of a registry behave
+ * exactly as before. The registry only stores pointers to the timers,
+ * a timer has to leave the registry before it is destroyed.
+ *
+ * @tparam	N	Maximum number of timers
+ *
+ * @see		xpcc::idleFor()
+ * @ingroup	software_timer
+ */
+template< class Clock, class TimestampType, std::size_t N >
+class GenericTimerRegistry
+{
+public:
+	typedef GenericTimeout<Clock, TimestampType> Timeout;
+	typedef GenericPeriodicTimer<Clock, TimestampType> PeriodicTimer;
+
+	typedef typename xpcc::tmp::Select<
+			(N >= 255),
+			uint_fast16_t,
+			uint_fast8_t >::Result Index;
+
+public:
+	GenericTimerRegistry();
+
+	/// @return `false` if the registry is full or the timeout already joined
+	bool
+	join(const Timeout& timeout);
+
+	inline bool
+	join(const PeriodicTimer& timer);
+
+	/// @return `false` if the timeout is not part of this registry
+	bool
+	leave(const Timeout& timeout);
+
+	inline bool
+	leave(const PeriodicTimer& timer);
+
+	/**
+	 * Find the earliest deadline of all armed timers.
+	 *
+	 * Expired timers which were not executed yet are included, their
+	 * deadline lies in the past.
+	 *
+	 * @return	`false` if no timer is armed
+	 */
+	bool
+	nextDeadline(TimestampType& deadline) const;
+
+	/**
+	 * Sleep until the next deadline, but for at most `maximum`.
+	 *
+	 * Returns immediately if a timer is already due. On microcontrollers
+	 * every interrupt ends the sleep early.
+	 */
+	void
+	sleep(const TimestampType maximum) const;
+
+	inline Index
+	getSize() const
+	{
+		return size;
+	}
+
+	static constexpr Index
+	getMaxSize()
+	{
+		return N;
+	}
+
+private:
+	/// Timestamps of all clocks except PreciseClock are in milliseconds
+	static inline void
+	idle(uint32_t time, const void*)
+	{
+		xpcc::idleFor(time);
+	}
+
+	static inline void
+	idle(uint32_t time, const PreciseClock*)
+	{
+#if defined(XPCC__OS_HOSTED)
+		if (VirtualClock::isEnabled())
+		{
+			VirtualClock::advanceMicroseconds(time);
+			return;
+		}
+#endif
+		if (time >= 1000) {
+			xpcc::idleFor(time / 1000);
+		}
+	}
+
+private:
+	const Timeout* timeouts[N];
+	Index size;
+};
+
+/// Timer registry for `xpcc::ShortTimeout` and `xpcc::ShortPeriodicTimer`.
+/// @ingroup	software_timer
+template< std::size_t N >
+using ShortTimerRegistry = GenericTimerRegistry< ::xpcc::Clock, ShortTimestamp, N>;
+
+/// Timer registry for `xpcc::Timeout` and `xpcc::PeriodicTimer`.
+/// @ingroup	software_timer
+template< std::size_t N >
+using TimerRegistry      = GenericTimerRegistry< ::xpcc::Clock, Timestamp, N>;
+
+/// Timer registry for `xpcc::PreciseTimeout` and `xpcc::PrecisePeriodicTimer`.
+///
+/// The sleep time is given in microseconds, but rounded down to full
+/// milliseconds.
+/// @ingroup	software_timer
+template< std::size_t N >
+using PreciseTimerRegistry = GenericTimerRegistry< ::xpcc::PreciseClock, PreciseTimestamp, N>;
+
+}	// namespace xpcc
+
+#include "timer_registry_impl.hpp"
+
+#endif // XPCC_TIMER_REGISTRY_HPP
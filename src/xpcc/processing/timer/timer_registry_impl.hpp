@@ -0,0 +1,118 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef	XPCC_TIMER_REGISTRY_HPP
+#	error	"Don't include this file directly, use 'timer_registry.hpp' instead!"
+#endif
+
+template< class Clock, class TimestampType, std::size_t N >
+xpcc::GenericTimerRegistry<Clock, TimestampType, N>::GenericTimerRegistry() :
+	size(0)
+{
+}
+
+// ----------------------------------------------------------------------------
+template< class Clock, class TimestampType, std::size_t N >
+bool
+xpcc::GenericTimerRegistry<Clock, TimestampType, N>::join(const Timeout& timeout)
+{
+	if (size >= N) {
+		return false;
+	}
+	for (Index i = 0; i < size; ++i)
+	{
+		if (timeouts[i] == &timeout) {
+			return false;
+		}
+	}
+
+	timeouts[size++] = &timeout;
+	return true;
+}
+
+template< class Clock, class TimestampType, std::size_t N >
+bool
+xpcc::GenericTimerRegistry<Clock, TimestampType, N>::join(const PeriodicTimer& timer)
+{
+	return join(timer.timeout);
+}
+
+template< class Clock, class TimestampType, std::size_t N >
+bool
+xpcc::GenericTimerRegistry<Clock, TimestampType, N>::leave(const Timeout& timeout)
+{
+	for (Index i = 0; i < size; ++i)
+	{
+		if (timeouts[i] == &timeout)
+		{
+			// order is irrelevant, fill the gap with the last entry
+			timeouts[i] = timeouts[--size];
+			return true;
+		}
+	}
+	return false;
+}
+
+template< class Clock, class TimestampType, std::size_t N >
+bool
+xpcc::GenericTimerRegistry<Clock, TimestampType, N>::leave(const PeriodicTimer& timer)
+{
+	return leave(timer.timeout);
+}
+
+// ----------------------------------------------------------------------------
+template< class Clock, class TimestampType, std::size_t N >
+bool
+xpcc::GenericTimerRegistry<Clock, TimestampType, N>::nextDeadline(TimestampType& deadline) const
+{
+	bool found = false;
+	for (Index i = 0; i < size; ++i)
+	{
+		const Timeout* timeout = timeouts[i];
+
+		// stopped and already executed timeouts have no deadline
+		if (timeout->state == Timeout::STOPPED or (timeout->state & Timeout::EXECUTED)) {
+			continue;
+		}
+
+		if (not found or timeout->endTime < deadline)
+		{
+			deadline = timeout->endTime;
+			found = true;
+		}
+	}
+	return found;
+}
+
+template< class Clock, class TimestampType, std::size_t N >
+void
+xpcc::GenericTimerRegistry<Clock, TimestampType, N>::sleep(const TimestampType maximum) const
+{
+	typedef typename TimestampType::SignedType SignedType;
+
+	// larger values would be negative as signed type
+	SignedType time = xpcc::ArithmeticTraits<SignedType>::max;
+	if (maximum.getTime() < typename TimestampType::Type(time)) {
+		time = maximum.getTime();
+	}
+
+	TimestampType deadline;
+	if (nextDeadline(deadline))
+	{
+		const SignedType remaining =
+				(deadline - Clock::template now<TimestampType>()).getTime();
+		if (remaining < time) {
+			time = remaining;
+		}
+	}
+
+	if (time > 0) {
+		idle(time, static_cast<const Clock*>(0));
+	}
+}
@@ -18,14 +18,25 @@
 namespace xpcc
 {
 
+/// Timebases of the timestamps
+/// @ingroup	software_timer
+namespace timebase
+{
+	struct Milliseconds;
+	struct Microseconds;
+}
+
 /**
  * Generic timestamp for 16bit and 32bit timestamps of variable timebase.
  *
+ * Timestamps of different timebases are distinct types, so that they
+ * can't be compared or mixed by accident.
+ *
  * @author	Fabian Greif
  * @author	Niklas Hauser
  * @ingroup	software_timer
  */
-template< typename T >
+template< typename T, typename Timebase = timebase::Milliseconds >
 class GenericTimestamp
 {
 public:
@@ -39,7 +50,7 @@ public:
 	{
 	}
 
-	GenericTimestamp(const GenericTimestamp<T> &other) :
+	GenericTimestamp(const GenericTimestamp &other) :
 		time(other.time)
 	{
 	}
@@ -50,50 +61,50 @@ public:
 		return time;
 	}
 
-	inline GenericTimestamp<T>
-	operator + (const GenericTimestamp<T>& other) const
+	inline GenericTimestamp
+	operator + (const GenericTimestamp& other) const
 	{
-		return GenericTimestamp<T>(time + other.time);
+		return GenericTimestamp(time + other.time);
 	}
 
-	inline GenericTimestamp<T>
-	operator - (const GenericTimestamp<T>& other) const
+	inline GenericTimestamp
+	operator - (const GenericTimestamp& other) const
 	{
-		return GenericTimestamp<T>(time - other.time);
+		return GenericTimestamp(time - other.time);
 	}
 
 	inline bool
-	operator == (const GenericTimestamp<T>& other) const
+	operator == (const GenericTimestamp& other) const
 	{
 		return (time == other.time);
 	}
 
 	inline bool
-	operator != (const GenericTimestamp<T>& other) const
+	operator != (const GenericTimestamp& other) const
 	{
 		return (time != other.time);
 	}
 
 	inline bool
-	operator < (const GenericTimestamp<T>& other) const
+	operator < (const GenericTimestamp& other) const
 	{
 		return SignedType(time - other.time) < 0;
 	}
 
 	inline bool
-	operator > (const GenericTimestamp<T>& other) const
+	operator > (const GenericTimestamp& other) const
 	{
 		return SignedType(time - other.time) > 0;
 	}
 
 	inline bool
-	operator <= (const GenericTimestamp<T>& other) const
+	operator <= (const GenericTimestamp& other) const
 	{
 		return SignedType(time - other.time) <= 0;
 	}
 
 	inline bool
-	operator >= (const GenericTimestamp<T>& other) const
+	operator >= (const GenericTimestamp& other) const
 	{
 		return SignedType(time - other.time) >= 0;
 	}
@@ -110,10 +121,15 @@ using ShortTimestamp = GenericTimestamp<uint16_t>;
 /// @ingroup	software_timer
 using Timestamp      = GenericTimestamp<uint32_t>;
 
+/// 32bit timestamp, which can hold up to 71 minutes at microsecond resolution.
+/// Use it only together with xpcc::PreciseClock.
+/// @ingroup	software_timer
+using PreciseTimestamp = GenericTimestamp<uint32_t, timebase::Microseconds>;
+
 // ------------------------------------------------------------------------
-template< typename T >
+template< typename T, typename Timebase >
 inline IOStream&
-operator << (IOStream& os, const GenericTimestamp<T>& t)
+operator << (IOStream& os, const GenericTimestamp<T, Timebase>& t)
 {
 	os << t.getTime();
 	return os;
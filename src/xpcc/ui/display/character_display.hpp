@@ -130,6 +130,8 @@ protected:
 		virtual bool
 		read(char& c);
 
+		using IODevice::read;
+
 	private:
 		CharacterDisplay *parent;
 	};
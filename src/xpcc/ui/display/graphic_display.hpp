@@ -490,6 +490,8 @@ namespace xpcc
 			virtual bool
 			read(char& c);
 
+			using IODevice::read;
+
 		private:
 			GraphicDisplay *parent;
 		};
@@ -34,6 +34,7 @@
 #include "allocator/dynamic.hpp"
 #include "allocator/static.hpp"
 #include "allocator/block.hpp"
+#include "allocator/monotonic.hpp"
 
 namespace xpcc
 {
@@ -43,6 +44,10 @@ namespace xpcc
 	 * 
 	 * \brief	Memory allocators
 	 * 
+	 * The TLSF allocator (xpcc::allocator::Tlsf) is only available on
+	 * Cortex-M and hosted targets and must be included separately from
+	 * `xpcc/utils/allocator/tlsf.hpp`.
+	 * 
 	 * \author	Fabian Greif
 	 */
 	namespace allocator
@@ -0,0 +1,99 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_ALLOCATOR__MONOTONIC_HPP
+#define XPCC_ALLOCATOR__MONOTONIC_HPP
+
+#include <xpcc/architecture/driver/heap/monotonic_arena.hpp>
+
+#include "allocator_base.hpp"
+
+namespace xpcc
+{
+	namespace allocator
+	{
+		/**
+		 * \brief	Monotonic arena allocator
+		 * 
+		 * Allocates the memory from a xpcc::MonotonicArena. deallocate()
+		 * does nothing, the memory is released for all users of the arena
+		 * with MonotonicArena::reset().
+		 * 
+		 * Intended for containers which only live during one cycle of the
+		 * main loop:
+		 * \code
+		 * xpcc::StaticMonotonicArena<1024> arena;
+		 * 
+		 * {
+		 *     xpcc::DynamicArray<Widget*, xpcc::allocator::Monotonic<Widget*> >
+		 *             visible(16, arena);
+		 *     ...
+		 * }
+		 * arena.reset();
+		 * \endcode
+		 * 
+		 * \warning	Returns `nullptr` when the arena is exhausted.
+		 * 
+		 * \ingroup	allocator
+		 */
+		template <typename T>
+		class Monotonic : public AllocatorBase<T>
+		{
+			template <typename U>
+			friend class Monotonic;
+			
+		public:
+			template <typename U>
+			struct rebind
+			{
+				typedef Monotonic<U> other;
+			};
+			
+		public:
+			Monotonic(MonotonicArena& arena) :
+				AllocatorBase<T>(), arena(&arena)
+			{
+			}
+			
+			Monotonic(const Monotonic& other) :
+				AllocatorBase<T>(other), arena(other.arena)
+			{
+			}
+			
+			template <typename U>
+			Monotonic(const Monotonic<U>& other) :
+				AllocatorBase<T>(), arena(other.arena)
+			{
+			}
+			
+			T*
+			allocate(size_t n)
+			{
+				return static_cast<T*>(arena->allocate(n * sizeof(T)));
+			}
+			
+			void
+			deallocate(T*)
+			{
+				// memory is released by MonotonicArena::reset()
+			}
+			
+			inline MonotonicArena&
+			getArena() const
+			{
+				return *arena;
+			}
+			
+		private:
+			MonotonicArena* arena;
+		};
+	}
+}
+
+#endif // XPCC_ALLOCATOR__MONOTONIC_HPP
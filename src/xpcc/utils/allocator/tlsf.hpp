@@ -0,0 +1,95 @@
+// coding: utf-8
+/* Copyright (c) 2017, Roboterclub Aachen e.V.
+ * All Rights Reserved.
+ *
+ * The file is part of the xpcc library and is released under the 3-clause BSD
+ * license. See the file `LICENSE` for the full license governing this code.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef XPCC_ALLOCATOR__TLSF_HPP
+#define XPCC_ALLOCATOR__TLSF_HPP
+
+#include <xpcc/architecture/driver/heap/tlsf/tlsf_heap.hpp>
+
+#include "allocator_base.hpp"
+
+namespace xpcc
+{
+	namespace allocator
+	{
+		/**
+		 * \brief	TLSF memory allocator
+		 *
+		 * Allocates the memory from a private xpcc::TlsfHeap instead of the
+		 * global heap. Several containers can share one heap, e.g. all
+		 * containers of one subsystem.
+		 *
+		 * \code
+		 * xpcc::StaticTlsfHeap<4096> heap;
+		 *
+		 * xpcc::LinkedList<int, xpcc::allocator::Tlsf<int> > list(heap);
+		 * \endcode
+		 *
+		 * Only available for Cortex-M and hosted targets. This header is
+		 * therefore not included by `xpcc/utils/allocator.hpp`.
+		 *
+		 * \warning	Returns `nullptr` when the heap is exhausted.
+		 *
+		 * \ingroup	allocator
+		 */
+		template <typename T>
+		class Tlsf : public AllocatorBase<T>
+		{
+			template <typename U>
+			friend class Tlsf;
+
+		public:
+			template <typename U>
+			struct rebind
+			{
+				typedef Tlsf<U> other;
+			};
+
+		public:
+			Tlsf(TlsfHeap& heap) :
+				AllocatorBase<T>(), heap(&heap)
+			{
+			}
+
+			Tlsf(const Tlsf& other) :
+				AllocatorBase<T>(other), heap(other.heap)
+			{
+			}
+
+			template <typename U>
+			Tlsf(const Tlsf<U>& other) :
+				AllocatorBase<T>(), heap(other.heap)
+			{
+			}
+
+			T*
+			allocate(size_t n)
+			{
+				return static_cast<T*>(heap->allocate(n * sizeof(T)));
+			}
+
+			void
+			deallocate(T* p)
+			{
+				heap->free(p);
+			}
+
+			inline TlsfHeap&
+			getHeap() const
+			{
+				return *heap;
+			}
+
+		private:
+			TlsfHeap* heap;
+		};
+	}
+}
+
+#endif // XPCC_ALLOCATOR__TLSF_HPP
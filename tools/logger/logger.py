@@ -26,7 +26,7 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
 # THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
-import sys, os
+import sys, os, re, json, struct, numbers
 
 class Logger:
 	# Terminal Escape Sequences
@@ -124,7 +124,230 @@ class Logger:
 		else:
 			return False
 
+# -----------------------------------------------------------------------------
+class LogDictionary:
+	"""
+	Format strings of the deferred logger (xpcc/debug/logger/deferred.hpp).
+
+	The target only sends the FNV-1a hash of each format string. The strings
+	are collected from the sources by searching for the XPCC_LOG_DEFERRED_*
+	macros, the file is written by the build ('scons logdict').
+	"""
+	MACRO = re.compile(r'XPCC_LOG_DEFERRED_(?:DEBUG|INFO|WARNING|ERROR|MESSAGE\s*\([^,]*,)\s*\(?\s*'
+						r'((?:"(?:[^"\\\n]|\\.)*"\s*)+)')
+	LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+	ESCAPE = re.compile(r'\\(x[0-9a-fA-F]+|[0-7]{1,3}|.)')
+	ESCAPES = { 'n': '\n', 't': '\t', 'r': '\r', 'a': '\a', 'b': '\b',
+				'f': '\f', 'v': '\v', 'e': '\x1b' }
+
+	def __init__(self):
+		self.messages = {}
+
+	@staticmethod
+	def hash(string):
+		value = 2166136261
+		for c in string:
+			value = ((value ^ ord(c)) * 16777619) & 0xffffffff
+		return value
+
+	@classmethod
+	def unescape(cls, literal):
+		def replace(match):
+			escape = match.group(1)
+			if escape[0] == 'x':
+				return chr(int(escape[1:], 16) & 0xff)
+			if escape[0] in '01234567':
+				return chr(int(escape, 8) & 0xff)
+			return cls.ESCAPES.get(escape, escape)
+		return cls.ESCAPE.sub(replace, literal)
+
+	def add(self, format, location=None):
+		id = self.hash(format)
+		message = self.messages.setdefault(id, { 'format': format, 'locations': [] })
+		if message['format'] != format:
+			raise ValueError("Hash collision between '%s' and '%s', please change one of them"
+							 % (message['format'], format))
+		if location is not None and location not in message['locations']:
+			message['locations'].append(location)
+		return id
+
+	def scan(self, filename):
+		# latin-1 maps every byte to one character, like the compiler sees it
+		with open(filename, 'rb') as file:
+			content = file.read().decode('latin-1')
+		for match in self.MACRO.finditer(content):
+			format = ''.join(self.unescape(literal)
+							 for literal in self.LITERAL.findall(match.group(1)))
+			line = content.count('\n', 0, match.start()) + 1
+			self.add(format, '%s:%d' % (os.path.basename(filename), line))
+
+	def get(self, id):
+		return self.messages.get(id)
+
+	def save(self, filename):
+		messages = dict(('%08x' % id, message) for id, message in self.messages.items())
+		with open(filename, 'w') as file:
+			json.dump({ 'version': 1, 'messages': messages }, file, indent=1, sort_keys=True)
+
+	def load(self, filename):
+		with open(filename, 'r') as file:
+			content = json.load(file)
+		for id, message in content['messages'].items():
+			self.messages[int(id, 16)] = message
+
+# -----------------------------------------------------------------------------
+class DeferredLogDecoder:
+	"""
+	Decodes the binary stream written by xpcc::log::DeferredLogger.
+
+	Bytes which don't form a valid record (e.g. when the connection was
+	opened in the middle of a message) are skipped.
+	"""
+	RECORD_MARKER = 0xA0
+	DROPPED_MARKER = 0xAF
+	HEADER_SIZE = 10
+	LEVELS = ['debug', 'info', 'warn', 'error']
+
+	CONVERSION = re.compile(r'%([-+ #0]*)(\d*)(?:\.(\d+))?(?:hh|h|ll|l|z|j|t)?([diuxXobcsfFeEgGp%])')
+
+	def __init__(self, dictionary, logger=None):
+		self.dictionary = dictionary
+		self.logger = logger if logger is not None else Logger('debug')
+		self.buffer = bytearray()
+
+	def format(self, format, arguments):
+		arguments = list(arguments)
+		def replace(match):
+			flags, width, precision, conversion = match.groups()
+			if conversion == '%':
+				return '%'
+			if not arguments:
+				return match.group(0)
+			value = arguments.pop(0)
+			if conversion == 'b':
+				string = bin(int(value))[2:] if value >= 0 else '-' + bin(int(value))[3:]
+				fill = '0' if '0' in flags and '-' not in flags else ' '
+				return string.rjust(int(width or 0), fill) if '-' not in flags \
+						else string.ljust(int(width or 0))
+			if conversion == 'c' and isinstance(value, numbers.Integral):
+				value = chr(value & 0xff)
+			if conversion == 'p':
+				return '0x%x' % value
+			if isinstance(value, bool) and conversion != 's':
+				value = int(value)
+			if conversion in 'diuxXo' and isinstance(value, float):
+				conversion = 'g'
+			if conversion in 'fFeEgG' and not isinstance(value, float):
+				value = float(value)
+			if conversion == 's' and isinstance(value, bool):
+				value = 'true' if value else 'false'
+			if conversion == 'u':
+				conversion = 'd'
+			specifier = '%' + flags + width + ('.' + precision if precision is not None else '') + conversion
+			try:
+				return specifier % value
+			except (TypeError, ValueError):
+				return str(value)
+		return self.CONVERSION.sub(replace, format)
+
+	def decodeArguments(self, payload):
+		arguments = []
+		index = 0
+		while index < len(payload):
+			code = chr(payload[index])
+			index += 1
+			if code == 's':
+				length = payload[index]
+				arguments.append(bytes(payload[index + 1:index + 1 + length]).decode('latin-1'))
+				index += 1 + length
+			elif code in 'bBhHiIqQfd?c':
+				size = struct.calcsize('<' + code)
+				value, = struct.unpack('<' + code, bytes(payload[index:index + size]))
+				if code == 'c':
+					value = value.decode('latin-1')
+				arguments.append(value)
+				index += size
+			else:
+				raise ValueError("Unknown type code '%s'" % code)
+		if index != len(payload):
+			raise ValueError("Truncated argument")
+		return arguments
+
+	def feed(self, data):
+		"""
+		Decode the data and return the complete messages as tuples of
+		(level, timestamp, text). Incomplete records are kept until the
+		next call.
+		"""
+		self.buffer.extend(bytearray(data))
+		messages = []
+		while self.buffer:
+			marker = self.buffer[0]
+			if marker == self.DROPPED_MARKER:
+				if len(self.buffer) < 5:
+					break
+				count, = struct.unpack('<I', bytes(self.buffer[1:5]))
+				del self.buffer[:5]
+				messages.append(('warn', None, '%d messages dropped' % count))
+				continue
+			if not (self.RECORD_MARKER <= marker < self.RECORD_MARKER + len(self.LEVELS)):
+				del self.buffer[0]
+				continue
+			if len(self.buffer) < self.HEADER_SIZE:
+				break
+			id, timestamp, length = struct.unpack('<IIB', bytes(self.buffer[1:self.HEADER_SIZE]))
+			message = self.dictionary.get(id)
+			if message is None:
+				# not the start of a record
+				del self.buffer[0]
+				continue
+			if len(self.buffer) < self.HEADER_SIZE + length:
+				break
+			payload = self.buffer[self.HEADER_SIZE:self.HEADER_SIZE + length]
+			try:
+				arguments = self.decodeArguments(payload)
+			except (ValueError, struct.error):
+				del self.buffer[0]
+				continue
+			del self.buffer[:self.HEADER_SIZE + length]
+			messages.append((self.LEVELS[marker - self.RECORD_MARKER], timestamp,
+							 self.format(message['format'], arguments)))
+		return messages
+
+	def decode(self, stream):
+		while True:
+			data = stream.read(1) if hasattr(stream, 'isatty') and stream.isatty() else stream.read(4096)
+			if not data:
+				break
+			for level, timestamp, text in self.feed(data):
+				if timestamp is not None:
+					text = '[%10.3f] %s' % (timestamp / 1000.0, text)
+				getattr(self.logger, level)(text)
+
 if __name__ == "__main__":
+	if len(sys.argv) >= 3 and sys.argv[1] == 'decode':
+		# decode the output of the deferred logger:
+		#   logger.py decode <dictionary> [<file or serial device>]
+		dictionary = LogDictionary()
+		dictionary.load(sys.argv[2])
+		if len(sys.argv) > 3:
+			stream = open(sys.argv[3], 'rb')
+		else:
+			stream = sys.stdin.buffer if hasattr(sys.stdin, 'buffer') else sys.stdin
+		try:
+			DeferredLogDecoder(dictionary).decode(stream)
+		except KeyboardInterrupt:
+			pass
+		sys.exit(0)
+	elif len(sys.argv) >= 3 and sys.argv[1] == 'dictionary':
+		# create the dictionary of the deferred logger:
+		#   logger.py dictionary <output> <source files...>
+		dictionary = LogDictionary()
+		for filename in sys.argv[3:]:
+			dictionary.scan(filename)
+		dictionary.save(sys.argv[2])
+		sys.exit(0)
+
 	"""
 	Test Code
 	"""